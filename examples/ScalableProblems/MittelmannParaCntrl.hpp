@@ -284,16 +284,19 @@ bool MittelmannParaCntrlBase<T>::InitializeProblem(
    alpha_ = p.alpha();
    beta_ = p.beta();
 
+   delete[] y_T_;
    y_T_ = new Number[Nx_ + 1];
    for( Index j = 0; j <= Nx_; j++ )
    {
       y_T_[j] = p.y_T(x_grid(j));
    }
+   delete[] a_y_;
    a_y_ = new Number[Nt_];
    for( Index i = 1; i <= Nt_; i++ )
    {
       a_y_[i - 1] = p.a_y(t_grid(i));
    }
+   delete[] a_u_;
    a_u_ = new Number[Nt_];
    for( Index i = 1; i <= Nt_; i++ )
    {
@@ -5,6 +5,8 @@
 // Authors:  Andreas Waechter            IBM    2004-11-05
 
 #include "IpIpoptApplication.hpp"
+#include "IpIpoptData.hpp"
+#include "IpSolveStatistics.hpp"
 #include "RegisteredTNLP.hpp"
 
 #include <cstdio>
@@ -12,6 +14,10 @@
 #include <cstring>
 #include <iostream>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 //**********************************************************************
 // Stuff for benchmarking
 // Enable this define to allow passing timelimit as 3rd program parameter
@@ -96,6 +102,207 @@ static void print_problems()
    RegisteredTNLPs::PrintRegisteredProblems();
 }
 
+/** returns the peak resident set size of this process in kilobytes, or -1 if not available */
+static long peak_memory_kb()
+{
+#ifndef _WIN32
+   struct rusage usage;
+   if( getrusage(RUSAGE_SELF, &usage) == 0 )
+   {
+#ifdef __APPLE__
+      return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+      return usage.ru_maxrss;
+#endif
+   }
+#endif
+   return -1;
+}
+
+/** writes a number as JSON value, i.e., null if not finite */
+static void print_json_number(
+   FILE*       fp,
+   const char* key,
+   Number      value
+)
+{
+   if( IsFiniteNumber(value) )
+   {
+      fprintf(fp, "\"%s\": %.10g", key, value);
+   }
+   else
+   {
+      fprintf(fp, "\"%s\": null", key);
+   }
+}
+
+/** solves one problem of a benchmark run and writes its record into the results file */
+static ApplicationReturnStatus benchmark_problem(
+   FILE*              fp,
+   bool               first,
+   const std::string& name,
+   Index              N
+)
+{
+   SmartPtr<RegisteredTNLP> tnlp = RegisteredTNLPs::GetTNLP(name);
+   if( !IsValid(tnlp) || !tnlp->InitializeProblem(N) )
+   {
+      printf("%-20s N=%-8d skipped: invalid problem name or size\n", name.c_str(), (int) N);
+      return Invalid_Problem_Definition;
+   }
+
+   Index n, m, nnz_jac_g, nnz_h_lag;
+   TNLP::IndexStyleEnum index_style;
+   tnlp->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
+
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   ApplicationReturnStatus status = app->Initialize();
+   if( status != Solve_Succeeded )
+   {
+      return status;
+   }
+   // timing of the individual phases is needed for the report; options from ipopt.opt are kept otherwise
+   app->Options()->SetStringValue("timing_statistics", "yes");
+   app->Options()->SetIntegerValueIfUnset("print_level", 0);
+
+   status = app->OptimizeTNLP(GetRawPtr(tnlp));
+
+   Index iter = -1;
+   Number objective = 0.;
+   Number constr_viol = 0.;
+   Number cpu_time = 0.;
+   Number wall_time = 0.;
+   Index num_obj_evals = 0;
+   Index num_constr_evals = 0;
+   Index num_obj_grad_evals = 0;
+   Index num_constr_jac_evals = 0;
+   Index num_hess_evals = 0;
+   SmartPtr<SolveStatistics> stats = app->Statistics();
+   if( IsValid(stats) )
+   {
+      Number dual_inf, varbounds_viol, compl_inf, kkt_error;
+      iter = stats->IterationCount();
+      objective = stats->FinalObjective();
+      stats->Infeasibilities(dual_inf, constr_viol, varbounds_viol, compl_inf, kkt_error);
+      cpu_time = stats->TotalCpuTime();
+      wall_time = stats->TotalWallclockTime();
+      stats->NumberOfEvaluations(num_obj_evals, num_constr_evals, num_obj_grad_evals, num_constr_jac_evals, num_hess_evals);
+   }
+   // wallclock times of the phases of the algorithm
+   const int nphases = 9;
+   const char* phase_names[nphases] =
+   {
+      "function_evaluations", "search_direction", "symbolic_factorization", "factorization", "backsolve",
+      "line_search", "hessian_update", "barrier_update", "convergence_check"
+   };
+   Number phase_times[nphases] = { 0., 0., 0., 0., 0., 0., 0., 0., 0. };
+   Index num_factorizations = 0;
+   SmartPtr<IpoptData> ip_data = app->IpoptDataObject();
+   if( IsValid(ip_data) )
+   {
+      TimingStatistics& timing = ip_data->TimingStats();
+      phase_times[0] = timing.TotalFunctionEvaluationWallclockTime();
+      phase_times[1] = timing.ComputeSearchDirection().TotalWallclockTime();
+      phase_times[2] = timing.LinearSystemSymbolicFactorization().TotalWallclockTime();
+      phase_times[3] = timing.LinearSystemFactorization().TotalWallclockTime();
+      phase_times[4] = timing.LinearSystemBackSolve().TotalWallclockTime();
+      phase_times[5] = timing.ComputeAcceptableTrialPoint().TotalWallclockTime();
+      phase_times[6] = timing.UpdateHessian().TotalWallclockTime();
+      phase_times[7] = timing.UpdateBarrierParameter().TotalWallclockTime();
+      phase_times[8] = timing.CheckConvergence().TotalWallclockTime();
+      num_factorizations = timing.LinearSystemFactorization().NumberOfCalls();
+   }
+   long peak_kb = peak_memory_kb();
+
+   printf("%-20s N=%-8d n=%-10d m=%-10d status=%-3d iter=%-5d time=%.3fs\n", name.c_str(), (int) N, (int) n, (int) m,
+          (int) status, (int) iter, wall_time);
+
+   fprintf(fp, "%s\n    {\"problem\": \"%s\", \"N\": %d, \"n\": %d, \"m\": %d, \"status\": %d, \"iterations\": %d, ",
+           first ? "" : ",", name.c_str(), (int) N, (int) n, (int) m, (int) status, (int) iter);
+   print_json_number(fp, "objective", objective);
+   fprintf(fp, ", ");
+   print_json_number(fp, "constr_viol", constr_viol);
+   fprintf(fp, ",\n     \"evaluations\": {\"f\": %d, \"c\": %d, \"grad_f\": %d, \"jac_c\": %d, \"h\": %d}",
+           (int) num_obj_evals, (int) num_constr_evals, (int) num_obj_grad_evals, (int) num_constr_jac_evals, (int) num_hess_evals);
+   fprintf(fp, ", \"factorizations\": %d, \"peak_memory_kb\": %ld,\n     \"time\": {",
+           (int) num_factorizations, peak_kb);
+   print_json_number(fp, "total_wall", wall_time);
+   fprintf(fp, ", ");
+   print_json_number(fp, "total_cpu", cpu_time);
+   for( int i = 0; i < nphases; ++i )
+   {
+      fprintf(fp, ", ");
+      print_json_number(fp, phase_names[i], phase_times[i]);
+   }
+   fprintf(fp, "}}");
+   fflush(fp);
+
+   return status;
+}
+
+/** solves a list of problems for a list of sizes each and writes the results as JSON
+ *
+ *  Arguments are pairs of problem name and comma-separated list of sizes.
+ */
+static int benchmark(
+   const char* filename,
+   int         nargs,
+   char*       args[]
+)
+{
+   if( nargs == 0 || nargs % 2 != 0 )
+   {
+      printf("Expected pairs of problem name and comma-separated list of sizes.\n");
+      return -1;
+   }
+
+   FILE* fp = fopen(filename, "w");
+   if( fp == NULL )
+   {
+      printf("Cannot open file %s for writing.\n", filename);
+      return -5;
+   }
+   fprintf(fp, "{\n  \"ipopt_version\": \"%s\",\n  \"runs\": [", IPOPT_VERSION);
+
+   int nfailed = 0;
+   bool first = true;
+   for( int i = 0; i < nargs; i += 2 )
+   {
+      std::string name(args[i]);
+      const char* sizes = args[i + 1];
+      while( *sizes != '\0' )
+      {
+         char* end;
+         long N = strtol(sizes, &end, 10);
+         if( end == sizes || N <= 0 )
+         {
+            printf("Invalid list of sizes \"%s\" for problem %s.\n", args[i + 1], name.c_str());
+            ++nfailed;
+            break;
+         }
+         ApplicationReturnStatus status = benchmark_problem(fp, first, name, (Index) N);
+         if( status != Invalid_Problem_Definition )
+         {
+            first = false;
+         }
+         if( status != Solve_Succeeded && status != Solved_To_Acceptable_Level )
+         {
+            ++nfailed;
+         }
+         sizes = (*end == ',') ? end + 1 : end;
+      }
+   }
+
+   fprintf(fp, "\n  ]\n}\n");
+   fclose(fp);
+
+   if( nfailed > 0 )
+   {
+      printf("\n%d of the benchmark runs did not solve successfully.\n", nfailed);
+   }
+   return nfailed;
+}
+
 int main(
    int   argv,
    char* argc[]
@@ -107,6 +314,11 @@ int main(
       return 0;
    }
 
+   if( argv >= 3 && !strcmp(argc[1], "benchmark") )
+   {
+      return benchmark(argc[2], argv - 3, argc + 3);
+   }
+
 #ifdef TIME_LIMIT
    int runtime;
    if( argv == 4 )
@@ -122,6 +334,8 @@ int main(
          printf("          where N is a positive parameter determining problem size\n");
          printf("       %s list\n", argc[0]);
          printf("          to list all registered problems.\n");
+         printf("       %s benchmark FILE ProblemName N1[,N2,...] [ProblemName N1[,N2,...] ...]\n", argc[0]);
+         printf("          to solve the given problems for all given sizes and write results as JSON into FILE.\n");
          return -1;
       }
 
@@ -0,0 +1,104 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPAUGSYSTEMPRECONDITIONER_HPP__
+#define __IPAUGSYSTEMPRECONDITIONER_HPP__
+
+#include "IpAlgStrategy.hpp"
+#include "IpSymMatrix.hpp"
+
+namespace Ipopt
+{
+
+/** Base class for preconditioners of the augmented system that is
+ *  solved by a Krylov method (see KrylovAugSystemSolver).
+ *
+ *  The matrix of the augmented system is given as
+ *
+ *  \f$\left[\begin{array}{cccc}
+ *  \mbox{W\_factor}\,W + \mbox{diag}(diag_x) & 0 & J_c^T & J_d^T\\
+ *  0 & \mbox{diag}(diag_s) & 0 & -I \\
+ *  J_c & 0 & \mbox{diag}(diag_c) & 0\\
+ *  J_d & -I & 0 & \mbox{diag}(diag_d)
+ *  \end{array}\right]\f$.
+ *
+ *  Preconditioners that are used with MINRES must be symmetric
+ *  positive definite.
+ *
+ *  @since 3.15.0
+ */
+class AugSystemPreconditioner: public AlgorithmStrategyObject
+{
+public:
+   /**@name Constructor/Destructor */
+   ///@{
+   /** Default constructor */
+   AugSystemPreconditioner()
+   { }
+
+   /** Destructor */
+   virtual ~AugSystemPreconditioner()
+   { }
+   ///@}
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   ) = 0;
+
+   /** Set up the preconditioner for a new augmented system.
+    *
+    *  W can be NULL, in which case it is treated as zero.
+    *
+    *  @return false, if the preconditioner could not be computed
+    */
+   virtual bool Update(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector&    diag_x,
+      const Vector&    diag_s,
+      const Matrix&    J_c,
+      const Vector&    diag_c,
+      const Matrix&    J_d,
+      const Vector&    diag_d
+   ) = 0;
+
+   /** Apply the inverse of the preconditioner to a vector r and store the result in z. */
+   virtual void Apply(
+      const Vector& r_x,
+      const Vector& r_s,
+      const Vector& r_c,
+      const Vector& r_d,
+      Vector&       z_x,
+      Vector&       z_s,
+      Vector&       z_c,
+      Vector&       z_d
+   ) const = 0;
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   AugSystemPreconditioner(
+      const AugSystemPreconditioner&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const AugSystemPreconditioner&
+   );
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
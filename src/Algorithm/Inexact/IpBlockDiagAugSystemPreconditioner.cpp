@@ -0,0 +1,243 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpBlockDiagAugSystemPreconditioner.hpp"
+#include "IpTripletHelper.hpp"
+
+#include <cmath>
+
+namespace Ipopt
+{
+
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** replaces entries of a positive diagonal that are too small to be inverted */
+static void FloorDiagonal(
+   Index   dim,
+   Number* vals
+)
+{
+   Number maxval = 0.;
+   for( Index i = 0; i < dim; i++ )
+   {
+      maxval = Max(maxval, vals[i]);
+   }
+   const Number floor = maxval > 0. ? 1e-8 * maxval : 1.;
+   for( Index i = 0; i < dim; i++ )
+   {
+      vals[i] = Max(vals[i], floor);
+   }
+}
+
+BlockDiagAugSystemPreconditioner::BlockDiagAugSystemPreconditioner()
+   : hessian_entries_available_(true)
+{ }
+
+BlockDiagAugSystemPreconditioner::~BlockDiagAugSystemPreconditioner()
+{ }
+
+bool BlockDiagAugSystemPreconditioner::InitializeImpl(
+   const OptionsList& /*options*/,
+   const std::string& /*prefix*/
+)
+{
+   hessian_entries_available_ = true;
+   return true;
+}
+
+bool BlockDiagAugSystemPreconditioner::Update(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector&    diag_x,
+   const Vector&    diag_s,
+   const Matrix&    J_c,
+   const Vector&    diag_c,
+   const Matrix&    J_d,
+   const Vector&    diag_d
+)
+{
+   DBG_START_METH("BlockDiagAugSystemPreconditioner::Update", dbg_verbosity);
+
+   const Index nx = diag_x.Dim();
+   const Index ns = diag_s.Dim();
+   const Index nc = diag_c.Dim();
+   const Index nd = diag_d.Dim();
+
+   // (1,1) block
+   Number* h_x = new Number[nx];
+   TripletHelper::FillValuesFromVector(nx, diag_x, h_x);
+   for( Index i = 0; i < nx; i++ )
+   {
+      h_x[i] = std::abs(h_x[i]);
+   }
+   if( W != NULL && W_factor != 0. )
+   {
+      Number* w_diag = new Number[nx];
+      GetHessianDiagonal(*W, diag_x, w_diag);
+      for( Index i = 0; i < nx; i++ )
+      {
+         h_x[i] += std::abs(W_factor) * w_diag[i];
+      }
+      delete[] w_diag;
+   }
+   FloorDiagonal(nx, h_x);
+
+   // (2,2) block
+   Number* h_s = new Number[ns];
+   TripletHelper::FillValuesFromVector(ns, diag_s, h_s);
+   for( Index i = 0; i < ns; i++ )
+   {
+      h_s[i] = std::abs(h_s[i]);
+   }
+   FloorDiagonal(ns, h_s);
+
+   // diagonals of the Schur complements for the constraint blocks
+   Number* s_c = new Number[nc];
+   TripletHelper::FillValuesFromVector(nc, diag_c, s_c);
+   for( Index i = 0; i < nc; i++ )
+   {
+      s_c[i] = std::abs(s_c[i]);
+   }
+   AddScaledRowSquares(J_c, h_x, s_c);
+   FloorDiagonal(nc, s_c);
+
+   Number* s_d = new Number[nd];
+   TripletHelper::FillValuesFromVector(nd, diag_d, s_d);
+   for( Index i = 0; i < nd; i++ )
+   {
+      s_d[i] = std::abs(s_d[i]) + 1. / h_s[i];
+   }
+   AddScaledRowSquares(J_d, h_x, s_d);
+   FloorDiagonal(nd, s_d);
+
+   inv_x_ = diag_x.MakeNew();
+   TripletHelper::PutValuesInVector(nx, h_x, *inv_x_);
+   inv_x_->ElementWiseReciprocal();
+   inv_s_ = diag_s.MakeNew();
+   TripletHelper::PutValuesInVector(ns, h_s, *inv_s_);
+   inv_s_->ElementWiseReciprocal();
+   inv_c_ = diag_c.MakeNew();
+   TripletHelper::PutValuesInVector(nc, s_c, *inv_c_);
+   inv_c_->ElementWiseReciprocal();
+   inv_d_ = diag_d.MakeNew();
+   TripletHelper::PutValuesInVector(nd, s_d, *inv_d_);
+   inv_d_->ElementWiseReciprocal();
+
+   delete[] h_x;
+   delete[] h_s;
+   delete[] s_c;
+   delete[] s_d;
+
+   return true;
+}
+
+void BlockDiagAugSystemPreconditioner::Apply(
+   const Vector& r_x,
+   const Vector& r_s,
+   const Vector& r_c,
+   const Vector& r_d,
+   Vector&       z_x,
+   Vector&       z_s,
+   Vector&       z_c,
+   Vector&       z_d
+) const
+{
+   DBG_ASSERT(IsValid(inv_x_));
+   z_x.Copy(r_x);
+   z_x.ElementWiseMultiply(*inv_x_);
+   z_s.Copy(r_s);
+   z_s.ElementWiseMultiply(*inv_s_);
+   z_c.Copy(r_c);
+   z_c.ElementWiseMultiply(*inv_c_);
+   z_d.Copy(r_d);
+   z_d.ElementWiseMultiply(*inv_d_);
+}
+
+void BlockDiagAugSystemPreconditioner::GetHessianDiagonal(
+   const SymMatrix& W,
+   const Vector&    x_vec,
+   Number*          w_diag
+)
+{
+   const Index dim = x_vec.Dim();
+   for( Index i = 0; i < dim; i++ )
+   {
+      w_diag[i] = 0.;
+   }
+
+   if( hessian_entries_available_ )
+   {
+      try
+      {
+         Index nnz = TripletHelper::GetNumberEntries(W);
+         Index* irow = new Index[nnz];
+         Index* jcol = new Index[nnz];
+         Number* vals = new Number[nnz];
+         TripletHelper::FillRowCol(nnz, W, irow, jcol);
+         TripletHelper::FillValues(nnz, W, vals);
+         for( Index k = 0; k < nnz; k++ )
+         {
+            if( irow[k] == jcol[k] )
+            {
+               w_diag[irow[k] - 1] += vals[k];
+            }
+         }
+         delete[] irow;
+         delete[] jcol;
+         delete[] vals;
+         for( Index i = 0; i < dim; i++ )
+         {
+            w_diag[i] = std::abs(w_diag[i]);
+         }
+         return;
+      }
+      catch( UNKNOWN_MATRIX_TYPE& )
+      {
+         // W only provides products with vectors; do not try again
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "Entries of the Hessian not available, estimating its diagonal for the preconditioner.\n");
+         hessian_entries_available_ = false;
+      }
+   }
+
+   // use the root mean square of the entries of W*e as estimate for the magnitude of the diagonal
+   SmartPtr<Vector> e = x_vec.MakeNew();
+   e->Set(1.);
+   SmartPtr<Vector> We = e->MakeNew();
+   W.MultVector(1., *e, 0., *We);
+   Number gamma = dim > 0 ? We->Nrm2() / std::sqrt((Number) dim) : 0.;
+   for( Index i = 0; i < dim; i++ )
+   {
+      w_diag[i] = gamma;
+   }
+}
+
+void BlockDiagAugSystemPreconditioner::AddScaledRowSquares(
+   const Matrix& J,
+   const Number* h_x,
+   Number*       row_sums
+)
+{
+   Index nnz = TripletHelper::GetNumberEntries(J);
+   if( nnz == 0 )
+   {
+      return;
+   }
+   Index* irow = new Index[nnz];
+   Index* jcol = new Index[nnz];
+   Number* vals = new Number[nnz];
+   TripletHelper::FillRowCol(nnz, J, irow, jcol);
+   TripletHelper::FillValues(nnz, J, vals);
+   for( Index k = 0; k < nnz; k++ )
+   {
+      row_sums[irow[k] - 1] += vals[k] * vals[k] / h_x[jcol[k] - 1];
+   }
+   delete[] irow;
+   delete[] jcol;
+   delete[] vals;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,124 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPBLOCKDIAGAUGSYSTEMPRECONDITIONER_HPP__
+#define __IPBLOCKDIAGAUGSYSTEMPRECONDITIONER_HPP__
+
+#include "IpAugSystemPreconditioner.hpp"
+
+namespace Ipopt
+{
+
+/** Block diagonal preconditioner for the augmented system.
+ *
+ *  The preconditioner is the positive diagonal matrix
+ *  diag(H_x, H_s, S_c, S_d), where H_x and H_s are the absolute
+ *  values of the diagonals of the (1,1) and (2,2) blocks, and
+ *  S_c and S_d are the diagonals of the Schur complements
+ *  \f$J_c H_x^{-1} J_c^T\f$ and \f$J_d H_x^{-1} J_d^T + H_s^{-1}\f$,
+ *  plus the absolute values of diag_c and diag_d.
+ *
+ *  If the entries of W are not available (e.g., if only products
+ *  of the Hessian with vectors are provided), the diagonal of W is
+ *  replaced by an estimate of its magnitude that is obtained from
+ *  one product with W.
+ *
+ *  @since 3.15.0
+ */
+class BlockDiagAugSystemPreconditioner: public AugSystemPreconditioner
+{
+public:
+   /**@name Constructor/Destructor */
+   ///@{
+   /** Default constructor */
+   BlockDiagAugSystemPreconditioner();
+
+   /** Destructor */
+   virtual ~BlockDiagAugSystemPreconditioner();
+   ///@}
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   virtual bool Update(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector&    diag_x,
+      const Vector&    diag_s,
+      const Matrix&    J_c,
+      const Vector&    diag_c,
+      const Matrix&    J_d,
+      const Vector&    diag_d
+   );
+
+   virtual void Apply(
+      const Vector& r_x,
+      const Vector& r_s,
+      const Vector& r_c,
+      const Vector& r_d,
+      Vector&       z_x,
+      Vector&       z_s,
+      Vector&       z_c,
+      Vector&       z_d
+   ) const;
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   BlockDiagAugSystemPreconditioner(
+      const BlockDiagAugSystemPreconditioner&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const BlockDiagAugSystemPreconditioner&
+   );
+   ///@}
+
+   /** Compute the absolute values of the diagonal of W into w_diag.
+    *
+    *  Uses the entries of W if available, and an estimate of the
+    *  magnitude of W otherwise.
+    */
+   void GetHessianDiagonal(
+      const SymMatrix& W,
+      const Vector&    x_vec, /**< vector in the space of the rows of W */
+      Number*          w_diag
+   );
+
+   /** Add the squares of the entries of each row of J, divided by the
+    *  entry of h_x corresponding to the column, to the row sums.
+    */
+   static void AddScaledRowSquares(
+      const Matrix& J,
+      const Number* h_x,
+      Number*       row_sums
+   );
+
+   /** Whether the entries of W can be obtained by TripletHelper */
+   bool hessian_entries_available_;
+
+   /** @name Inverses of the diagonal blocks of the preconditioner */
+   ///@{
+   SmartPtr<Vector> inv_x_;
+   SmartPtr<Vector> inv_s_;
+   SmartPtr<Vector> inv_c_;
+   SmartPtr<Vector> inv_d_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -42,6 +42,8 @@
 #include "IpIterativePardisoSolverInterface.hpp"
 #include "IpInexactNormalTerminationTester.hpp"
 #include "IpInexactPDTerminationTester.hpp"
+#include "IpKrylovAugSystemSolver.hpp"
+#include "IpBlockDiagAugSystemPreconditioner.hpp"
 
 #include "IpLinearSolvers.h"
 
@@ -120,59 +122,86 @@ SmartPtr<IpoptAlgorithm> InexactAlgorithmBuilder::BuildBasicAlgorithm(
    SmartPtr<ConvergenceCheck> convCheck = new OptimalityErrorConvergenceCheck();
 
    SmartPtr<InexactNormalTerminationTester> NormalTester;
-   SmartPtr<SparseSymLinearSolverInterface> SolverInterface;
+   SmartPtr<AugSystemSolver> AugSolver;
    std::string linear_solver;
    options.GetStringValue("linear_solver", linear_solver, prefix);
+   std::string inexact_krylov_method;
+   options.GetStringValue("inexact_krylov_method", inexact_krylov_method, prefix);
 
-   if( linear_solver == "ma27" )
-   {
-      SolverInterface = new Ma27TSolverInterface(GetHSLLoader(options, prefix));
-   }
-
-   else if( linear_solver == "ma57" )
-   {
-      SolverInterface = new Ma57TSolverInterface(GetHSLLoader(options, prefix));
-   }
-
-   else if( linear_solver == "pardiso" )
+   if( inexact_krylov_method != "none" )
    {
       NormalTester = new InexactNormalTerminationTester();
       SmartPtr<IterativeSolverTerminationTester> pd_tester = new InexactPDTerminationTester();
-      SolverInterface = new IterativePardisoSolverInterface(*NormalTester, *pd_tester, GetPardisoLoader(options, prefix));
+      SmartPtr<AugSystemPreconditioner> Preconditioner;
+      std::string inexact_krylov_preconditioner;
+      options.GetStringValue("inexact_krylov_preconditioner", inexact_krylov_preconditioner, prefix);
+      if( inexact_krylov_preconditioner == "block-diagonal" )
+      {
+         Preconditioner = new BlockDiagAugSystemPreconditioner();
+      }
+      AugSolver = new KrylovAugSystemSolver(*NormalTester, *pd_tester, Preconditioner);
+      linear_solver = inexact_krylov_method;
    }
+   else
+   {
+      // the linear solvers below need the entries of the Hessian
+      std::string hessian_evaluation;
+      options.GetStringValue("hessian_evaluation", hessian_evaluation, prefix);
+      ASSERT_EXCEPTION(hessian_evaluation != "products", OPTION_INVALID,
+                       "Option \"hessian_evaluation\" set to \"products\" requires a Krylov method (option \"inexact_krylov_method\") in the inexact algorithm.");
+
+      SmartPtr<SparseSymLinearSolverInterface> SolverInterface;
+
+      if( linear_solver == "ma27" )
+      {
+         SolverInterface = new Ma27TSolverInterface(GetHSLLoader(options, prefix));
+      }
+
+      else if( linear_solver == "ma57" )
+      {
+         SolverInterface = new Ma57TSolverInterface(GetHSLLoader(options, prefix));
+      }
+
+      else if( linear_solver == "pardiso" )
+      {
+         NormalTester = new InexactNormalTerminationTester();
+         SmartPtr<IterativeSolverTerminationTester> pd_tester = new InexactPDTerminationTester();
+         SolverInterface = new IterativePardisoSolverInterface(*NormalTester, *pd_tester, GetPardisoLoader(options, prefix));
+      }
 
 #ifdef IPOPT_HAS_WSMP
-   else if( linear_solver == "wsmp" )
-   {
-      SolverInterface = new WsmpSolverInterface();
-   }
+      else if( linear_solver == "wsmp" )
+      {
+         SolverInterface = new WsmpSolverInterface();
+      }
 #endif
 
 #ifdef IPOPT_HAS_MUMPS
-   else if( linear_solver == "mumps" )
-   {
-      SolverInterface = new MumpsSolverInterface();
-      linear_solver = MumpsSolverInterface::GetName();
-   }
+      else if( linear_solver == "mumps" )
+      {
+         SolverInterface = new MumpsSolverInterface();
+         linear_solver = MumpsSolverInterface::GetName();
+      }
 #endif
 
-   else
-   {
-      THROW_EXCEPTION(OPTION_INVALID, "Inexact version not available for this selection of linear solver.");
-   }
+      else
+      {
+         THROW_EXCEPTION(OPTION_INVALID, "Inexact version not available for this selection of linear solver.");
+      }
 
-   SmartPtr<TSymScalingMethod> ScalingMethod;
+      SmartPtr<TSymScalingMethod> ScalingMethod;
 
-   std::string inexact_linear_system_scaling;
-   options.GetStringValue("inexact_linear_system_scaling", inexact_linear_system_scaling, prefix);
-   if( inexact_linear_system_scaling == "slack-based" )
-   {
-      ScalingMethod = new InexactTSymScalingMethod();
-   }
+      std::string inexact_linear_system_scaling;
+      options.GetStringValue("inexact_linear_system_scaling", inexact_linear_system_scaling, prefix);
+      if( inexact_linear_system_scaling == "slack-based" )
+      {
+         ScalingMethod = new InexactTSymScalingMethod();
+      }
 
-   SmartPtr<SymLinearSolver> ScaledSolver = new TSymLinearSolver(SolverInterface, ScalingMethod);
+      SmartPtr<SymLinearSolver> ScaledSolver = new TSymLinearSolver(SolverInterface, ScalingMethod);
 
-   SmartPtr<AugSystemSolver> AugSolver = new StdAugSystemSolver(*ScaledSolver);
+      AugSolver = new StdAugSystemSolver(*ScaledSolver);
+   }
 
    // Create the object for initializing the iterates Initialization
    // object.  We include both the warm start and the defaut
@@ -9,6 +9,7 @@
 #include <cmath>
 
 #include "IpIterativeSolverTerminationTester.hpp"
+#include "IpKrylovAugSystemSolver.hpp"
 
 extern Ipopt::IterativeSolverTerminationTester::ETerminationTest test_result_;
 
@@ -65,7 +66,9 @@ bool InexactPDSolver::InitializeImpl(
 
    std::string linear_solver;
    options.GetStringValue("linear_solver", linear_solver, prefix);
-   is_pardiso_ = (linear_solver == "pardiso");
+   std::string inexact_krylov_method;
+   options.GetStringValue("inexact_krylov_method", inexact_krylov_method, prefix);
+   is_iterative_ = (linear_solver == "pardiso" || inexact_krylov_method != "none");
 
    if( !augSysSolver_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix) )
    {
@@ -242,7 +245,7 @@ bool InexactPDSolver::Solve(
          InexData().set_tangential_x(tangential_x);
          InexData().set_tangential_s(tangential_s);
 
-         if( !is_pardiso_ )
+         if( !is_iterative_ )
          {
             // check if we need to modify the system
             bool modify_hessian = HessianRequiresChange();
@@ -261,10 +264,14 @@ bool InexactPDSolver::Solve(
          }
          else
          {
+            // the Krylov solver keeps the result itself, the iterative Pardiso interface in a global variable
+            const KrylovAugSystemSolver* krylov = dynamic_cast<const KrylovAugSystemSolver*>(GetRawPtr(augSysSolver_));
+            IterativeSolverTerminationTester::ETerminationTest test_result =
+               krylov != NULL ? krylov->LastTerminationTest() : test_result_;
             char buf[32];
-            Snprintf(buf, 31, " TT=%d", test_result_);
+            Snprintf(buf, 31, " TT=%d", test_result);
             IpData().Append_info_string(buf);
-            if( test_result_ == IterativeSolverTerminationTester::CONTINUE )
+            if( test_result == IterativeSolverTerminationTester::CONTINUE )
             {
                if( InexData().compute_normal() )
                {
@@ -141,10 +141,10 @@ private:
    Index inexact_regularization_ls_count_trigger_;
    ///@}
 
-   /** flag indicating if we are dealing with the Pardiso solver
-    *  (temporary)
+   /** flag indicating if we are dealing with an iterative solver
+    *  that uses the termination tests (Pardiso or a Krylov method)
     */
-   bool is_pardiso_;
+   bool is_iterative_;
 
    Index last_info_ls_count_;
 };
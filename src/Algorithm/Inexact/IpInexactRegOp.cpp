@@ -17,6 +17,7 @@
 #include "IpIterativePardisoSolverInterface.hpp"
 #include "IpInexactNormalTerminationTester.hpp"
 #include "IpInexactPDTerminationTester.hpp"
+#include "IpKrylovAugSystemSolver.hpp"
 
 namespace Ipopt
 {
@@ -34,6 +35,7 @@ void RegisterOptions_Inexact(
    InexactLSAcceptor::RegisterOptions(roptions);
    InexactCq::RegisterOptions(roptions);
    IterativePardisoSolverInterface::RegisterOptions(roptions);
+   KrylovAugSystemSolver::RegisterOptions(roptions);
    InexactNormalTerminationTester::RegisterOptions(roptions);
    InexactPDTerminationTester::RegisterOptions(roptions);
 }
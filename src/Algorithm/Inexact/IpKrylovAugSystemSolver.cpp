@@ -0,0 +1,646 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpKrylovAugSystemSolver.hpp"
+#include "IpTripletHelper.hpp"
+#include "IpBlas.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace Ipopt
+{
+
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+KrylovAugSystemSolver::KrylovAugSystemSolver(
+   IterativeSolverTerminationTester&        normal_tester,
+   IterativeSolverTerminationTester&        pd_tester,
+   const SmartPtr<AugSystemPreconditioner>& preconditioner
+)
+   : normal_tester_(&normal_tester),
+     pd_tester_(&pd_tester),
+     preconditioner_(preconditioner),
+     W_(NULL),
+     W_factor_(0.),
+     J_c_(NULL),
+     J_d_(NULL),
+     norm2_rhs_(0.),
+     test_result_(IterativeSolverTerminationTester::CONTINUE),
+     ndim_(0),
+     sol_vals_(NULL),
+     resid_vals_(NULL)
+{
+   DBG_START_METH("KrylovAugSystemSolver::KrylovAugSystemSolver()", dbg_verbosity);
+}
+
+KrylovAugSystemSolver::~KrylovAugSystemSolver()
+{
+   DBG_START_METH("KrylovAugSystemSolver::~KrylovAugSystemSolver()", dbg_verbosity);
+   delete[] sol_vals_;
+   delete[] resid_vals_;
+}
+
+void KrylovAugSystemSolver::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddStringOption3(
+      "inexact_krylov_method",
+      "Krylov method for the linear systems in the inexact algorithm",
+      "none",
+      "none", "use the iterative solver selected by linear_solver",
+      "sqmr", "preconditioned symmetric QMR method",
+      "minres", "preconditioned MINRES method",
+      "The Krylov methods are implemented in Ipopt and need only products of the Hessian and the constraint Jacobians with vectors. "
+      "Thus, they can also be used if hessian_evaluation is set to products. "
+      "MINRES requires a positive definite preconditioner.");
+   roptions->AddStringOption2(
+      "inexact_krylov_preconditioner",
+      "Preconditioner for the Krylov method in the inexact algorithm",
+      "block-diagonal",
+      "none", "no preconditioner",
+      "block-diagonal", "positive diagonal approximation of the blocks and the Schur complements",
+      "The block-diagonal preconditioner uses the diagonal of the Hessian if its entries are available "
+      "and an estimate of its magnitude otherwise.");
+   roptions->AddLowerBoundedIntegerOption(
+      "inexact_krylov_max_iter",
+      "Maximal number of iterations of the Krylov method for one linear system.",
+      1,
+      500,
+      "");
+}
+
+bool KrylovAugSystemSolver::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   std::string krylov_method;
+   options.GetStringValue("inexact_krylov_method", krylov_method, prefix);
+   if( krylov_method == "minres" )
+   {
+      krylov_method_ = MINRES;
+   }
+   else
+   {
+      krylov_method_ = SQMR;
+   }
+   options.GetIntegerValue("inexact_krylov_max_iter", max_iter_, prefix);
+   std::string inexact_linear_system_scaling;
+   options.GetStringValue("inexact_linear_system_scaling", inexact_linear_system_scaling, prefix);
+   scale_slacks_ = (inexact_linear_system_scaling == "slack-based");
+
+   bool retval = normal_tester_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   if( retval )
+   {
+      retval = pd_tester_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   }
+   if( retval && IsValid(preconditioner_) )
+   {
+      retval = preconditioner_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   }
+
+   return retval;
+}
+
+ESymSolverStatus KrylovAugSystemSolver::Solve(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector*    D_x,
+   Number           delta_x,
+   const Vector*    D_s,
+   Number           delta_s,
+   const Matrix*    J_c,
+   const Vector*    D_c,
+   Number           delta_c,
+   const Matrix*    J_d,
+   const Vector*    D_d,
+   Number           delta_d,
+   const Vector&    rhs_x,
+   const Vector&    rhs_s,
+   const Vector&    rhs_c,
+   const Vector&    rhs_d,
+   Vector&          sol_x,
+   Vector&          sol_s,
+   Vector&          sol_c,
+   Vector&          sol_d,
+   bool             /*check_NegEVals*/,
+   Index            /*numberOfNegEVals*/
+)
+{
+   DBG_START_METH("KrylovAugSystemSolver::Solve", dbg_verbosity);
+   DBG_ASSERT(J_c && J_d);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+   }
+
+   // set up the system
+   ndim_ = rhs_x.Dim() + rhs_s.Dim() + rhs_c.Dim() + rhs_d.Dim();
+   space_ = new CompoundVectorSpace(4, ndim_);
+   space_->SetCompSpace(0, *rhs_x.OwnerSpace());
+   space_->SetCompSpace(1, *rhs_s.OwnerSpace());
+   space_->SetCompSpace(2, *rhs_c.OwnerSpace());
+   space_->SetCompSpace(3, *rhs_d.OwnerSpace());
+
+   W_ = (W_factor != 0.) ? W : NULL;
+   W_factor_ = W_factor;
+   J_c_ = J_c;
+   J_d_ = J_d;
+
+   diag_ = space_->MakeNewCompoundVector();
+   SmartPtr<Vector> diag_x = diag_->GetCompNonConst(0);
+   if( D_x )
+   {
+      diag_x->Copy(*D_x);
+      diag_x->AddScalar(delta_x);
+   }
+   else
+   {
+      diag_x->Set(delta_x);
+   }
+   SmartPtr<Vector> diag_s = diag_->GetCompNonConst(1);
+   if( D_s )
+   {
+      diag_s->Copy(*D_s);
+      diag_s->AddScalar(delta_s);
+   }
+   else
+   {
+      diag_s->Set(delta_s);
+   }
+   SmartPtr<Vector> diag_c = diag_->GetCompNonConst(2);
+   if( D_c )
+   {
+      diag_c->Copy(*D_c);
+      diag_c->AddScalar(-delta_c);
+   }
+   else
+   {
+      diag_c->Set(-delta_c);
+   }
+   SmartPtr<Vector> diag_d = diag_->GetCompNonConst(3);
+   if( D_d )
+   {
+      diag_d->Copy(*D_d);
+      diag_d->AddScalar(-delta_d);
+   }
+   else
+   {
+      diag_d->Set(-delta_d);
+   }
+
+   if( scale_slacks_ )
+   {
+      scaling_s_ = InexCq().curr_scaling_slacks();
+   }
+   else
+   {
+      scaling_s_ = NULL;
+   }
+
+   ESymSolverStatus retval = SYMSOLVER_SUCCESS;
+   if( IsValid(preconditioner_)
+       && !preconditioner_->Update(W_, W_factor_, *diag_x, *diag_s, *J_c, *diag_c, *J_d, *diag_d) )
+   {
+      Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                     "Could not compute preconditioner for Krylov method.\n");
+      retval = SYMSOLVER_FATAL_ERROR;
+   }
+
+   if( retval == SYMSOLVER_SUCCESS )
+   {
+      // the right hand side of the scaled system
+      SmartPtr<CompoundVector> rhs = space_->MakeNewCompoundVector(false);
+      rhs->SetComp(0, rhs_x);
+      if( IsValid(scaling_s_) )
+      {
+         SmartPtr<Vector> scaled_rhs_s = rhs_s.MakeNewCopy();
+         scaled_rhs_s->ElementWiseMultiply(*scaling_s_);
+         rhs->SetComp(1, *scaled_rhs_s);
+      }
+      else
+      {
+         rhs->SetComp(1, rhs_s);
+      }
+      rhs->SetComp(2, rhs_c);
+      rhs->SetComp(3, rhs_d);
+
+      // the solution is computed directly in the output vectors
+      SmartPtr<CompoundVector> sol = space_->MakeNewCompoundVector(false);
+      sol->SetCompNonConst(0, sol_x);
+      sol->SetCompNonConst(1, sol_s);
+      sol->SetCompNonConst(2, sol_c);
+      sol->SetCompNonConst(3, sol_d);
+      sol->Set(0.);
+
+      IterativeSolverTerminationTester* tester;
+      bool is_normal = false;
+      if( IsNull(InexData().normal_x()) && InexData().compute_normal() )
+      {
+         tester = GetRawPtr(normal_tester_);
+         is_normal = true;
+      }
+      else
+      {
+         tester = GetRawPtr(pd_tester_);
+      }
+
+      bool init_ok = tester->InitializeSolve();
+      ASSERT_EXCEPTION(init_ok, INTERNAL_ABORT, "tester->InitializeSolve(); returned false");
+
+      norm2_rhs_ = rhs->Nrm2();
+      Index iters = 0;
+      if( norm2_rhs_ == 0. )
+      {
+         // solution is zero
+         test_result_ = IterativeSolverTerminationTester::OTHER_SATISFIED;
+      }
+      else
+      {
+         delete[] sol_vals_;
+         delete[] resid_vals_;
+         sol_vals_ = new Number[ndim_];
+         resid_vals_ = new Number[ndim_];
+
+         switch( krylov_method_ )
+         {
+            case SQMR:
+               test_result_ = SolveSQMR(*tester, *rhs, *sol, iters);
+               break;
+            case MINRES:
+               test_result_ = SolveMINRES(*tester, *rhs, *sol, iters);
+               break;
+         }
+
+         delete[] sol_vals_;
+         delete[] resid_vals_;
+         sol_vals_ = NULL;
+         resid_vals_ = NULL;
+      }
+      tester->Clear();
+
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Number of iterations in Krylov method for %s step = %" IPOPT_INDEX_FORMAT " (termination test result %d).\n",
+                     is_normal ? "normal" : "PD", iters, test_result_);
+
+      if( !IsFiniteNumber(sol->Nrm2()) )
+      {
+         Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                        "Krylov method produced invalid numbers.\n");
+         retval = SYMSOLVER_FATAL_ERROR;
+      }
+      else if( test_result_ == IterativeSolverTerminationTester::MODIFY_HESSIAN )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "Termination tester requests modification of Hessian\n");
+         retval = SYMSOLVER_WRONG_INERTIA;
+      }
+      else if( test_result_ == IterativeSolverTerminationTester::TEST_2_SATISFIED )
+      {
+         // Termination Test 2 is satisfied, set the step for the primal
+         // iterates to zero
+         sol_x.Set(0.);
+         sol_s.Set(0.);
+      }
+      else if( IsValid(scaling_s_) )
+      {
+         // go back from the scaled system
+         sol_s.ElementWiseMultiply(*scaling_s_);
+      }
+   }
+
+   W_ = NULL;
+   J_c_ = NULL;
+   J_d_ = NULL;
+   diag_ = NULL;
+   scaling_s_ = NULL;
+   space_ = NULL;
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+   }
+
+   return retval;
+}
+
+Index KrylovAugSystemSolver::NumberOfNegEVals() const
+{
+   DBG_ASSERT(false && "KrylovAugSystemSolver does not provide the inertia");
+   return -1;
+}
+
+IterativeSolverTerminationTester::ETerminationTest KrylovAugSystemSolver::SolveSQMR(
+   IterativeSolverTerminationTester& tester,
+   const CompoundVector&             rhs,
+   CompoundVector&                   sol,
+   Index&                            iters
+)
+{
+   DBG_START_METH("KrylovAugSystemSolver::SolveSQMR", dbg_verbosity);
+
+   IterativeSolverTerminationTester::ETerminationTest result = IterativeSolverTerminationTester::CONTINUE;
+   const Number eps = std::numeric_limits<Number>::epsilon();
+
+   // r is the residual of the underlying Lanczos (BCG) iteration,
+   // resid the true residual of sol, which is updated without
+   // additional products by keeping track of A*d
+   SmartPtr<CompoundVector> r = space_->MakeNewCompoundVector();
+   r->Copy(rhs);
+   SmartPtr<CompoundVector> resid = space_->MakeNewCompoundVector();
+   resid->Copy(rhs);
+   SmartPtr<CompoundVector> q = space_->MakeNewCompoundVector();
+   ApplyPreconditioner(*r, *q);
+   SmartPtr<CompoundVector> u = space_->MakeNewCompoundVector();
+   SmartPtr<CompoundVector> t = space_->MakeNewCompoundVector();
+   SmartPtr<CompoundVector> d = space_->MakeNewCompoundVector();
+   d->Set(0.);
+   SmartPtr<CompoundVector> Ad = space_->MakeNewCompoundVector();
+   Ad->Set(0.);
+
+   Number tau = r->Nrm2();
+   Number theta = 0.;
+   Number rho = r->Dot(*q);
+
+   iters = 0;
+   while( iters < max_iter_ )
+   {
+      MultSystem(*q, *t);
+      Number sigma = q->Dot(*t);
+      if( sigma == 0. || !IsFiniteNumber(sigma) )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR breakdown in iteration %" IPOPT_INDEX_FORMAT " (sigma = %e).\n", iters + 1, sigma);
+         break;
+      }
+      iters++;
+
+      Number alpha = rho / sigma;
+      r->Axpy(-alpha, *t);
+
+      Number theta_old = theta;
+      theta = r->Nrm2() / tau;
+      Number c2 = 1. / (1. + theta * theta);
+      tau = tau * theta * std::sqrt(c2);
+
+      d->AddOneVector(c2 * alpha, *q, c2 * theta_old * theta_old);
+      Ad->AddOneVector(c2 * alpha, *t, c2 * theta_old * theta_old);
+      sol.Axpy(1., *d);
+      resid->Axpy(-1., *Ad);
+
+      result = TestTermination(tester, sol, *resid, iters);
+      if( result != IterativeSolverTerminationTester::CONTINUE )
+      {
+         break;
+      }
+      if( resid->Nrm2() <= eps * norm2_rhs_ )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR stops in iteration %" IPOPT_INDEX_FORMAT " since the residual cannot be reduced further.\n", iters);
+         break;
+      }
+      ApplyPreconditioner(*r, *u);
+      Number rho_new = r->Dot(*u);
+      if( rho_new == 0. || !IsFiniteNumber(rho_new) )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR breakdown in iteration %" IPOPT_INDEX_FORMAT " (rho = %e).\n", iters, rho_new);
+         break;
+      }
+      Number beta = rho_new / rho;
+      rho = rho_new;
+      q->AddOneVector(1., *u, beta);
+   }
+
+   return result;
+}
+
+IterativeSolverTerminationTester::ETerminationTest KrylovAugSystemSolver::SolveMINRES(
+   IterativeSolverTerminationTester& tester,
+   const CompoundVector&             rhs,
+   CompoundVector&                   sol,
+   Index&                            iters
+)
+{
+   DBG_START_METH("KrylovAugSystemSolver::SolveMINRES", dbg_verbosity);
+
+   IterativeSolverTerminationTester::ETerminationTest result = IterativeSolverTerminationTester::CONTINUE;
+   const Number eps = std::numeric_limits<Number>::epsilon();
+
+   // r1 and r2 are the last two unpreconditioned Lanczos vectors,
+   // resid the true residual of sol, which is updated without
+   // additional products by keeping track of A*w
+   SmartPtr<CompoundVector> r1 = space_->MakeNewCompoundVector();
+   r1->Copy(rhs);
+   SmartPtr<CompoundVector> r2 = space_->MakeNewCompoundVector();
+   r2->Copy(rhs);
+   SmartPtr<CompoundVector> resid = space_->MakeNewCompoundVector();
+   resid->Copy(rhs);
+   SmartPtr<CompoundVector> y = space_->MakeNewCompoundVector();
+   ApplyPreconditioner(*r1, *y);
+   SmartPtr<CompoundVector> v = space_->MakeNewCompoundVector();
+   SmartPtr<CompoundVector> Av = space_->MakeNewCompoundVector();
+   SmartPtr<CompoundVector> w = space_->MakeNewCompoundVector();
+   w->Set(0.);
+   SmartPtr<CompoundVector> w1 = space_->MakeNewCompoundVector();
+   w1->Set(0.);
+   SmartPtr<CompoundVector> w2 = space_->MakeNewCompoundVector();
+   w2->Set(0.);
+   SmartPtr<CompoundVector> Aw = space_->MakeNewCompoundVector();
+   Aw->Set(0.);
+   SmartPtr<CompoundVector> Aw1 = space_->MakeNewCompoundVector();
+   Aw1->Set(0.);
+   SmartPtr<CompoundVector> Aw2 = space_->MakeNewCompoundVector();
+   Aw2->Set(0.);
+
+   Number beta = r1->Dot(*y);
+   if( beta <= 0. || !IsFiniteNumber(beta) )
+   {
+      Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                     "Preconditioner for MINRES is not positive definite.\n");
+      iters = 0;
+      return result;
+   }
+   beta = std::sqrt(beta);
+
+   Number oldb = 0.;
+   Number dbar = 0.;
+   Number epsln = 0.;
+   Number phibar = beta;
+   Number cs = -1.;
+   Number sn = 0.;
+
+   iters = 0;
+   while( iters < max_iter_ )
+   {
+      iters++;
+
+      // Lanczos step
+      v->Copy(*y);
+      v->Scal(1. / beta);
+      MultSystem(*v, *Av);
+      y->Copy(*Av);
+      if( iters >= 2 )
+      {
+         y->Axpy(-beta / oldb, *r1);
+      }
+      Number alpha = v->Dot(*y);
+      y->Axpy(-alpha / beta, *r2);
+      SmartPtr<CompoundVector> tmp = r1;
+      r1 = r2;
+      r2 = tmp;
+      r2->Copy(*y);
+      ApplyPreconditioner(*r2, *y);
+      oldb = beta;
+      beta = r2->Dot(*y);
+      if( beta < 0. || !IsFiniteNumber(beta) )
+      {
+         Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                        "Preconditioner for MINRES is not positive definite.\n");
+         break;
+      }
+      beta = std::sqrt(beta);
+
+      // apply previous rotation and compute new one
+      Number oldeps = epsln;
+      Number delta = cs * dbar + sn * alpha;
+      Number gbar = sn * dbar - cs * alpha;
+      epsln = sn * beta;
+      dbar = -cs * beta;
+      Number gamma = Max(std::sqrt(gbar * gbar + beta * beta), eps);
+      cs = gbar / gamma;
+      sn = beta / gamma;
+      Number phi = cs * phibar;
+      phibar = sn * phibar;
+
+      // update solution and residual
+      tmp = w1;
+      w1 = w2;
+      w2 = w;
+      w = tmp;
+      w->AddTwoVectors(-oldeps / gamma, *w1, -delta / gamma, *w2, 0.);
+      w->Axpy(1. / gamma, *v);
+      tmp = Aw1;
+      Aw1 = Aw2;
+      Aw2 = Aw;
+      Aw = tmp;
+      Aw->AddTwoVectors(-oldeps / gamma, *Aw1, -delta / gamma, *Aw2, 0.);
+      Aw->Axpy(1. / gamma, *Av);
+      sol.Axpy(phi, *w);
+      resid->Axpy(-phi, *Aw);
+
+      result = TestTermination(tester, sol, *resid, iters);
+      if( result != IterativeSolverTerminationTester::CONTINUE )
+      {
+         break;
+      }
+      if( beta == 0. || resid->Nrm2() <= eps * norm2_rhs_ )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "MINRES stops in iteration %" IPOPT_INDEX_FORMAT " since the residual cannot be reduced further.\n", iters);
+         break;
+      }
+   }
+
+   return result;
+}
+
+void KrylovAugSystemSolver::MultSystem(
+   const CompoundVector& v,
+   CompoundVector&       Av
+) const
+{
+   const Vector& v_x = *v.GetComp(0);
+   SmartPtr<const Vector> v_s = v.GetComp(1);
+   const Vector& v_c = *v.GetComp(2);
+   const Vector& v_d = *v.GetComp(3);
+   if( IsValid(scaling_s_) )
+   {
+      SmartPtr<Vector> tmp = v_s->MakeNewCopy();
+      tmp->ElementWiseMultiply(*scaling_s_);
+      v_s = ConstPtr(tmp);
+   }
+
+   SmartPtr<Vector> Av_x = Av.GetCompNonConst(0);
+   Av_x->Copy(v_x);
+   Av_x->ElementWiseMultiply(*diag_->GetComp(0));
+   if( W_ != NULL )
+   {
+      W_->MultVector(W_factor_, v_x, 1., *Av_x);
+   }
+   J_c_->TransMultVector(1., v_c, 1., *Av_x);
+   J_d_->TransMultVector(1., v_d, 1., *Av_x);
+
+   SmartPtr<Vector> Av_s = Av.GetCompNonConst(1);
+   Av_s->Copy(*v_s);
+   Av_s->ElementWiseMultiply(*diag_->GetComp(1));
+   Av_s->Axpy(-1., v_d);
+   if( IsValid(scaling_s_) )
+   {
+      Av_s->ElementWiseMultiply(*scaling_s_);
+   }
+
+   SmartPtr<Vector> Av_c = Av.GetCompNonConst(2);
+   Av_c->Copy(v_c);
+   Av_c->ElementWiseMultiply(*diag_->GetComp(2));
+   J_c_->MultVector(1., v_x, 1., *Av_c);
+
+   SmartPtr<Vector> Av_d = Av.GetCompNonConst(3);
+   Av_d->Copy(v_d);
+   Av_d->ElementWiseMultiply(*diag_->GetComp(3));
+   Av_d->Axpy(-1., *v_s);
+   J_d_->MultVector(1., v_x, 1., *Av_d);
+}
+
+void KrylovAugSystemSolver::ApplyPreconditioner(
+   const CompoundVector& r,
+   CompoundVector&       z
+) const
+{
+   if( IsNull(preconditioner_) )
+   {
+      z.Copy(r);
+      return;
+   }
+
+   // the preconditioner is for the unscaled system
+   SmartPtr<const Vector> r_s = r.GetComp(1);
+   if( IsValid(scaling_s_) )
+   {
+      SmartPtr<Vector> tmp = r_s->MakeNewCopy();
+      tmp->ElementWiseDivide(*scaling_s_);
+      r_s = ConstPtr(tmp);
+   }
+   SmartPtr<Vector> z_s = z.GetCompNonConst(1);
+   preconditioner_->Apply(*r.GetComp(0), *r_s, *r.GetComp(2), *r.GetComp(3), *z.GetCompNonConst(0), *z_s,
+                          *z.GetCompNonConst(2), *z.GetCompNonConst(3));
+   if( IsValid(scaling_s_) )
+   {
+      z_s->ElementWiseDivide(*scaling_s_);
+   }
+}
+
+IterativeSolverTerminationTester::ETerminationTest KrylovAugSystemSolver::TestTermination(
+   IterativeSolverTerminationTester& tester,
+   const CompoundVector&             sol,
+   const CompoundVector&             resid,
+   Index                             iter
+)
+{
+   TripletHelper::FillValuesFromVector(ndim_, sol, sol_vals_);
+   TripletHelper::FillValuesFromVector(ndim_, resid, resid_vals_);
+   IterativeSolverTerminationTester::ETerminationTest result = tester.TestTermination(ndim_, sol_vals_, resid_vals_, iter,
+         norm2_rhs_);
+   Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                  "Krylov iteration %" IPOPT_INDEX_FORMAT ": residual %e, termination tester result = %d.\n", iter,
+                  IpBlasNrm2(ndim_, resid_vals_, 1), result);
+   return result;
+}
+
+} // namespace Ipopt
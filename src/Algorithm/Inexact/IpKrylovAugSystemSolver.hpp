@@ -0,0 +1,256 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPKRYLOVAUGSYSTEMSOLVER_HPP__
+#define __IPKRYLOVAUGSYSTEMSOLVER_HPP__
+
+#include "IpAugSystemSolver.hpp"
+#include "IpAugSystemPreconditioner.hpp"
+#include "IpIterativeSolverTerminationTester.hpp"
+#include "IpCompoundVector.hpp"
+
+namespace Ipopt
+{
+
+/** Solver for the augmented system based on a preconditioned Krylov
+ *  method (SQMR or MINRES).
+ *
+ *  The augmented system matrix is never formed; only products of W
+ *  and the Jacobians with vectors are used.  Thus, this solver also
+ *  works if the Hessian is only available through products with
+ *  vectors (option hessian_evaluation set to products).
+ *
+ *  The iterations are stopped by the termination tests of the
+ *  inexact algorithm, which are given by the normal_tester (for the
+ *  computation of the normal step) and the pd_tester (for the
+ *  primal-dual step).  As for the iterative Pardiso solver, the
+ *  slack part of the system is scaled if inexact_linear_system_scaling
+ *  is set to slack-based, and the solution and residual that are
+ *  given to the termination tests refer to the scaled system.
+ *
+ *  @since 3.15.0
+ */
+class KrylovAugSystemSolver: public AugSystemSolver
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Constructor */
+   KrylovAugSystemSolver(
+      IterativeSolverTerminationTester&       normal_tester,
+      IterativeSolverTerminationTester&       pd_tester,
+      const SmartPtr<AugSystemPreconditioner>& preconditioner /**< preconditioner, NULL for none */
+   );
+
+   /** Destructor */
+   virtual ~KrylovAugSystemSolver();
+   ///@}
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   virtual ESymSolverStatus Solve(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector*    D_x,
+      Number           delta_x,
+      const Vector*    D_s,
+      Number           delta_s,
+      const Matrix*    J_c,
+      const Vector*    D_c,
+      Number           delta_c,
+      const Matrix*    J_d,
+      const Vector*    D_d,
+      Number           delta_d,
+      const Vector&    rhs_x,
+      const Vector&    rhs_s,
+      const Vector&    rhs_c,
+      const Vector&    rhs_d,
+      Vector&          sol_x,
+      Vector&          sol_s,
+      Vector&          sol_c,
+      Vector&          sol_d,
+      bool             check_NegEVals,
+      Index            numberOfNegEVals
+   );
+
+   /** Number of negative eigenvalues detected during last solve.
+    *
+    *  Not available for Krylov methods.
+    */
+   virtual Index NumberOfNegEVals() const;
+
+   /** Query whether inertia is computed by linear solver.
+    *
+    *  Always false for Krylov methods.
+    */
+   virtual bool ProvidesInertia() const
+   {
+      return false;
+   }
+
+   /** Request to increase quality of solution for next solve.
+    *
+    *  The accuracy is determined by the termination tests, so this
+    *  always returns false.
+    */
+   virtual bool IncreaseQuality()
+   {
+      return false;
+   }
+
+   /** Result of the last termination test of the most recent solve */
+   IterativeSolverTerminationTester::ETerminationTest LastTerminationTest() const
+   {
+      return test_result_;
+   }
+
+   /** Methods for OptionsList */
+   ///@{
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default constructor */
+   KrylovAugSystemSolver();
+
+   /** Copy Constructor */
+   KrylovAugSystemSolver(
+      const KrylovAugSystemSolver&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const KrylovAugSystemSolver&
+   );
+   ///@}
+
+   /** Enumeration for the Krylov method */
+   enum KrylovMethodEnum
+   {
+      SQMR,
+      MINRES
+   };
+
+   /** Preconditioned symmetric QMR method (Freund and Nachtigal).
+    *
+    *  Starts from sol = 0 and returns the result of the last
+    *  termination test.
+    */
+   IterativeSolverTerminationTester::ETerminationTest SolveSQMR(
+      IterativeSolverTerminationTester& tester,
+      const CompoundVector&             rhs,
+      CompoundVector&                   sol,
+      Index&                            iters
+   );
+
+   /** Preconditioned MINRES method (Paige and Saunders).
+    *
+    *  Starts from sol = 0 and returns the result of the last
+    *  termination test.
+    */
+   IterativeSolverTerminationTester::ETerminationTest SolveMINRES(
+      IterativeSolverTerminationTester& tester,
+      const CompoundVector&             rhs,
+      CompoundVector&                   sol,
+      Index&                            iters
+   );
+
+   /** Compute the product of the (scaled) augmented system matrix with v */
+   void MultSystem(
+      const CompoundVector& v,
+      CompoundVector&       Av
+   ) const;
+
+   /** Apply the inverse of the (scaled) preconditioner to r */
+   void ApplyPreconditioner(
+      const CompoundVector& r,
+      CompoundVector&       z
+   ) const;
+
+   /** Call the termination tester for the current solution and residual */
+   IterativeSolverTerminationTester::ETerminationTest TestTermination(
+      IterativeSolverTerminationTester& tester,
+      const CompoundVector&             sol,
+      const CompoundVector&             resid,
+      Index                             iter
+   );
+
+   /** Method to easily access Inexact calculated quantities */
+   InexactCq& InexCq()
+   {
+      InexactCq& inexact_cq = static_cast<InexactCq&>(IpCq().AdditionalCq());
+      DBG_ASSERT(dynamic_cast<InexactCq*>(&IpCq().AdditionalCq()));
+      return inexact_cq;
+   }
+
+   /** Method to easily access Inexact data */
+   InexactData& InexData()
+   {
+      InexactData& inexact_data = static_cast<InexactData&>(IpData().AdditionalData());
+      DBG_ASSERT(dynamic_cast<InexactData*>(&IpData().AdditionalData()));
+      return inexact_data;
+   }
+
+   /** Termination tester for the normal step */
+   SmartPtr<IterativeSolverTerminationTester> normal_tester_;
+   /** Termination tester for the primal-dual step */
+   SmartPtr<IterativeSolverTerminationTester> pd_tester_;
+   /** Preconditioner, NULL if none is used */
+   SmartPtr<AugSystemPreconditioner> preconditioner_;
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** Krylov method */
+   KrylovMethodEnum krylov_method_;
+   /** Maximal number of iterations of the Krylov method */
+   Index max_iter_;
+   /** Whether the slack part of the system is scaled */
+   bool scale_slacks_;
+   ///@}
+
+   /** @name Augmented system of the current solve */
+   ///@{
+   /** Space of the vectors (x, s, c, d) */
+   SmartPtr<CompoundVectorSpace> space_;
+   const SymMatrix* W_;
+   Number W_factor_;
+   const Matrix* J_c_;
+   const Matrix* J_d_;
+   /** Diagonals D_x + delta_x, D_s + delta_s, D_c - delta_c, D_d - delta_d */
+   SmartPtr<CompoundVector> diag_;
+   /** Scaling factors for the slacks, NULL if not scaled */
+   SmartPtr<const Vector> scaling_s_;
+   /** Norm of the right hand side of the scaled system */
+   Number norm2_rhs_;
+   ///@}
+
+   /** Result of the last termination test of the most recent solve */
+   IterativeSolverTerminationTester::ETerminationTest test_result_;
+
+   /** @name Arrays for the solution and residual that are given to the termination tester */
+   ///@{
+   Index ndim_;
+   Number* sol_vals_;
+   Number* resid_vals_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -35,6 +35,7 @@
 #include "IpDefaultIterateInitializer.hpp"
 #include "IpWarmStartIterateInitializer.hpp"
 #include "IpOrigIterationOutput.hpp"
+#include "IpTelemetryIterationOutput.hpp"
 #include "IpLimMemQuasiNewtonUpdater.hpp"
 #include "IpOrigIpoptNLP.hpp"
 #include "IpLowRankAugSystemSolver.hpp"
@@ -48,8 +49,10 @@
 #include "IpUserScaling.hpp"
 #include "IpGradientScaling.hpp"
 #include "IpEquilibrationScaling.hpp"
+#include "IpRuizScaling.hpp"
 #include "IpExactHessianUpdater.hpp"
 #include "IpSlackBasedTSymScalingMethod.hpp"
+#include "IpRuizTSymScalingMethod.hpp"
 
 #include "IpLinearSolvers.h"
 #include "IpMa27TSolverInterface.hpp"
@@ -293,6 +296,9 @@ void AlgorithmBuilder::RegisterOptions(
    options.push_back("slack-based");
    descrs.push_back("use the slack values");
 
+   options.push_back("ruiz");
+   descrs.push_back("use symmetric Ruiz equilibration");
+
    roptions->AddStringOption(
       "linear_system_scaling", "Method for scaling the linear system.",
       defaultsolver,
@@ -325,6 +331,8 @@ void AlgorithmBuilder::RegisterOptions(
    descrs.push_back("scaling parameters will come from the user");
    options.push_back("gradient-based");
    descrs.push_back("scale the problem so the maximum gradient at the starting point is nlp_scaling_max_gradient");
+   options.push_back("ruiz");
+   descrs.push_back("scale the problem so that first derivatives at the starting point are of order 1 (iterative row and column equilibration)");
 
    if( availablesolvers & IPOPTLINEARSOLVER_MC19 )
    {
@@ -539,6 +547,10 @@ SmartPtr<SymLinearSolver> AlgorithmBuilder::SymLinearSolverFactory(
    {
       ScalingMethod = new SlackBasedTSymScalingMethod();
    }
+   else if( linear_system_scaling == "ruiz" )
+   {
+      ScalingMethod = new RuizTSymScalingMethod();
+   }
 #ifndef IPOPT_INT64
    else if( linear_system_scaling == "mc19" )
    {
@@ -571,6 +583,11 @@ SmartPtr<AugSystemSolver> AlgorithmBuilder::AugSystemSolverFactory(
 )
 {
    SmartPtr<AugSystemSolver> AugSolver;
+
+   Index enum_int;
+   options.GetEnumValue("hessian_approximation", enum_int, prefix);
+   HessianApproximationType hessian_approximation = HessianApproximationType(enum_int);
+
    std::string linear_solver;
    options.GetStringValue("linear_solver", linear_solver, prefix);
    if( linear_solver == "custom" )
@@ -580,12 +597,17 @@ SmartPtr<AugSystemSolver> AlgorithmBuilder::AugSystemSolverFactory(
    }
    else
    {
+      if( hessian_approximation == EXACT )
+      {
+         // the symmetric linear solvers need the entries of the Hessian
+         std::string hessian_evaluation;
+         options.GetStringValue("hessian_evaluation", hessian_evaluation, prefix);
+         ASSERT_EXCEPTION(hessian_evaluation != "products", OPTION_INVALID,
+                          "Option \"hessian_evaluation\" set to \"products\" requires a custom augmented system solver that works with matrix-vector products only.");
+      }
       AugSolver = new StdAugSystemSolver(*GetSymLinearSolver(jnlst, options, prefix));
    }
 
-   Index enum_int;
-   options.GetEnumValue("hessian_approximation", enum_int, prefix);
-   HessianApproximationType hessian_approximation = HessianApproximationType(enum_int);
    if( hessian_approximation == LIMITED_MEMORY )
    {
       std::string lm_aug_solver;
@@ -686,6 +708,10 @@ void AlgorithmBuilder::BuildIpoptObjects(
    {
       nlp_scaling = new EquilibrationScaling(nlp, GetHSLLoader(options, prefix));
    }
+   else if( nlp_scaling_method == "ruiz" )
+   {
+      nlp_scaling = new RuizScaling(nlp);
+   }
    else
    {
       nlp_scaling = new NoNLPScalingObject();
@@ -758,12 +784,20 @@ SmartPtr<IpoptAlgorithm> AlgorithmBuilder::BuildBasicAlgorithm(
 
 SmartPtr<IterationOutput> AlgorithmBuilder::BuildIterationOutput(
    const Journalist&     /*jnlst*/,
-   const OptionsList&    /*options*/,
-   const std::string&    /*prefix*/
+   const OptionsList&    options,
+   const std::string&    prefix
 )
 {
    // Create the object for the iteration output
    SmartPtr<IterationOutput> IterOutput = new OrigIterationOutput();
+
+   // Wrap it into an object that also writes records for each iteration, if desired
+   std::string telemetry_file;
+   options.GetStringValue("iteration_telemetry_file", telemetry_file, prefix);
+   if( telemetry_file != "" )
+   {
+      IterOutput = new TelemetryIterationOutput(IterOutput);
+   }
    return IterOutput;
 }
 
@@ -14,6 +14,7 @@
 #include "IpFilterLSAcceptor.hpp"
 #include "IpGradientScaling.hpp"
 #include "IpEquilibrationScaling.hpp"
+#include "IpRuizScaling.hpp"
 #include "IpIpoptAlg.hpp"
 #include "IpIpoptCalculatedQuantities.hpp"
 #include "IpIpoptData.hpp"
@@ -34,6 +35,7 @@
 #include "IpRestoIpoptNLP.hpp"
 #include "IpRestoMinC_1Nrm.hpp"
 #include "IpRestoPenaltyConvCheck.hpp"
+#include "IpTelemetryIterationOutput.hpp"
 #include "IpWarmStartIterateInitializer.hpp"
 
 namespace Ipopt
@@ -61,6 +63,8 @@ void RegisterOptions_Algorithm(
    GradientScaling::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("NLP Scaling");
    EquilibrationScaling::RegisterOptions(roptions);
+   roptions->SetRegisteringCategory("NLP Scaling");
+   RuizScaling::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("");
    IpoptAlgorithm::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("");
@@ -77,6 +81,8 @@ void RegisterOptions_Algorithm(
    OrigIpoptNLP::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Output");
    OrigIterationOutput::RegisterOptions(roptions);
+   roptions->SetRegisteringCategory("Output");
+   TelemetryIterationOutput::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Step Calculation");
    PDSearchDirCalculator::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Step Calculation");
@@ -79,6 +79,18 @@ void BacktrackingLineSearch::RegisterOptions(
       -1,
       "Setting this to -1 disables this option.",
       true);
+   roptions->AddLowerBoundedIntegerOption(
+      "line_search_parallel_trials",
+      "Number of trial points of the backtracking line search at which functions are evaluated at once.",
+      1,
+      1,
+      "If larger than 1, the primal trial points for this many step sizes are computed ahead and "
+      "objective and constraint functions are evaluated at all of them together, in separate threads if supported by the NLP. "
+      "This can reduce the wallclock time of a line search with expensive function evaluations and several backtracking steps, "
+      "at the cost of evaluations at trial points that are not needed. "
+      "If the NLP is given as TNLP, then its methods eval_f and eval_g must be safe to be called concurrently. "
+      "Parallel evaluation is only available if Ipopt has been built with C++11 support.",
+      true);
 
    roptions->AddStringOption10(
       "alpha_for_y",
@@ -196,6 +208,7 @@ bool BacktrackingLineSearch::InitializeImpl(
    options.GetBoolValue("magic_steps", magic_steps_, prefix);
    options.GetBoolValue("accept_every_trial_step", accept_every_trial_step_, prefix);
    options.GetIntegerValue("accept_after_max_steps", accept_after_max_steps_, prefix);
+   options.GetIntegerValue("line_search_parallel_trials", parallel_trials_, prefix);
    Index enum_int;
    bool is_default = !options.GetEnumValue("alpha_for_y", enum_int, prefix);
    alpha_for_y_ = AlphaForYEnum(enum_int);
@@ -723,6 +736,24 @@ bool BacktrackingLineSearch::DoBacktrackingLineSearch(
 
    if( !accept )
    {
+      // If requested, compute the primal trial points for the first few
+      // step sizes and let the NLP evaluate the functions at all of them
+      // at once, so that the evaluations can be done in parallel
+      std::vector<SmartPtr<const Vector> > trial_x;
+      if( parallel_trials_ > 1 && !in_watchdog_ && !accept_every_trial_step_ )
+      {
+         Number alpha = alpha_primal;
+         for( Index k = 0; k < parallel_trials_ && (alpha > alpha_min || k == 0); k++ )
+         {
+            SmartPtr<Vector> x = IpData().curr()->x()->MakeNew();
+            x->AddTwoVectors(1., *IpData().curr()->x(), alpha, *actual_delta->x(), 0.);
+            trial_x.push_back(ConstPtr(x));
+            alpha *= alpha_red_factor_;
+         }
+         IpNLP().PrecomputeEvaluations(trial_x);
+      }
+      Index n_trial = 0;
+
       // Loop over decreasing step sizes until acceptable point is
       // found or until step size becomes too small
 
@@ -736,7 +767,14 @@ bool BacktrackingLineSearch::DoBacktrackingLineSearch(
          try
          {
             // Compute the primal trial point
-            IpData().SetTrialPrimalVariablesFromStep(alpha_primal, *actual_delta->x(), *actual_delta->s());
+            if( n_trial < (Index) trial_x.size() )
+            {
+               IpData().SetTrialPrimalVariables(*trial_x[n_trial], alpha_primal, *actual_delta->s());
+            }
+            else
+            {
+               IpData().SetTrialPrimalVariablesFromStep(alpha_primal, *actual_delta->x(), *actual_delta->s());
+            }
 
             if( magic_steps_ )
             {
@@ -815,6 +853,7 @@ bool BacktrackingLineSearch::DoBacktrackingLineSearch(
          // Point is not yet acceptable, try a shorter one
          alpha_primal *= alpha_red_factor_;
          n_steps++;
+         n_trial++;
       }
    } /* if (!accept) */
 
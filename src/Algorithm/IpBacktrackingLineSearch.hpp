@@ -347,6 +347,8 @@ private:
     *  even if it is not satisfying acceptance criteria.
     */
    Index accept_after_max_steps_;
+   /** Number of trial points at which functions are evaluated at once */
+   Index parallel_trials_;
    /** Indicates whether problem can be expected to be infeasible.
     *
     *  This will trigger requesting a tighter reduction in
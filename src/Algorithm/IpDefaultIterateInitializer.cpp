@@ -5,6 +5,7 @@
 // Authors:  Carl Laird, Andreas Waechter              IBM    2004-09-23
 
 #include "IpDefaultIterateInitializer.hpp"
+#include "IpWarmStartIterateInitializer.hpp"
 
 #include <limits>
 
@@ -174,6 +175,25 @@ bool DefaultIterateInitializer::SetInitialIterates()
    DBG_START_METH("DefaultIterateInitializer::SetInitialIterates",
                   dbg_verbosity);
 
+   // a snapshot of a previous run is used by the warm start initializer, too,
+   // if its iterate fits to the problem; otherwise it is ignored completely
+   SmartPtr<const SolverState> state = IpData().WarmStartState();
+   if( !warm_start_init_point_ && IsValid(state) && IsValid(warm_start_initializer_) )
+   {
+      if( !IpData().InitializeDataStructures(IpNLP(), true, false, false, false, false) )
+      {
+         return false;
+      }
+      SmartPtr<IteratesVector> iterate = IpData().curr()->MakeNewIteratesVector(true);
+      if( WarmStartIterateInitializer::GetSnapshotIterate(IpNLP(), *state, *iterate) )
+      {
+         return warm_start_initializer_->SetInitialIterates();
+      }
+      Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                     "Iterate of previous run does not fit to the problem or its scaling, ignoring it.\n");
+      IpData().SetWarmStartState(NULL);
+   }
+
    if( warm_start_init_point_ )
    {
       DBG_ASSERT(IsValid(warm_start_initializer_));
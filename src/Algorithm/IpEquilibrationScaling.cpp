@@ -10,6 +10,8 @@
 #include "IpTypes.h"
 
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 #ifdef IPOPT_HAS_HSL
 #include "CoinHslConfig.h"
@@ -107,90 +109,102 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
    // We store the added absolute values of the Jacobian and
    // objective function gradient in an array of sufficient size
 
-   SmartPtr<Matrix> jac_c = jac_c_space->MakeNew();
-   SmartPtr<Matrix> jac_d = jac_d_space->MakeNew();
-   SmartPtr<Vector> grad_f = x_space->MakeNew();
-   const Index nnz_jac_c = TripletHelper::GetNumberEntries(*jac_c);
-   const Index nnz_jac_d = TripletHelper::GetNumberEntries(*jac_d);
+   const Index num_evals = 4;
+   std::vector<SmartPtr<Vector> > grad_f(num_evals);
+   std::vector<SmartPtr<Matrix> > jac_c(num_evals);
+   std::vector<SmartPtr<Matrix> > jac_d(num_evals);
+   for( Index ieval = 0; ieval < num_evals; ieval++ )
+   {
+      grad_f[ieval] = x_space->MakeNew();
+      jac_c[ieval] = jac_c_space->MakeNew();
+      jac_d[ieval] = jac_d_space->MakeNew();
+   }
+   const Index nnz_jac_c = TripletHelper::GetNumberEntries(*jac_c[0]);
+   const Index nnz_jac_d = TripletHelper::GetNumberEntries(*jac_d[0]);
    const Index nc = jac_c_space->NRows();
    const Index nd = jac_d_space->NRows();
    const Index nx = x_space->Dim();
-   Number* avrg_values = new Number[nnz_jac_c + nnz_jac_d + nx];
-   Number* val_buffer = new Number[Max(nnz_jac_c, nnz_jac_d, nx)];
 
    SmartPtr<PointPerturber> perturber = new PointPerturber(*x0, point_perturbation_radius_, Px_L, x_L, Px_U, x_U);
 
-   const Index num_evals = 4;
+   // Compute obj gradient and Jacobian at random perturbation points;
+   // first let the NLP evaluate them at all points at once (possibly in parallel)
+   std::vector<SmartPtr<Vector> > xpert(num_evals);
+   const Vector** xpert_ptr = new const Vector*[num_evals];
+   Vector** grad_f_ptr = new Vector*[num_evals];
+   Matrix** jac_c_ptr = new Matrix*[num_evals];
+   Matrix** jac_d_ptr = new Matrix*[num_evals];
+   bool* success = new bool[num_evals];
+   for( Index ieval = 0; ieval < num_evals; ieval++ )
+   {
+      xpert[ieval] = perturber->MakeNewPerturbedPoint();
+      xpert_ptr[ieval] = GetRawPtr(xpert[ieval]);
+      grad_f_ptr[ieval] = GetRawPtr(grad_f[ieval]);
+      jac_c_ptr[ieval] = GetRawPtr(jac_c[ieval]);
+      jac_d_ptr[ieval] = GetRawPtr(jac_d[ieval]);
+   }
+   const bool evaluated = nlp_->Eval_grad_f_jac_c_d_AtPoints(num_evals, xpert_ptr, grad_f_ptr, jac_c_ptr, jac_d_ptr,
+                          success);
+   delete[] xpert_ptr;
+   delete[] grad_f_ptr;
+   delete[] jac_c_ptr;
+   delete[] jac_d_ptr;
+
+   // then evaluate one after the other at the points that are left,
+   // replacing points where the evaluation failed by new ones
    const Index max_num_eval_errors = 10;
    Index num_eval_errors = 0;
    for( Index ieval = 0; ieval < num_evals; ieval++ )
    {
-      // Compute obj gradient and Jacobian at random perturbation point
-      bool done = false;
+      bool done = evaluated && success[ieval];
+      if( evaluated && !done )
+      {
+         Jnlst().Printf(J_WARNING, J_INITIALIZATION,
+                        "Error evaluating first derivatives as at perturbed point for equilibration-based scaling.\n");
+         num_eval_errors++;
+         xpert[ieval] = perturber->MakeNewPerturbedPoint();
+      }
       while( !done )
       {
-         SmartPtr<Vector> xpert = perturber->MakeNewPerturbedPoint();
-         done =
-            (nlp_->Eval_grad_f(*xpert, *grad_f) && nlp_->Eval_jac_c(*xpert, *jac_c) && nlp_->Eval_jac_d(*xpert, *jac_d));
-         if( !done )
-         {
-            Jnlst().Printf(J_WARNING, J_INITIALIZATION,
-                           "Error evaluating first derivatives as at perturbed point for equilibration-based scaling.\n");
-            num_eval_errors++;
-         }
          if( num_eval_errors > max_num_eval_errors )
          {
-            delete[] val_buffer;
-            delete[] avrg_values;
+            delete[] success;
             THROW_EXCEPTION(FAILED_INITIALIZATION, "Too many evaluation failures during equilibiration-based scaling.");
          }
-      }
-      // Get the numbers out of the matrices and vectors, and add it
-      // to avrg_values
-      TripletHelper::FillValues(nnz_jac_c, *jac_c, val_buffer);
-      if( ieval == 0 )
-      {
-         for( Index i = 0; i < nnz_jac_c; i++ )
-         {
-            avrg_values[i] = std::abs(val_buffer[i]);
-         }
-      }
-      else
-      {
-         for( Index i = 0; i < nnz_jac_c; i++ )
-         {
-            avrg_values[i] += std::abs(val_buffer[i]);
-         }
-      }
-      TripletHelper::FillValues(nnz_jac_d, *jac_d, val_buffer);
-      if( ieval == 0 )
-      {
-         for( Index i = 0; i < nnz_jac_d; i++ )
+         done = (nlp_->Eval_grad_f(*xpert[ieval], *grad_f[ieval]) && nlp_->Eval_jac_c(*xpert[ieval], *jac_c[ieval])
+                 && nlp_->Eval_jac_d(*xpert[ieval], *jac_d[ieval]));
+         if( !done )
          {
-            avrg_values[nnz_jac_c + i] = std::abs(val_buffer[i]);
+            Jnlst().Printf(J_WARNING, J_INITIALIZATION,
+                           "Error evaluating first derivatives as at perturbed point for equilibration-based scaling.\n");
+            num_eval_errors++;
+            xpert[ieval] = perturber->MakeNewPerturbedPoint();
          }
       }
-      else
+   }
+   delete[] success;
+
+   // Get the numbers out of the matrices and vectors, and add them
+   // to avrg_values
+   Number* avrg_values = new Number[nnz_jac_c + nnz_jac_d + nx];
+   Number* val_buffer = new Number[Max(nnz_jac_c, nnz_jac_d, nx)];
+   std::fill(avrg_values, avrg_values + nnz_jac_c + nnz_jac_d + nx, 0.);
+   for( Index ieval = 0; ieval < num_evals; ieval++ )
+   {
+      TripletHelper::FillValues(nnz_jac_c, *jac_c[ieval], val_buffer);
+      for( Index i = 0; i < nnz_jac_c; i++ )
       {
-         for( Index i = 0; i < nnz_jac_d; i++ )
-         {
-            avrg_values[nnz_jac_c + i] += std::abs(val_buffer[i]);
-         }
+         avrg_values[i] += std::abs(val_buffer[i]);
       }
-      TripletHelper::FillValuesFromVector(nx, *grad_f, val_buffer);
-      if( ieval == 0 )
+      TripletHelper::FillValues(nnz_jac_d, *jac_d[ieval], val_buffer);
+      for( Index i = 0; i < nnz_jac_d; i++ )
       {
-         for( Index i = 0; i < nx; i++ )
-         {
-            avrg_values[nnz_jac_c + nnz_jac_d + i] = std::abs(val_buffer[i]);
-         }
+         avrg_values[nnz_jac_c + i] += std::abs(val_buffer[i]);
       }
-      else
+      TripletHelper::FillValuesFromVector(nx, *grad_f[ieval], val_buffer);
+      for( Index i = 0; i < nx; i++ )
       {
-         for( Index i = 0; i < nx; i++ )
-         {
-            avrg_values[nnz_jac_c + nnz_jac_d + i] += std::abs(val_buffer[i]);
-         }
+         avrg_values[nnz_jac_c + nnz_jac_d + i] += std::abs(val_buffer[i]);
       }
    }
    delete[] val_buffer;
@@ -202,8 +216,8 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
    // Get the sparsity structure
    Index* AIRN = new Index[nnz_jac_c + nnz_jac_d + nx];
    Index* AJCN = new Index[nnz_jac_c + nnz_jac_d + nx];
-   TripletHelper::FillRowCol(nnz_jac_c, *jac_c, &AIRN[0], &AJCN[0]);
-   TripletHelper::FillRowCol(nnz_jac_d, *jac_d, &AIRN[nnz_jac_c], &AJCN[nnz_jac_c], nc);
+   TripletHelper::FillRowCol(nnz_jac_c, *jac_c[0], &AIRN[0], &AJCN[0]);
+   TripletHelper::FillRowCol(nnz_jac_d, *jac_d[0], &AIRN[nnz_jac_c], &AJCN[nnz_jac_c], nc);
 
    // sort out the zero entries in objective function gradient
    Index nnz_grad_f = 0;
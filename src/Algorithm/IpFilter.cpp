@@ -7,6 +7,8 @@
 #include "IpFilter.hpp"
 #include "IpJournalist.hpp"
 
+#include <algorithm>
+
 namespace Ipopt
 {
 
@@ -14,21 +16,6 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
-///////////////////////////////////////////////////////////////////////////
-//                            Filter entries                             //
-///////////////////////////////////////////////////////////////////////////
-
-FilterEntry::FilterEntry(
-   const std::vector<Number>& vals,
-   Index                      iter
-)
-   : vals_(vals),
-     iter_(iter)
-{ }
-
-FilterEntry::~FilterEntry()
-{ }
-
 ///////////////////////////////////////////////////////////////////////////
 //                                 Filter                                //
 ///////////////////////////////////////////////////////////////////////////
@@ -40,60 +27,188 @@ Filter::Filter(
 { }
 
 bool Filter::Acceptable(
-   std::vector<Number> vals
+   const std::vector<Number>& vals
 ) const
 {
    DBG_START_METH("FilterLineSearch::Filter::Acceptable", dbg_verbosity);
    DBG_ASSERT((Index)vals.size() == dim_);
-   bool acceptable = true;
-   std::list<FilterEntry*>::iterator iter;
-   for( iter = filter_list_.begin(); iter != filter_list_.end(); ++iter )
+   if( dim_ == 2 )
+   {
+      return Acceptable(vals[0], vals[1]);
+   }
+   return AcceptableToAllEntries(&vals[0]);
+}
+
+bool Filter::Acceptable(
+   Number val1,
+   Number val2
+) const
+{
+   DBG_ASSERT(dim_ == 2);
+   if( val1 != val1 || val2 != val2 )
    {
-      if( !(*iter)->Acceptable(vals) )
+      // the ordering cannot be used for NaN
+      Number vals[2] = { val1, val2 };
+      return AcceptableToAllEntries(vals);
+   }
+
+   // The pair is not acceptable if one entry is smaller in both
+   // coordinates. Of all entries with a smaller first coordinate, the
+   // last one has the smallest second coordinate.
+   Index pos = LowerBound(val1);
+   return pos == 0 || val2 <= vals_[2 * pos - 1];
+}
+
+bool Filter::AcceptableToAllEntries(
+   const Number* vals
+) const
+{
+   // ToDo decide if we need Compare_le
+   const Index nentries = NumEntries();
+   const Number* entry = vals_.empty() ? NULL : &vals_[0];
+   for( Index k = 0; k < nentries; k++, entry += dim_ )
+   {
+      bool acceptable = false;
+      for( Index i = 0; i < dim_; i++ )
       {
-         acceptable = false;
-         break;
+         if( vals[i] <= entry[i] )
+         {
+            acceptable = true;
+            break;
+         }
+      }
+      if( !acceptable )
+      {
+         return false;
       }
    }
-   return acceptable;
+   return true;
 }
 
 void Filter::AddEntry(
-   std::vector<Number> vals,
-   Index               iteration
+   const std::vector<Number>& vals,
+   Index                      iteration
 )
 {
    DBG_START_METH("FilterLineSearch::Filter::AddEntry", dbg_verbosity);
    DBG_ASSERT((Index)vals.size() == dim_);
-   std::list<FilterEntry*>::iterator iter;
-   iter = filter_list_.begin();
-   while( iter != filter_list_.end() )
+   if( dim_ == 2 )
+   {
+      AddEntry(vals[0], vals[1], iteration);
+      return;
+   }
+
+   // remove all entries that are dominated by the new one, and check
+   // whether the new one is dominated by a remaining entry
+   const Index nentries = NumEntries();
+   bool redundant = false;
+   Index nkeep = 0;
+   for( Index k = 0; k < nentries; k++ )
+   {
+      const Number* entry = &vals_[k * dim_];
+      bool dominated = true;
+      bool dominates = true;
+      for( Index i = 0; i < dim_; i++ )
+      {
+         if( vals[i] > entry[i] )
+         {
+            dominated = false;
+         }
+         if( vals[i] < entry[i] )
+         {
+            dominates = false;
+         }
+      }
+      if( dominated )
+      {
+         continue;
+      }
+      redundant = redundant || dominates;
+      if( nkeep < k )
+      {
+         std::copy(entry, entry + dim_, &vals_[nkeep * dim_]);
+         iters_[nkeep] = iters_[k];
+      }
+      nkeep++;
+   }
+   vals_.resize(nkeep * dim_);
+   iters_.resize(nkeep);
+
+   if( !redundant )
    {
-      if( (*iter)->Dominated(vals) )
+      vals_.insert(vals_.end(), vals.begin(), vals.end());
+      iters_.push_back(iteration);
+   }
+}
+
+void Filter::AddEntry(
+   Number val1,
+   Number val2,
+   Index  iteration
+)
+{
+   DBG_START_METH("FilterLineSearch::Filter::AddEntry", dbg_verbosity);
+   DBG_ASSERT(dim_ == 2);
+   DBG_ASSERT(val1 == val1 && val2 == val2);
+
+   // the entries that are dominated by the new one are those with
+   // both coordinates not smaller, which is a contiguous range
+   const Index nentries = NumEntries();
+   const Index first = LowerBound(val1);
+   Index last = first;
+   while( last < nentries && vals_[2 * last + 1] >= val2 )
+   {
+      last++;
+   }
+
+   if( first == last )
+   {
+      // the new entry is dominated by an entry with a smaller first
+      // coordinate, or an entry with equal first coordinate
+      if( (first > 0 && vals_[2 * first - 1] <= val2) ||
+          (first < nentries && vals_[2 * first] == val1) )
+      {
+         return;
+      }
+      vals_.insert(vals_.begin() + 2 * first, 2, 0.);
+      iters_.insert(iters_.begin() + first, 0);
+   }
+   else if( last > first + 1 )
+   {
+      vals_.erase(vals_.begin() + 2 * (first + 1), vals_.begin() + 2 * last);
+      iters_.erase(iters_.begin() + (first + 1), iters_.begin() + last);
+   }
+   vals_[2 * first] = val1;
+   vals_[2 * first + 1] = val2;
+   iters_[first] = iteration;
+}
+
+Index Filter::LowerBound(
+   Number val1
+) const
+{
+   Index lo = 0;
+   Index hi = NumEntries();
+   while( lo < hi )
+   {
+      Index mid = lo + (hi - lo) / 2;
+      if( vals_[2 * mid] < val1 )
       {
-         std::list<FilterEntry*>::iterator iter_to_remove = iter++;
-         FilterEntry* entry_to_remove = *iter_to_remove;
-         filter_list_.erase(iter_to_remove);
-         delete entry_to_remove;
+         lo = mid + 1;
       }
       else
       {
-         ++iter;
+         hi = mid;
       }
    }
-   FilterEntry* new_entry = new FilterEntry(vals, iteration);
-   filter_list_.push_back(new_entry);
+   return lo;
 }
 
 void Filter::Clear()
 {
    DBG_START_METH("FilterLineSearch::Filter::Clear", dbg_verbosity);
-   while( !filter_list_.empty() )
-   {
-      FilterEntry* entry = filter_list_.back();
-      filter_list_.pop_back();
-      delete entry;
-   }
+   vals_.clear();
+   iters_.clear();
 }
 
 void Filter::Print(
@@ -102,30 +217,28 @@ void Filter::Print(
 {
    DBG_START_METH("FilterLineSearch::Filter::Print", dbg_verbosity);
    jnlst.Printf(J_DETAILED, J_LINE_SEARCH,
-                "The current filter has %zd entries.\n", filter_list_.size());
+                "The current filter has %" IPOPT_INDEX_FORMAT " entries.\n", NumEntries());
    if( !jnlst.ProduceOutput(J_VECTOR, J_LINE_SEARCH) )
    {
       return;
    }
-   std::list<FilterEntry*>::iterator iter;
-   Index count = 0;
-   for( iter = filter_list_.begin(); iter != filter_list_.end(); ++iter )
+   const Index nentries = NumEntries();
+   for( Index k = 0; k < nentries; k++ )
    {
-      if( count % 10 == 0 )
+      if( k % 10 == 0 )
       {
          jnlst.Printf(J_VECTOR, J_LINE_SEARCH,
                       "                phi                    theta            iter\n");
       }
-      count++;
       jnlst.Printf(J_VECTOR, J_LINE_SEARCH,
-                   "%5" IPOPT_INDEX_FORMAT " ", count);
+                   "%5" IPOPT_INDEX_FORMAT " ", k + 1);
       for( Index i = 0; i < dim_; i++ )
       {
          jnlst.Printf(J_VECTOR, J_LINE_SEARCH,
-                      "%23.16e ", (*iter)->val(i));
+                      "%23.16e ", vals_[k * dim_ + i]);
       }
       jnlst.Printf(J_VECTOR, J_LINE_SEARCH,
-                   "%5" IPOPT_INDEX_FORMAT "\n", (*iter)->iter());
+                   "%5" IPOPT_INDEX_FORMAT "\n", iters_[k]);
    }
 }
 
@@ -9,127 +9,23 @@
 
 #include "IpJournalist.hpp"
 #include "IpDebug.hpp"
-#include <list>
 #include <vector>
 
 namespace Ipopt
 {
 
-/** Class for one filter entry. */
-class FilterEntry
-{
-public:
-   /**@name Constructors/Destructors */
-   ///@{
-   /** Constructor with the two components and the current iteration count */
-   FilterEntry(
-      const std::vector<Number>& vals,
-      Index                      iter
-   );
-
-   /** Destructor */
-   ~FilterEntry();
-   ///@}
-
-   /** Check acceptability of pair (phi,theta) with respect
-    *  to this filter entry.
-    *
-    *  @return true, if pair is acceptable
-    */
-   bool Acceptable(
-      std::vector<Number> vals
-   ) const
-   {
-      Index ncoor = (Index) vals_.size();
-      DBG_ASSERT((Index)vals.size() == ncoor);
-
-      // ToDo decide if we need Compare_le
-      bool retval = false;
-      for( Index i = 0; i < ncoor; i++ )
-      {
-         if( vals[i] <= vals_[i] )
-         {
-            retval = true;
-            break;
-         }
-      }
-
-      return retval;
-   }
-
-   /** Check if this entry is dominated by given coordinates.
-    *
-    *  @return true, if this entry is dominated
-    */
-   bool Dominated(
-      std::vector<Number> vals
-   ) const
-   {
-      Index ncoor = (Index) vals_.size();
-      DBG_ASSERT((Index)vals.size() == ncoor);
-
-      bool retval = true;
-      for( Index i = 0; i < ncoor; i++ )
-      {
-         if( vals[i] > vals_[i] )
-         {
-            retval = false;
-            break;
-         }
-      }
-
-      return retval;
-   }
-
-   /** @name Accessor functions */
-   ///@{
-   Number val(
-      Index i
-   ) const
-   {
-      return vals_[i];
-   }
-   Index iter() const
-   {
-      return iter_;
-   }
-   ///@}
-
-private:
-   /**@name Default Compiler Generated Methods
-    * (Hidden to avoid implicit creation/calling).
-    *
-    * These methods are not implemented and
-    * we do not want the compiler to implement
-    * them for us, so we declare them private
-    * and do not define them. This ensures that
-    * they will not be implicitly created/called.
-    */
-   ///@{
-   /** Default Constructor */
-   FilterEntry();
-   /** Copy Constructor */
-   FilterEntry(
-      const FilterEntry&
-   );
-
-   /** Default Assignment Operator */
-   void operator=(
-      const FilterEntry&
-   );
-   ///@}
-
-   /** values defining the coordinates of the entry */
-   std::vector<Number> vals_;
-   /** iteration number in which this entry was added to filter */
-   const Index iter_;
-};
-
 /** Class for the filter.
  *
  *  This class contains all filter entries.
  *  The entries are stored as the corner point, including the
  *  margin.
+ *
+ *  The coordinates of all entries are kept in one contiguous array.
+ *  For a 2-dimensional filter, the entries form a Pareto front
+ *  that is sorted by increasing first (and thus decreasing second)
+ *  coordinate, so that acceptability can be checked by a binary
+ *  search.  Entries that are dominated by another entry are not
+ *  stored, since they do not change the acceptability of a point.
  */
 class Filter
 {
@@ -142,10 +38,7 @@ public:
    );
    /** Destructor */
    ~Filter()
-   {
-      //ToDo figure out if that here is necessary
-      Clear();
-   }
+   { }
    ///@}
 
    /** Check acceptability of given coordinates with respect
@@ -154,7 +47,7 @@ public:
     *  @return true, if pair is acceptable
     */
    bool Acceptable(
-      std::vector<Number> vals
+      const std::vector<Number>& vals
    ) const;
 
    /** Add filter entry for given coordinates.
@@ -163,37 +56,29 @@ public:
     *  delete all dominated entries in the current filter.
     */
    void AddEntry(
-      std::vector<Number> vals,
-      Index               iteration
+      const std::vector<Number>& vals,
+      Index                      iteration
    );
 
-   /** @name Wrappers for 2-dimensional filter. */
+   /** @name Methods for 2-dimensional filter. */
    ///@{
    bool Acceptable(
       Number val1,
       Number val2
-   ) const
-   {
-      std::vector<Number> vals(2);
-      vals[0] = val1;
-      vals[1] = val2;
-
-      return Acceptable(vals);
-   }
+   ) const;
 
    void AddEntry(
       Number val1,
       Number val2,
       Index  iteration
-   )
-   {
-      std::vector<Number> vals(2);
-      vals[0] = val1;
-      vals[1] = val2;
+   );
+   ///@}
 
-      AddEntry(vals, iteration);
+   /** Number of entries in the filter */
+   Index NumEntries() const
+   {
+      return (Index) iters_.size();
    }
-   ///@}
 
    /** Delete all filter entries */
    void Clear();
@@ -230,8 +115,23 @@ private:
    /** Dimension of the filter (number of coordinates per entry) */
    Index dim_;
 
-   /** List storing the filter entries */
-   mutable std::list<FilterEntry*> filter_list_;
+   /** Check acceptability by comparing with every filter entry */
+   bool AcceptableToAllEntries(
+      const Number* vals
+   ) const;
+
+   /** Position of the first entry of a 2-dimensional filter whose
+    *  first coordinate is not smaller than val1.
+    */
+   Index LowerBound(
+      Number val1
+   ) const;
+
+   /** Coordinates of the filter entries, dim_ consecutive values per entry */
+   std::vector<Number> vals_;
+
+   /** Iteration numbers in which the filter entries were added */
+   std::vector<Index> iters_;
 };
 
 } // namespace Ipopt
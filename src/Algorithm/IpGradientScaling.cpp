@@ -48,10 +48,10 @@ void GradientScaling::RegisterOptions(
       "Minimum value of gradient-based scaling values.",
       0., false,
       1e-8,
-      "This is the lower bound for the scaling factors computed by gradient-based scaling method. "
+      "This is the lower bound for the scaling factors computed by gradient-based scaling method and for Ruiz scaling. "
       "If some derivatives of some functions are huge, the scaling factors will otherwise become very small, "
       "and the (unscaled) final constraint violation, for example, might then be significant. "
-      "Note: This option is only used if \"nlp_scaling_method\" is chosen as \"gradient-based\".");
+      "Note: This option is only used if \"nlp_scaling_method\" is chosen as \"gradient-based\" or \"ruiz\".");
 }
 
 bool GradientScaling::InitializeImpl(
@@ -44,6 +44,18 @@ public:
     */
    virtual void UpdateHessian() = 0;
 
+   /** Store the information that can be used to warm start a later
+    *  run of the algorithm in state.
+    *
+    *  The default implementation does not store anything.
+    *
+    *  @since 3.15.0
+    */
+   virtual void StoreSolverState(
+      SolverState& /*state*/
+   ) const
+   { }
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
@@ -344,6 +344,8 @@ SolverReturn IpoptAlgorithm::Optimize(
       // main loop
       while( conv_status == ConvergenceCheck::CONTINUE )
       {
+         IpData().TimingStats().SetTraceIteration(IpData().iter_count());
+
          // Set the Hessian Matrix
          IpData().TimingStats().UpdateHessian().Start();
          UpdateHessian();
@@ -409,6 +411,7 @@ SolverReturn IpoptAlgorithm::Optimize(
          IpData().TimingStats().CheckConvergence().End();
       }
 
+      IpData().TimingStats().SetTraceIteration(IpData().iter_count());
       IpData().TimingStats().OutputIteration().Start();
       OutputIteration();
       IpData().TimingStats().OutputIteration().End();
@@ -1047,6 +1050,45 @@ Number IpoptAlgorithm::correct_bound_multiplier(
    return Max(max_correction_up, max_correction_low);
 }
 
+void IpoptAlgorithm::StoreSolverState(
+   SolverState& state
+) const
+{
+   DBG_START_METH("IpoptAlgorithm::StoreSolverState", dbg_verbosity);
+   DBG_ASSERT(IsValid(IpData().curr()));
+
+   state.SetIterate(*IpData().curr());
+   state.SetBarrierParameter(IpData().curr_mu(), IpData().curr_tau());
+
+   // the scaling factors are obtained by scaling vectors of ones
+   SmartPtr<NLPScalingObject> scaling = IpNLP().NLP_scaling();
+   SmartPtr<const Vector> dx;
+   SmartPtr<const Vector> dc;
+   SmartPtr<const Vector> dd;
+   if( scaling->have_x_scaling() )
+   {
+      SmartPtr<Vector> ones = IpData().curr()->x()->MakeNew();
+      ones->Set(1.);
+      dx = scaling->apply_vector_scaling_x(ConstPtr(ones));
+   }
+   if( scaling->have_c_scaling() )
+   {
+      SmartPtr<Vector> ones = IpData().curr()->y_c()->MakeNew();
+      ones->Set(1.);
+      dc = scaling->apply_vector_scaling_c(ConstPtr(ones));
+   }
+   if( scaling->have_d_scaling() )
+   {
+      SmartPtr<Vector> ones = IpData().curr()->y_d()->MakeNew();
+      ones->Set(1.);
+      dd = scaling->apply_vector_scaling_d(ConstPtr(ones));
+   }
+   state.SetScaling(scaling->apply_obj_scaling(1.), GetRawPtr(dx), GetRawPtr(dc), GetRawPtr(dd));
+
+   search_dir_calculator_->StoreSolverState(state);
+   hessian_updater_->StoreSolverState(state);
+}
+
 void IpoptAlgorithm::print_copyright_message(
    const Journalist& jnlst
 )
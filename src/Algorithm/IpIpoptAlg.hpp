@@ -77,6 +77,17 @@ public:
       bool isResto = false
    );
 
+   /** Store the current state of the algorithm in state, so that it
+    *  can be used to warm start a later run.
+    *
+    *  Must only be called after Optimize.
+    *
+    *  @since 3.15.0
+    */
+   void StoreSolverState(
+      SolverState& state
+   ) const;
+
    /** Methods for IpoptType */
    ///@{
    static void RegisterOptions(
@@ -72,6 +72,8 @@ bool IpoptData::Initialize(
 #endif
 
    iter_count_ = 0;
+   inertia_correction_count_ = 0;
+   resto_factorization_count_ = 0;
    curr_mu_ = -1.;
    mu_initialized_ = false;
    curr_tau_ = -1.;
@@ -194,6 +196,28 @@ void IpoptData::SetTrialPrimalVariablesFromStep(
    set_trial(newvec);
 }
 
+void IpoptData::SetTrialPrimalVariables(
+   const Vector& x,
+   Number        alpha,
+   const Vector& delta_s
+)
+{
+   DBG_ASSERT(have_prototypes_);
+
+   if( IsNull(trial_) )
+   {
+      trial_ = iterates_space_->MakeNewIteratesVector(false);
+   }
+
+   SmartPtr<IteratesVector> newvec = trial_->MakeNewContainer();
+   newvec->Set_x(x);
+
+   newvec->create_new_s();
+   newvec->s_NonConst()->AddTwoVectors(1., *curr_->s(), alpha, delta_s, 0.);
+
+   set_trial(newvec);
+}
+
 void IpoptData::SetTrialEqMultipliersFromStep(
    Number        alpha,
    const Vector& delta_y_c,
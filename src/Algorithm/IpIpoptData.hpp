@@ -12,6 +12,7 @@
 #include "IpIteratesVector.hpp"
 #include "IpRegOptions.hpp"
 #include "IpTimingStatistics.hpp"
+#include "IpSolverState.hpp"
 
 namespace Ipopt
 {
@@ -173,6 +174,19 @@ public:
       const Vector& delta_x,
       const Vector& delta_s
    );
+   /** Set the values of the primal trial variables from a given x and
+    *  the slacks from provided step with step length alpha.
+    *
+    *  This is useful if the trial x has been computed before, e.g., to
+    *  evaluate the NLP functions at it in advance.
+    *
+    *  @since 3.15.0
+    */
+   void SetTrialPrimalVariables(
+      const Vector& x,
+      Number        alpha,
+      const Vector& delta_s
+   );
    /** Set the values of the trial values for the equality constraint
     *  multipliers (y_c and y_d) from provided step with step length
     *  alpha.
@@ -353,6 +367,41 @@ public:
       iter_count_ = iter_count;
    }
 
+   /** Number of perturbations of the primal-dual system for wrong inertia so far
+    *
+    *  @since 3.15.0
+    */
+   Index inertia_correction_count() const
+   {
+      return inertia_correction_count_;
+   }
+   /** @since 3.15.0 */
+   void Set_inertia_correction_count(
+      Index inertia_correction_count
+   )
+   {
+      inertia_correction_count_ = inertia_correction_count;
+   }
+
+   /** Number of factorizations of the primal-dual system in restoration phases so far
+    *
+    *  The factorizations of the regular iterations are counted by
+    *  the LinearSystemFactorization task of the timing statistics.
+    *
+    *  @since 3.15.0
+    */
+   Index resto_factorization_count() const
+   {
+      return resto_factorization_count_;
+   }
+   /** @since 3.15.0 */
+   void Set_resto_factorization_count(
+      Index resto_factorization_count
+   )
+   {
+      resto_factorization_count_ = resto_factorization_count;
+   }
+
    Number curr_mu() const
    {
       DBG_ASSERT(mu_initialized_);
@@ -639,6 +688,32 @@ public:
       pd_pert_d = pd_pert_d_;
    }
 
+   /** Set the snapshot of a previous run that is used to warm start
+    *  the algorithm, NULL for none.
+    *
+    *  The snapshot is kept when the IpoptData object is initialized.
+    *  The iterate initializer resets it to NULL if the iterate of the
+    *  snapshot does not fit to the problem or its scaling, so that the
+    *  other parts of the snapshot are not used either.
+    *
+    *  @since 3.15.0
+    */
+   void SetWarmStartState(
+      const SmartPtr<const SolverState>& state
+   )
+   {
+      warm_start_state_ = state;
+   }
+
+   /** Get the snapshot that is used to warm start the algorithm, NULL if none
+    *
+    *  @since 3.15.0
+    */
+   SmartPtr<const SolverState> WarmStartState() const
+   {
+      return warm_start_state_;
+   }
+
    static void RegisterOptions(
       const SmartPtr<RegisteredOptions>& roptions
    );
@@ -691,6 +766,12 @@ private:
    /** iteration count */
    Index iter_count_;
 
+   /** number of perturbations for wrong inertia */
+   Index inertia_correction_count_;
+
+   /** number of factorizations in restoration phases */
+   Index resto_factorization_count_;
+
    /** current barrier parameter */
    Number curr_mu_;
    bool mu_initialized_;
@@ -772,6 +853,9 @@ private:
    Number pd_pert_d_;
    ///@}
 
+   /** Snapshot of a previous run for warm starting, NULL if none */
+   SmartPtr<const SolverState> warm_start_state_;
+
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
     *
@@ -11,6 +11,8 @@
 #include "IpJournalist.hpp"
 #include "IpNLPScaling.hpp"
 
+#include <vector>
+
 namespace Ipopt
 {
 // forward declarations
@@ -135,6 +137,21 @@ public:
       const Vector& yd
    ) = 0;
 
+   /** Evaluates objective and constraints at several points ahead of time.
+    *
+    *  This is a hint that f, c, and d are going to be requested for
+    *  some of the given points, e.g., the trial points of a backtracking
+    *  line search.  An implementation may evaluate them at once (possibly
+    *  in parallel) and serve the subsequent calls to f, c, and d for these
+    *  points from the results.  The default implementation does nothing.
+    *
+    *  @since 3.15.0
+    */
+   virtual void PrecomputeEvaluations(
+      const std::vector<SmartPtr<const Vector> >& /*x*/
+   )
+   { }
+
    /** Lower bounds on x */
    virtual SmartPtr<const Vector> x_L() const = 0;
 
@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace Ipopt
 {
@@ -225,7 +226,8 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
    // set W to be the identity matrix.
    if( IsNull(last_x_) || lm_skipped_iter_ >= limited_memory_max_skipping_ )
    {
-      if( IsNull(last_x_) )
+      const bool first_call = IsNull(last_x_);
+      if( first_call )
       {
          DBG_ASSERT(IsNull(last_grad_f_));
          DBG_ASSERT(IsNull(last_jac_c_));
@@ -269,6 +271,16 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
          // Set up W to be multiple of I
          sigma_ = limited_memory_init_val_;
       }
+
+      // At the start of the optimization, continue with the pairs of a previous run, if available
+      SmartPtr<const SolverState> state = IpData().WarmStartState();
+      if( first_call && !update_for_resto_ && IsValid(state) && state->NumQuasiNewtonPairs() > 0
+          && RestoreBFGSPairs(*state, *LM_vecspace) )
+      {
+         Jnlst().Printf(J_DETAILED, J_HESSIAN_APPROXIMATION,
+                        "Limited-Memory approximation initialized with %" IPOPT_INDEX_FORMAT " pairs of previous run.\n",
+                        curr_lm_memory_);
+      }
       SetW();
       return;
    }
@@ -450,74 +462,10 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
                ShiftMultiVector(V_, *v_new);
             }
 
-            // Compute Ltilde = L * diag(D^{-1/2});
-            SmartPtr<DenseVector> Dtilde = D_->MakeNewDenseVector();
-            Dtilde->Copy(*D_);
-            Dtilde->ElementWiseSqrt();
-            Dtilde->ElementWiseReciprocal();
-            SmartPtr<DenseGenMatrix> Ltilde = L_->MakeNewDenseGenMatrix();
-            DBG_PRINT_MATRIX(3, "D", *D_);
-            DBG_PRINT_MATRIX(3, "L", *L_);
-            Ltilde->Copy(*L_);
-            Ltilde->ScaleColumns(*Dtilde);
-            DBG_PRINT_MATRIX(3, "Ltilde", *Ltilde);
-
-            // M = Ltilde * Ltilde^T
-            SmartPtr<DenseSymMatrixSpace> Mspace = new DenseSymMatrixSpace(curr_lm_memory_);
-            SmartPtr<DenseSymMatrix> M = Mspace->MakeNewDenseSymMatrix();
-            M->HighRankUpdate(false, 1., *Ltilde, 0.);
-
-            // M += S^T B_0 S
-            if( !update_for_resto_ || !limited_memory_special_for_resto_ )
-            {
-               // For now, we assume that B_0 is sigma*I
-               DBG_ASSERT(SdotS_uptodate_);
-               DBG_PRINT_MATRIX(3, "SdotS", *SdotS_);
-               M->AddMatrix(sigma_, *SdotS_, 1.);
-            }
-            else
+            if( !ComputeBFGSLowRankFactor() )
             {
-               DBG_PRINT_MATRIX(3, "STDRS", *STDRS_);
-               M->AddMatrix(curr_eta_, *STDRS_, 1.);
-            }
-
-            // Compute Cholesky factor J with M = J J^T
-            DBG_PRINT_MATRIX(3, "M", *M);
-            SmartPtr<DenseGenMatrix> J = L_->MakeNewDenseGenMatrix();
-            bool cholesky_retval = J->ComputeCholeskyFactor(*M);
-            DBG_PRINT_MATRIX(3, "J", *J);
-            if( !cholesky_retval )
-            {
-               Jnlst().Printf(J_WARNING, J_HESSIAN_APPROXIMATION,
-                              "Cholesky factorization failed for LBFGS update! Skipping update.\n");
                skipping = true;
-               break;
-            }
-
-            // Compute C = J^{-T}
-            SmartPtr<DenseGenMatrix> C = J->MakeNewDenseGenMatrix();
-            C->FillIdentity();
-            J->CholeskyBackSolveMatrix(true, 1., *C);
-
-            // Compute U = B_0 * S * C
-            U_ = S_->MakeNewMultiVectorMatrix();
-            if( !update_for_resto_ || !limited_memory_special_for_resto_ )
-            {
-               DBG_ASSERT(sigma_ > 0.);
-               U_->AddRightMultMatrix(sigma_, *S_, *C, 0.);
-            }
-            else
-            {
-               DBG_ASSERT(sigma_ < 0.);
-               U_->AddRightMultMatrix(curr_eta_, *DRS_, *C, 0.);
             }
-
-            // Compute Lbar = Ltilde^T * C
-            SmartPtr<DenseGenMatrix> Lbar = Ltilde->MakeNewDenseGenMatrix();
-            Lbar->AddMatrixProduct(1., *Ltilde, true, *C, false, 0.);
-
-            // Compute U += V * Lbar;
-            U_->AddRightMultMatrix(1., *V_, *Lbar, 1.);
             break;
          }
          case SR1:
@@ -709,6 +657,170 @@ void LimMemQuasiNewtonUpdater::UpdateHessian()
    }
 }
 
+bool LimMemQuasiNewtonUpdater::ComputeBFGSLowRankFactor()
+{
+   DBG_START_METH("LimMemQuasiNewtonUpdater::ComputeBFGSLowRankFactor",
+                  dbg_verbosity);
+
+   // Compute Ltilde = L * diag(D^{-1/2});
+   SmartPtr<DenseVector> Dtilde = D_->MakeNewDenseVector();
+   Dtilde->Copy(*D_);
+   Dtilde->ElementWiseSqrt();
+   Dtilde->ElementWiseReciprocal();
+   SmartPtr<DenseGenMatrix> Ltilde = L_->MakeNewDenseGenMatrix();
+   DBG_PRINT_MATRIX(3, "D", *D_);
+   DBG_PRINT_MATRIX(3, "L", *L_);
+   Ltilde->Copy(*L_);
+   Ltilde->ScaleColumns(*Dtilde);
+   DBG_PRINT_MATRIX(3, "Ltilde", *Ltilde);
+
+   // M = Ltilde * Ltilde^T
+   SmartPtr<DenseSymMatrixSpace> Mspace = new DenseSymMatrixSpace(curr_lm_memory_);
+   SmartPtr<DenseSymMatrix> M = Mspace->MakeNewDenseSymMatrix();
+   M->HighRankUpdate(false, 1., *Ltilde, 0.);
+
+   // M += S^T B_0 S
+   if( !update_for_resto_ || !limited_memory_special_for_resto_ )
+   {
+      // For now, we assume that B_0 is sigma*I
+      DBG_ASSERT(SdotS_uptodate_);
+      DBG_PRINT_MATRIX(3, "SdotS", *SdotS_);
+      M->AddMatrix(sigma_, *SdotS_, 1.);
+   }
+   else
+   {
+      DBG_PRINT_MATRIX(3, "STDRS", *STDRS_);
+      M->AddMatrix(curr_eta_, *STDRS_, 1.);
+   }
+
+   // Compute Cholesky factor J with M = J J^T
+   DBG_PRINT_MATRIX(3, "M", *M);
+   SmartPtr<DenseGenMatrix> J = L_->MakeNewDenseGenMatrix();
+   bool cholesky_retval = J->ComputeCholeskyFactor(*M);
+   DBG_PRINT_MATRIX(3, "J", *J);
+   if( !cholesky_retval )
+   {
+      Jnlst().Printf(J_WARNING, J_HESSIAN_APPROXIMATION,
+                     "Cholesky factorization failed for LBFGS update! Skipping update.\n");
+      return false;
+   }
+
+   // Compute C = J^{-T}
+   SmartPtr<DenseGenMatrix> C = J->MakeNewDenseGenMatrix();
+   C->FillIdentity();
+   J->CholeskyBackSolveMatrix(true, 1., *C);
+
+   // Compute U = B_0 * S * C
+   U_ = S_->MakeNewMultiVectorMatrix();
+   if( !update_for_resto_ || !limited_memory_special_for_resto_ )
+   {
+      DBG_ASSERT(sigma_ > 0.);
+      U_->AddRightMultMatrix(sigma_, *S_, *C, 0.);
+   }
+   else
+   {
+      DBG_ASSERT(sigma_ < 0.);
+      U_->AddRightMultMatrix(curr_eta_, *DRS_, *C, 0.);
+   }
+
+   // Compute Lbar = Ltilde^T * C
+   SmartPtr<DenseGenMatrix> Lbar = Ltilde->MakeNewDenseGenMatrix();
+   Lbar->AddMatrixProduct(1., *Ltilde, true, *C, false, 0.);
+
+   // Compute U += V * Lbar;
+   U_->AddRightMultMatrix(1., *V_, *Lbar, 1.);
+
+   return true;
+}
+
+void LimMemQuasiNewtonUpdater::StoreSolverState(
+   SolverState& state
+) const
+{
+   if( update_for_resto_ || limited_memory_update_type_ != BFGS || curr_lm_memory_ == 0 )
+   {
+      return;
+   }
+   DBG_ASSERT(S_->NCols() == curr_lm_memory_ && Y_->NCols() == curr_lm_memory_);
+
+   std::vector<const Vector*> s(curr_lm_memory_);
+   std::vector<const Vector*> y(curr_lm_memory_);
+   for( Index i = 0; i < curr_lm_memory_; i++ )
+   {
+      s[i] = GetRawPtr(S_->GetVector(i));
+      y[i] = GetRawPtr(Y_->GetVector(i));
+   }
+   state.SetQuasiNewtonPairs(sigma_, curr_lm_memory_, &s[0], &y[0]);
+}
+
+bool LimMemQuasiNewtonUpdater::RestoreBFGSPairs(
+   const SolverState& state,
+   const VectorSpace& LM_vecspace
+)
+{
+   DBG_START_METH("LimMemQuasiNewtonUpdater::RestoreBFGSPairs",
+                  dbg_verbosity);
+   DBG_ASSERT(!update_for_resto_);
+   DBG_ASSERT(curr_lm_memory_ == 0);
+
+   if( limited_memory_update_type_ != BFGS || limited_memory_max_history_ == 0
+       || state.QuasiNewtonDim() != LM_vecspace.Dim() )
+   {
+      return false;
+   }
+
+   // use only the most recent pairs if the history is now shorter
+   const Index npairs = state.NumQuasiNewtonPairs();
+   bool ok = true;
+   for( Index k = Max(Index(0), npairs - limited_memory_max_history_); ok && k < npairs; k++ )
+   {
+      SmartPtr<Vector> s_new = LM_vecspace.MakeNew();
+      SmartPtr<Vector> y_new = LM_vecspace.MakeNew();
+      state.GetQuasiNewtonPair(k, *s_new, *y_new);
+      Number sTy_new = s_new->Dot(*y_new);
+      if( !(sTy_new > 0.) )
+      {
+         ok = false;
+         break;
+      }
+
+      bool augment_memory = UpdateInternalData(*s_new, *y_new, NULL);
+
+      SmartPtr<Vector> v_new = y_new->MakeNewCopy();
+      v_new->Scal(1. / std::sqrt(sTy_new));
+      if( augment_memory )
+      {
+         AugmentMultiVector(V_, *v_new);
+      }
+      else
+      {
+         ShiftMultiVector(V_, *v_new);
+      }
+   }
+
+   if( ok )
+   {
+      sigma_ = Max(Min(sigma_safe_max_, state.QuasiNewtonSigma()), sigma_safe_min_);
+      ok = ComputeBFGSLowRankFactor();
+   }
+
+   if( !ok )
+   {
+      curr_lm_memory_ = 0;
+      S_ = NULL;
+      Y_ = NULL;
+      D_ = NULL;
+      L_ = NULL;
+      V_ = NULL;
+      U_ = NULL;
+      SdotS_ = NULL;
+      SdotS_uptodate_ = false;
+      sigma_ = limited_memory_init_val_;
+   }
+
+   return ok;
+}
+
 void LimMemQuasiNewtonUpdater::StoreInternalDataBackup()
 {
    DBG_START_METH("LimMemQuasiNewtonUpdater::StoreInternalDataBackup",
@@ -1418,16 +1530,22 @@ void LimMemQuasiNewtonUpdater::RecalcL(
    SmartPtr<DenseGenMatrixSpace> space = new DenseGenMatrixSpace(dim, dim);
    L = space->MakeNewDenseGenMatrix();
    Number* Lvalues = L->Values();
+   // for dense columns, all products S^T Y are computed at once by Level 3 BLAS
+   // and only the strictly lower triangle is kept; otherwise only the products
+   // in the strictly lower triangle are computed as dot products
+   bool all_products = S.TransMultMultiVector(1., Y, 0., Lvalues, dim);
    for( Index j = 0; j < dim; j++ )
    {
       for( Index i = 0; i <= j; i++ )
       {
          Lvalues[i + j * dim] = 0.;
       }
-      for( Index i = j + 1; i < dim; i++ )
+      if( !all_products )
       {
-         Lvalues[i + j * dim] = S.GetVector(i)->Dot(*Y.GetVector(j));
-         ;
+         for( Index i = j + 1; i < dim; i++ )
+         {
+            Lvalues[i + j * dim] = S.GetVector(i)->Dot(*Y.GetVector(j));
+         }
       }
    }
 }
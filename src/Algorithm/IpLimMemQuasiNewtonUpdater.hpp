@@ -43,6 +43,14 @@ public:
    /** Update the Hessian based on the current information in IpData. */
    virtual void UpdateHessian();
 
+   /** Store the pairs of the limited-memory BFGS update in state.
+    *
+    *  Nothing is stored for the restoration phase or for SR1 updates.
+    */
+   virtual void StoreSolverState(
+      SolverState& state
+   ) const;
+
    /** Methods for OptionsList */
    ///@{
    static void RegisterOptions(
@@ -324,6 +332,22 @@ private:
       SmartPtr<Vector> ypart_new
    );
 
+   /** Compute the matrix U of the compact representation of the BFGS
+    *  update from the current internal data (S, D, L, V, etc).
+    *
+    *  @return false, if the Cholesky factorization failed and the update should be skipped
+    */
+   bool ComputeBFGSLowRankFactor();
+
+   /** Initialize the internal data from the BFGS pairs of a previous run.
+    *
+    *  @return false, if the pairs could not be used; the internal data is empty then
+    */
+   bool RestoreBFGSPairs(
+      const SolverState& state,
+      const VectorSpace& LM_vecspace
+   );
+
    /** Given a MutliVector V, create a new MultiVectorSpace with one
     *  more column, and return V as a member of that space,
     *  consisting of all previous vectors, and in addition v_new in
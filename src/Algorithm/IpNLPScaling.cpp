@@ -270,10 +270,35 @@ void StandardScalingBase::DetermineScaling(
 {
    SmartPtr<Vector> dc;
    SmartPtr<Vector> dd;
-   DetermineScalingParametersImpl(x_space, c_space, d_space, jac_c_space, jac_d_space, h_space, Px_L, x_L, Px_U, x_U,
-                                  df_, dx_, dc, dd);
+   if( IsValid(warm_start_state_) && warm_start_state_->ScalingMatches(x_space->Dim(), c_space->Dim(), d_space->Dim()) )
+   {
+      // reuse the scaling factors of a previous run; they already include obj_scaling_factor
+      Jnlst().Printf(J_DETAILED, J_MAIN,
+                     "Using scaling factors of previous run.\n");
+      df_ = warm_start_state_->ObjScaling();
+      dx_ = x_space->MakeNew();
+      if( !warm_start_state_->GetXScaling(*dx_) )
+      {
+         dx_ = NULL;
+      }
+      dc = c_space->MakeNew();
+      if( !warm_start_state_->GetCScaling(*dc) )
+      {
+         dc = NULL;
+      }
+      dd = d_space->MakeNew();
+      if( !warm_start_state_->GetDScaling(*dd) )
+      {
+         dd = NULL;
+      }
+   }
+   else
+   {
+      DetermineScalingParametersImpl(x_space, c_space, d_space, jac_c_space, jac_d_space, h_space, Px_L, x_L, Px_U, x_U,
+                                     df_, dx_, dc, dd);
 
-   df_ *= obj_scaling_factor_;
+      df_ *= obj_scaling_factor_;
+   }
 
    if( Jnlst().ProduceOutput(J_DETAILED, J_MAIN) )
    {
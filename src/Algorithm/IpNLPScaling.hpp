@@ -9,6 +9,7 @@
 
 #include "IpOptionsList.hpp"
 #include "IpRegOptions.hpp"
+#include "IpSolverState.hpp"
 
 namespace Ipopt
 {
@@ -434,6 +435,21 @@ public:
       const Vector&                        x_U
    );
 
+   /** Set a snapshot of a previous run whose scaling factors are used
+    *  instead of computing new ones, NULL for none.
+    *
+    *  The scaling factors of the snapshot are only used if they fit to
+    *  the dimensions of the problem.
+    *
+    *  @since 3.15.0
+    */
+   void SetWarmStartState(
+      const SmartPtr<const SolverState>& state
+   )
+   {
+      warm_start_state_ = state;
+   }
+
    static void RegisterOptions(
       SmartPtr<RegisteredOptions> roptions
    );
@@ -502,6 +518,9 @@ private:
    SmartPtr<Vector> dx_;
    ///@}
 
+   /** Snapshot of a previous run with scaling factors to be reused, NULL if none */
+   SmartPtr<const SolverState> warm_start_state_;
+
    /** Scaled Matrix Spaces */
    ///@{
    /** Scaled Jacobian of c space */
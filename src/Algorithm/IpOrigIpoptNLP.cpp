@@ -37,6 +37,9 @@ OrigIpoptNLP::OrigIpoptNLP(
      jac_d_cache_(1),
      h_cache_(1),
      unscaled_x_cache_(1),
+     prefetched_f_cache_(-1),
+     prefetched_c_cache_(-1),
+     prefetched_d_cache_(-1),
      initialized_(false),
      timing_statistics_(timing_statistics)
 {
@@ -176,6 +179,10 @@ bool OrigIpoptNLP::Initialize(
       }
    }
 
+   prefetched_f_cache_.Clear();
+   prefetched_c_cache_.Clear();
+   prefetched_d_cache_.Clear();
+
    // Reset the cache entries belonging to a dummy dependency.  This
    // is required for repeated solve, since the cache is not updated
    // if a dimension is zero.  It is also required if we choose
@@ -475,7 +482,7 @@ Number OrigIpoptNLP::f(
    DBG_START_METH("OrigIpoptNLP::f", dbg_verbosity);
    Number ret = 0.0;
    DBG_PRINT((2, "x.Tag = %u\n", x.GetTag()));
-   if( !f_cache_.GetCachedResult1Dep(ret, &x) )
+   if( !f_cache_.GetCachedResult1Dep(ret, &x) && !prefetched_f_cache_.GetCachedResult1Dep(ret, &x) )
    {
       f_evals_++;
       SmartPtr<const Vector> unscaled_x = get_unscaled_x(x);
@@ -552,7 +559,7 @@ SmartPtr<const Vector> OrigIpoptNLP::c(
    }
    else
    {
-      if( !c_cache_.GetCachedResult1Dep(retValue, x) )
+      if( !c_cache_.GetCachedResult1Dep(retValue, x) && !prefetched_c_cache_.GetCachedResult1Dep(retValue, x) )
       {
          SmartPtr<Vector> unscaled_c = c_space_->MakeNew();
          c_evals_++;
@@ -598,7 +605,7 @@ SmartPtr<const Vector> OrigIpoptNLP::d(
    }
    else
    {
-      if( !d_cache_.GetCachedResult1Dep(retValue, x) )
+      if( !d_cache_.GetCachedResult1Dep(retValue, x) && !prefetched_d_cache_.GetCachedResult1Dep(retValue, x) )
       {
          d_evals_++;
          SmartPtr<Vector> unscaled_d = d_space_->MakeNew();
@@ -627,6 +634,79 @@ SmartPtr<const Vector> OrigIpoptNLP::d(
    return retValue;
 }
 
+void OrigIpoptNLP::PrecomputeEvaluations(
+   const std::vector<SmartPtr<const Vector> >& x
+)
+{
+   DBG_START_METH("OrigIpoptNLP::PrecomputeEvaluations", dbg_verbosity);
+   prefetched_f_cache_.Clear();
+   prefetched_c_cache_.Clear();
+   prefetched_d_cache_.Clear();
+
+   Index npoints = (Index) x.size();
+   if( npoints < 2 )
+   {
+      // nothing to gain from evaluating a single point in advance
+      return;
+   }
+
+   std::vector<SmartPtr<const Vector> > unscaled_x(npoints);
+   std::vector<SmartPtr<Vector> > unscaled_c(npoints);
+   std::vector<SmartPtr<Vector> > unscaled_d(npoints);
+   const Vector** unscaled_x_ptr = new const Vector*[npoints];
+   Vector** unscaled_c_ptr = new Vector*[npoints];
+   Vector** unscaled_d_ptr = new Vector*[npoints];
+   Number* f = new Number[npoints];
+   bool* success = new bool[npoints];
+   for( Index k = 0; k < npoints; k++ )
+   {
+      unscaled_x[k] = NLP_scaling()->unapply_vector_scaling_x(x[k]);
+      unscaled_c[k] = c_space_->MakeNew();
+      unscaled_d[k] = d_space_->MakeNew();
+      unscaled_x_ptr[k] = GetRawPtr(unscaled_x[k]);
+      unscaled_c_ptr[k] = GetRawPtr(unscaled_c[k]);
+      unscaled_d_ptr[k] = GetRawPtr(unscaled_d[k]);
+   }
+
+   // the evaluation of objective and constraints is done together, so account it as objective evaluation time
+   timing_statistics_.f_eval_time().Start();
+   bool evaluated = nlp_->Eval_f_c_d_AtPoints(npoints, unscaled_x_ptr, f, unscaled_c_ptr, unscaled_d_ptr, success);
+   timing_statistics_.f_eval_time().End();
+
+   if( evaluated )
+   {
+      f_evals_ += npoints;
+      c_evals_ += npoints;
+      d_evals_ += npoints;
+      for( Index k = 0; k < npoints; k++ )
+      {
+         if( !success[k] || !IsFiniteNumber(f[k]) || !IsFiniteNumber(unscaled_c[k]->Nrm2())
+             || !IsFiniteNumber(unscaled_d[k]->Nrm2()) )
+         {
+            // leave it to f, c, and d to deal with the evaluation error, should this point be requested
+            continue;
+         }
+         prefetched_f_cache_.AddCachedResult1Dep(NLP_scaling()->apply_obj_scaling(f[k]), GetRawPtr(x[k]));
+         if( c_space_->Dim() > 0 )
+         {
+            prefetched_c_cache_.AddCachedResult1Dep(NLP_scaling()->apply_vector_scaling_c(ConstPtr(unscaled_c[k])),
+                                                    GetRawPtr(x[k]));
+         }
+         if( d_space_->Dim() > 0 )
+         {
+            prefetched_d_cache_.AddCachedResult1Dep(NLP_scaling()->apply_vector_scaling_d(ConstPtr(unscaled_d[k])),
+                                                    GetRawPtr(x[k]));
+         }
+      }
+   }
+
+   delete[] unscaled_x_ptr;
+   delete[] unscaled_c_ptr;
+   delete[] unscaled_d_ptr;
+   delete[] f;
+   delete[] success;
+}
+
 SmartPtr<const Matrix> OrigIpoptNLP::jac_c(
    const Vector& x
 )
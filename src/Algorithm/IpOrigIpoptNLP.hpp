@@ -185,6 +185,17 @@ public:
     */
    virtual SmartPtr<const SymMatrix> uninitialized_h();
 
+   /** Evaluates objective and constraints at several points ahead of time.
+    *
+    *  Passes the points to NLP::Eval_f_c_d_AtPoints.  If the NLP supports
+    *  this, the results for all points with successful evaluations are
+    *  stored until the next call of this method and returned by f, c,
+    *  and d.
+    */
+   virtual void PrecomputeEvaluations(
+      const std::vector<SmartPtr<const Vector> >& x
+   );
+
    /** Lower bounds on x */
    virtual SmartPtr<const Vector> x_L() const
    {
@@ -430,6 +441,15 @@ private:
    /** Unscaled version of x vector */
    CachedResults<SmartPtr<const Vector> > unscaled_x_cache_;
 
+   /** Objective function values from the last PrecomputeEvaluations */
+   CachedResults<Number> prefetched_f_cache_;
+
+   /** Equality constraint residuals from the last PrecomputeEvaluations */
+   CachedResults<SmartPtr<const Vector> > prefetched_c_cache_;
+
+   /** Inequality constraint residuals from the last PrecomputeEvaluations */
+   CachedResults<SmartPtr<const Vector> > prefetched_d_cache_;
+
    /** Lower bounds on x */
    SmartPtr<const Vector> x_L_;
 
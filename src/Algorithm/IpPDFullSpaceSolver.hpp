@@ -61,6 +61,13 @@ public:
       bool                  improve_solution = false
    );
 
+   virtual void StoreSolverState(
+      SolverState& state
+   ) const
+   {
+      perturbHandler_->StoreSolverState(state);
+   }
+
    /** Methods for IpoptType */
    ///@{
    static void RegisterOptions(
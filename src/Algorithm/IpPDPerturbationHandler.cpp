@@ -136,6 +136,10 @@ bool PDPerturbationHandler::InitializeImpl(
    delta_c_last_ = 0.;
    delta_d_last_ = 0.;
 
+   // the perturbations of a previous run are taken at the first system,
+   // when it is known whether the iterate of the previous run is used
+   first_system_ = true;
+
    test_status_ = NO_TEST;
 
    return true;
@@ -150,6 +154,17 @@ bool PDPerturbationHandler::ConsiderNewSystem(
 {
    DBG_START_METH("PDPerturbationHandler::ConsiderNewSystem", dbg_verbosity);
 
+   if( first_system_ )
+   {
+      // continue from the perturbations of a previous run, if available
+      first_system_ = false;
+      SmartPtr<const SolverState> state = IpData().WarmStartState();
+      if( IsValid(state) && state->HasPerturbations() )
+      {
+         state->GetPerturbations(delta_x_last_, delta_s_last_, delta_c_last_, delta_d_last_);
+      }
+   }
+
    // Check if we can conclude that some components of the system are
    // structurally degenerate
    finalize_test();
@@ -244,6 +259,24 @@ bool PDPerturbationHandler::ConsiderNewSystem(
    return true;
 }
 
+void PDPerturbationHandler::StoreSolverState(
+   SolverState& state
+) const
+{
+   // store what ConsiderNewSystem would use as last perturbation for the next system
+   if( reset_last_ )
+   {
+      state.SetPerturbations(delta_x_curr_, delta_s_curr_, delta_c_curr_, delta_d_curr_);
+   }
+   else
+   {
+      state.SetPerturbations(delta_x_curr_ > 0. ? delta_x_curr_ : delta_x_last_,
+                             delta_s_curr_ > 0. ? delta_s_curr_ : delta_s_last_,
+                             delta_c_curr_ > 0. ? delta_c_curr_ : delta_c_last_,
+                             delta_d_curr_ > 0. ? delta_d_curr_ : delta_d_last_);
+   }
+}
+
 bool PDPerturbationHandler::PerturbForSingularity(
    Number& delta_x,
    Number& delta_s,
@@ -433,6 +466,8 @@ bool PDPerturbationHandler::PerturbForWrongInertia(
    // perturbation for a test did not result in a singular system)
    finalize_test();
 
+   IpData().Set_inertia_correction_count(IpData().inertia_correction_count() + 1);
+
    bool retval = get_deltas_for_wrong_inertia(delta_x, delta_s, delta_c, delta_d);
    if( !retval && delta_c == 0. )
    {
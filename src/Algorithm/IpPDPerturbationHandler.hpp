@@ -89,6 +89,15 @@ public:
       Number& delta_d
    );
 
+   /** Store the perturbations that are used as reference for the next
+    *  system in state.
+    *
+    *  @since 3.15.0
+    */
+   virtual void StoreSolverState(
+      SolverState& state
+   ) const;
+
    static void RegisterOptions(
       SmartPtr<RegisteredOptions> roptions
    );
@@ -146,6 +155,9 @@ protected:
     */
    bool get_deltas_for_wrong_inertia_called_;
 
+   /** Flag indicating that no system has been considered since the initialization. */
+   bool first_system_;
+
    /** @name Handling structural degeneracy */
    ///@{
    /** Type for degeneracy flags */
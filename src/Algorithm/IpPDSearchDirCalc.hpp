@@ -42,6 +42,13 @@ public:
     */
    virtual bool ComputeSearchDirection();
 
+   virtual void StoreSolverState(
+      SolverState& state
+   ) const
+   {
+      pd_solver_->StoreSolverState(state);
+   }
+
    static void RegisterOptions(
       const SmartPtr<RegisteredOptions>& roptions
    );
@@ -114,6 +114,18 @@ public:
       bool                  improve_solution = false
    ) = 0;
 
+   /** Store the information that can be used to warm start a later
+    *  run of the algorithm in state.
+    *
+    *  The default implementation does not store anything.
+    *
+    *  @since 3.15.0
+    */
+   virtual void StoreSolverState(
+      SolverState& /*state*/
+   ) const
+   { }
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
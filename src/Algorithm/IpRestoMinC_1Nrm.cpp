@@ -121,6 +121,10 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
    // ToDo set those up during initialize?
    // Create the restoration phase NLP etc objects
    SmartPtr<IpoptData> resto_ip_data = new IpoptData(NULL);
+   // record restoration phase tasks in the same trace as the regular iterations
+   // and measure the same times for them
+   resto_ip_data->TimingStats().SetTrace(IpData().TimingStats().Trace());
+   resto_ip_data->TimingStats().SetWallclockOnly(IpData().TimingStats().IsWallclockOnly());
    SmartPtr<IpoptNLP> resto_ip_nlp = new RestoIpoptNLP(IpNLP(), IpData(), IpCq());
    SmartPtr<IpoptCalculatedQuantities> resto_ip_cq = new IpoptCalculatedQuantities(resto_ip_nlp, resto_ip_data);
 
@@ -191,6 +195,11 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
    // problem
    SolverReturn resto_status = resto_alg_->Optimize(true);
 
+   // count the factorizations and inertia corrections of the restoration phase with those of the regular iterations
+   IpData().Set_inertia_correction_count(IpData().inertia_correction_count() + resto_ip_data->inertia_correction_count());
+   IpData().Set_resto_factorization_count(IpData().resto_factorization_count()
+                                          + resto_ip_data->TimingStats().LinearSystemFactorization().NumberOfCalls());
+
    int retval = -1;
 
    if( resto_status != SUCCESS )
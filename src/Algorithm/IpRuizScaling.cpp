@@ -0,0 +1,456 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpRuizScaling.hpp"
+#include "IpTripletHelper.hpp"
+#include "IpThreads.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace Ipopt
+{
+
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** computes the maxima of the absolute values of the scaled nonzeros begin,...,end-1 in each row and column
+ *
+ *  row_max and col_max need to be initialized to zero.
+ */
+static void ComputeScaledMaxima(
+   Index         begin,
+   Index         end,
+   const Index*  irow,
+   const Index*  jcol,
+   const Number* vals,
+   const Number* row_scale,
+   const Number* col_scale,
+   Number*       row_max,
+   Number*       col_max
+)
+{
+   for( Index k = begin; k < end; k++ )
+   {
+      const Index i = irow[k];
+      const Index j = jcol[k];
+      const Number v = vals[k] * row_scale[i] * col_scale[j];
+      if( v > row_max[i] )
+      {
+         row_max[i] = v;
+      }
+      if( v > col_max[j] )
+      {
+         col_max[j] = v;
+      }
+   }
+}
+
+/** calls ComputeScaledMaxima for one block of the nonzeros per part
+ *
+ *  The first block uses row_max and col_max, and each other block its
+ *  own maxima in buffer (of size (nblocks-1)*(nrows+ncols)).
+ */
+class ComputeScaledMaximaWork: public ParallelWork
+{
+public:
+   ComputeScaledMaximaWork(
+      Index         nblocks,
+      Index         nnz,
+      Index         nrows,
+      const Index*  irow,
+      const Index*  jcol,
+      const Number* vals,
+      const Number* row_scale,
+      const Number* col_scale,
+      Number*       row_max,
+      Number*       col_max,
+      Number*       buffer,
+      Index         buffer_size
+   )
+      : block_size_((nnz + nblocks - 1) / nblocks),
+        nnz_(nnz),
+        nrows_(nrows),
+        irow_(irow),
+        jcol_(jcol),
+        vals_(vals),
+        row_scale_(row_scale),
+        col_scale_(col_scale),
+        row_max_(row_max),
+        col_max_(col_max),
+        buffer_(buffer),
+        buffer_size_(buffer_size)
+   { }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      Number* block_row_max = row_max_;
+      Number* block_col_max = col_max_;
+      if( k > 0 )
+      {
+         block_row_max = buffer_ + (k - 1) * buffer_size_;
+         block_col_max = block_row_max + nrows_;
+      }
+      ComputeScaledMaxima(std::min(k * block_size_, nnz_), std::min((k + 1) * block_size_, nnz_), irow_, jcol_, vals_,
+                          row_scale_, col_scale_, block_row_max, block_col_max);
+   }
+
+private:
+   Index         block_size_;
+   Index         nnz_;
+   Index         nrows_;
+   const Index*  irow_;
+   const Index*  jcol_;
+   const Number* vals_;
+   const Number* row_scale_;
+   const Number* col_scale_;
+   Number*       row_max_;
+   Number*       col_max_;
+   Number*       buffer_;
+   Index         buffer_size_;
+};
+
+/** computes the maxima of the absolute values of the scaled nonzeros in each row and column
+ *
+ *  The blocks of nonzeros are processed in parallel, each block except
+ *  the first one with its own maxima in buffer (of size
+ *  (nblocks-1)*(nrows+ncols)), which are combined afterwards.
+ */
+static void ComputeScaledMaximaBlocks(
+   Index         nblocks,
+   Index         nnz,
+   Index         nrows,
+   Index         ncols,
+   const Index*  irow,
+   const Index*  jcol,
+   const Number* vals,
+   const Number* row_scale,
+   const Number* col_scale,
+   Number*       row_max,
+   Number*       col_max,
+   Number*       buffer
+)
+{
+   std::fill(row_max, row_max + nrows, 0.);
+   std::fill(col_max, col_max + ncols, 0.);
+   if( nblocks > 1 )
+   {
+      std::fill(buffer, buffer + (nblocks - 1) * (nrows + ncols), 0.);
+   }
+
+   ComputeScaledMaximaWork work(nblocks, nnz, nrows, irow, jcol, vals, row_scale, col_scale, row_max, col_max, buffer,
+                                nrows + ncols);
+   DoParallelWork(nblocks, work);
+
+   for( Index k = 1; k < nblocks; k++ )
+   {
+      const Number* block_row_max = buffer + (k - 1) * (nrows + ncols);
+      const Number* block_col_max = block_row_max + nrows;
+      for( Index i = 0; i < nrows; i++ )
+      {
+         row_max[i] = Max(row_max[i], block_row_max[i]);
+      }
+      for( Index j = 0; j < ncols; j++ )
+      {
+         col_max[j] = Max(col_max[j], block_col_max[j]);
+      }
+   }
+}
+
+/** compares two nonzeros of a triplet matrix by row and then by column */
+class TripletLess
+{
+public:
+   TripletLess(
+      const Index* irow,
+      const Index* jcol
+   )
+      : irow_(irow),
+        jcol_(jcol)
+   { }
+
+   bool operator()(
+      Index k1,
+      Index k2
+   ) const
+   {
+      if( irow_[k1] != irow_[k2] )
+      {
+         return irow_[k1] < irow_[k2];
+      }
+      return jcol_[k1] < jcol_[k2];
+   }
+
+private:
+   const Index* irow_;
+   const Index* jcol_;
+};
+
+/** replaces the nonzeros of a triplet matrix by the absolute values of its entries
+ *
+ *  Values of nonzeros with the same row and column are summed up before
+ *  the absolute value is taken, and entries that are zero are dropped.
+ *
+ *  @return number of remaining nonzeros
+ */
+static Index CombineTripletEntries(
+   Index   nnz,
+   Index*  irow,
+   Index*  jcol,
+   Number* vals
+)
+{
+   std::vector<Index> perm(nnz);
+   for( Index k = 0; k < nnz; k++ )
+   {
+      perm[k] = k;
+   }
+   std::sort(perm.begin(), perm.end(), TripletLess(irow, jcol));
+
+   std::vector<Index> new_irow;
+   std::vector<Index> new_jcol;
+   std::vector<Number> new_vals;
+   new_irow.reserve(nnz);
+   new_jcol.reserve(nnz);
+   new_vals.reserve(nnz);
+   for( Index k = 0; k < nnz; )
+   {
+      const Index i = irow[perm[k]];
+      const Index j = jcol[perm[k]];
+      Number v = 0.;
+      for( ; k < nnz && irow[perm[k]] == i && jcol[perm[k]] == j; k++ )
+      {
+         v += vals[perm[k]];
+      }
+      if( v != 0. )
+      {
+         new_irow.push_back(i);
+         new_jcol.push_back(j);
+         new_vals.push_back(std::abs(v));
+      }
+   }
+
+   std::copy(new_irow.begin(), new_irow.end(), irow);
+   std::copy(new_jcol.begin(), new_jcol.end(), jcol);
+   std::copy(new_vals.begin(), new_vals.end(), vals);
+   return (Index) new_vals.size();
+}
+
+/** divides the scaling factors by the square roots of the maxima
+ *
+ *  @return largest deviation of the nonzero maxima from one
+ */
+static Number UpdateScalingFactors(
+   Index         dim,
+   const Number* max_vals,
+   Number*       scale
+)
+{
+   Number deviation = 0.;
+   for( Index i = 0; i < dim; i++ )
+   {
+      if( max_vals[i] > 0. )
+      {
+         deviation = Max(deviation, std::abs(1. - max_vals[i]));
+         scale[i] /= std::sqrt(max_vals[i]);
+      }
+   }
+   return deviation;
+}
+
+void RuizScaling::RegisterOptions(
+   const SmartPtr<RegisteredOptions>& roptions
+)
+{
+   roptions->AddLowerBoundedIntegerOption(
+      "ruiz_scaling_max_iter",
+      "Maximum number of iterations of Ruiz scaling.",
+      1,
+      10,
+      "Each iteration divides every row and column of the first derivatives by the square root of its largest entry. "
+      "Note: This option is only used if \"nlp_scaling_method\" is chosen as \"ruiz\".",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "ruiz_scaling_tol",
+      "Tolerance for Ruiz scaling.",
+      0., true,
+      1e-2,
+      "The iterations of Ruiz scaling stop when the largest entry in every nonzero row and column "
+      "of the scaled first derivatives deviates from one by at most this value. "
+      "Note: This option is only used if \"nlp_scaling_method\" is chosen as \"ruiz\".",
+      true);
+}
+
+bool RuizScaling::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetIntegerValue("ruiz_scaling_max_iter", max_iter_, prefix);
+   options.GetNumericValue("ruiz_scaling_tol", tol_, prefix);
+   options.GetNumericValue("nlp_scaling_min_value", min_value_, prefix);
+   // The option num_threads is registered by IpoptApplication
+   options.GetIntegerValue("num_threads", num_threads_, prefix);
+   return StandardScalingBase::InitializeImpl(options, prefix);
+}
+
+void RuizScaling::DetermineScalingParametersImpl(
+   const SmartPtr<const VectorSpace>    x_space,
+   const SmartPtr<const VectorSpace>    c_space,
+   const SmartPtr<const VectorSpace>    d_space,
+   const SmartPtr<const MatrixSpace>    jac_c_space,
+   const SmartPtr<const MatrixSpace>    jac_d_space,
+   const SmartPtr<const SymMatrixSpace> /*h_space*/,
+   const Matrix&                        /*Px_L*/,
+   const Vector&                        /*x_L*/,
+   const Matrix&                        /*Px_U*/,
+   const Vector&                        /*x_U*/,
+   Number&                              df,
+   SmartPtr<Vector>&                    dx,
+   SmartPtr<Vector>&                    dc,
+   SmartPtr<Vector>&                    dd
+)
+{
+   DBG_START_METH("RuizScaling::DetermineScalingParametersImpl", dbg_verbosity);
+   DBG_ASSERT(IsValid(nlp_));
+
+   df = 1.;
+   dx = NULL;
+   dc = NULL;
+   dd = NULL;
+
+   SmartPtr<Vector> x = x_space->MakeNew();
+   if( !nlp_->GetStartingPoint(GetRawPtr(x), true,
+                               NULL, false,
+                               NULL, false,
+                               NULL, false,
+                               NULL, false) )
+   {
+      THROW_EXCEPTION(FAILED_INITIALIZATION, "Error getting initial point from NLP in RuizScaling.\n");
+   }
+
+   SmartPtr<Vector> grad_f = x_space->MakeNew();
+   SmartPtr<Matrix> jac_c = jac_c_space->MakeNew();
+   SmartPtr<Matrix> jac_d = jac_d_space->MakeNew();
+   if( !nlp_->Eval_grad_f(*x, *grad_f) || !nlp_->Eval_jac_c(*x, *jac_c) || !nlp_->Eval_jac_d(*x, *jac_d) )
+   {
+      Jnlst().Printf(J_WARNING, J_INITIALIZATION,
+                     "Error evaluating first derivatives at user provided starting point.\n  No scaling factors computed!\n");
+      return;
+   }
+
+   // Collect the absolute values of the nonzeros of the matrix with
+   // the rows of jac_c, jac_d, and grad_f (0-based)
+   const Index nnz_jac_c = TripletHelper::GetNumberEntries(*jac_c);
+   const Index nnz_jac_d = TripletHelper::GetNumberEntries(*jac_d);
+   const Index nc = jac_c_space->NRows();
+   const Index nd = jac_d_space->NRows();
+   const Index nx = x_space->Dim();
+   const Index nrows = nc + nd + 1;
+
+   Index* irow = new Index[nnz_jac_c + nnz_jac_d + nx];
+   Index* jcol = new Index[nnz_jac_c + nnz_jac_d + nx];
+   Number* vals = new Number[nnz_jac_c + nnz_jac_d + nx];
+   TripletHelper::FillRowCol(nnz_jac_c, *jac_c, irow, jcol);
+   TripletHelper::FillValues(nnz_jac_c, *jac_c, vals);
+   TripletHelper::FillRowCol(nnz_jac_d, *jac_d, &irow[nnz_jac_c], &jcol[nnz_jac_c], nc);
+   TripletHelper::FillValues(nnz_jac_d, *jac_d, &vals[nnz_jac_c]);
+
+   for( Index k = 0; k < nnz_jac_c + nnz_jac_d; k++ )
+   {
+      irow[k]--;
+      jcol[k]--;
+   }
+   // the Jacobian entries are the sums of the values of all nonzeros at the same position
+   Index nnz = CombineTripletEntries(nnz_jac_c + nnz_jac_d, irow, jcol, vals);
+   // keep only the nonzero entries of the objective gradient
+   TripletHelper::FillValuesFromVector(nx, *grad_f, &vals[nnz_jac_c + nnz_jac_d]);
+   for( Index j = 0; j < nx; j++ )
+   {
+      const Number v = std::abs(vals[nnz_jac_c + nnz_jac_d + j]);
+      if( v != 0. )
+      {
+         irow[nnz] = nrows - 1;
+         jcol[nnz] = j;
+         vals[nnz] = v;
+         nnz++;
+      }
+   }
+
+   // Ruiz iterations
+   Number* row_scale = new Number[nrows];
+   Number* col_scale = new Number[nx];
+   std::fill(row_scale, row_scale + nrows, 1.);
+   std::fill(col_scale, col_scale + nx, 1.);
+   Number* row_max = new Number[nrows];
+   Number* col_max = new Number[nx];
+   const Index nblocks = NumWorkThreads(num_threads_, nnz);
+   Number* buffer = nblocks > 1 ? new Number[(nblocks - 1) * (nrows + nx)] : NULL;
+
+   Index iter = 0;
+   for( ; iter < max_iter_; iter++ )
+   {
+      ComputeScaledMaximaBlocks(nblocks, nnz, nrows, nx, irow, jcol, vals, row_scale, col_scale, row_max, col_max,
+                                buffer);
+      Number deviation = Max(UpdateScalingFactors(nrows, row_max, row_scale),
+                             UpdateScalingFactors(nx, col_max, col_scale));
+      Jnlst().Printf(J_MOREDETAILED, J_INITIALIZATION,
+                     "Ruiz scaling iteration %" IPOPT_INDEX_FORMAT ": largest deviation of row and column maxima from one is %e\n",
+                     iter, deviation);
+      if( deviation <= tol_ )
+      {
+         // the update of this iteration did not change much anymore, but keep it
+         iter++;
+         break;
+      }
+   }
+   Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                  "Ruiz scaling computed in %" IPOPT_INDEX_FORMAT " iterations (%" IPOPT_INDEX_FORMAT " threads).\n",
+                  iter, nblocks);
+
+   delete[] buffer;
+   delete[] row_max;
+   delete[] col_max;
+   delete[] irow;
+   delete[] jcol;
+   delete[] vals;
+
+   // keep the scaling factors within [min_value, 1/min_value]
+   if( min_value_ > 0. )
+   {
+      const Number max_value = 1. / min_value_;
+      for( Index i = 0; i < nrows; i++ )
+      {
+         row_scale[i] = Min(Max(row_scale[i], min_value_), max_value);
+      }
+      for( Index j = 0; j < nx; j++ )
+      {
+         col_scale[j] = Min(Max(col_scale[j], min_value_), max_value);
+      }
+   }
+
+   df = row_scale[nrows - 1];
+   Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                  "Scaling parameter for objective function = %e\n", df);
+   dc = c_space->MakeNew();
+   TripletHelper::PutValuesInVector(nc, row_scale, *dc);
+   dd = d_space->MakeNew();
+   TripletHelper::PutValuesInVector(nd, &row_scale[nc], *dd);
+   // the scaled Jacobians are dc*J*dx^{-1}, so the variables are scaled by the reciprocals of the column factors
+   for( Index j = 0; j < nx; j++ )
+   {
+      col_scale[j] = 1. / col_scale[j];
+   }
+   dx = x_space->MakeNew();
+   TripletHelper::PutValuesInVector(nx, col_scale, *dx);
+
+   delete[] row_scale;
+   delete[] col_scale;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,117 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPRUIZSCALING_HPP__
+#define __IPRUIZSCALING_HPP__
+
+#include "IpNLPScaling.hpp"
+#include "IpNLP.hpp"
+
+namespace Ipopt
+{
+
+/** This class does problem scaling by equilibrating the rows and
+ *  columns of the first derivatives at the user provided initial point.
+ *
+ *  The matrix that consists of the Jacobians of c and d and the
+ *  gradient of the objective function (as last row) is scaled
+ *  iteratively by the method of Ruiz: in each iteration, every row and
+ *  every column is divided by the square root of its largest absolute
+ *  entry, until all these entries are close to one.  The row factors
+ *  give the scaling of the constraints and the objective function, and
+ *  the column factors give the scaling of the variables.
+ *
+ *  In contrast to EquilibrationScaling, this does not require MC19.
+ *  For large Jacobians, the nonzeros can be processed in blocks in
+ *  separate threads (see option num_threads).
+ *
+ *  @since 3.15.0
+ */
+class RuizScaling: public StandardScalingBase
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   RuizScaling(
+      const SmartPtr<NLP>& nlp
+   )
+      : StandardScalingBase(),
+        nlp_(nlp)
+   { }
+
+   /** Destructor */
+   virtual ~RuizScaling()
+   { }
+   ///@}
+
+   /** Register the options for this class */
+   static void RegisterOptions(
+      const SmartPtr<RegisteredOptions>& roptions
+   );
+
+protected:
+   /** Initialize the object from the options */
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   virtual void DetermineScalingParametersImpl(
+      const SmartPtr<const VectorSpace>    x_space,
+      const SmartPtr<const VectorSpace>    c_space,
+      const SmartPtr<const VectorSpace>    d_space,
+      const SmartPtr<const MatrixSpace>    jac_c_space,
+      const SmartPtr<const MatrixSpace>    jac_d_space,
+      const SmartPtr<const SymMatrixSpace> h_space,
+      const Matrix&                        Px_L,
+      const Vector&                        x_L,
+      const Matrix&                        Px_U,
+      const Vector&                        x_U,
+      Number&                              df,
+      SmartPtr<Vector>&                    dx,
+      SmartPtr<Vector>&                    dc,
+      SmartPtr<Vector>&                    dd
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   RuizScaling(
+      const RuizScaling&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const RuizScaling&
+   );
+   ///@}
+
+   /** pointer to the NLP to get scaling parameters */
+   SmartPtr<NLP> nlp_;
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** maximal number of equilibration iterations */
+   Index max_iter_;
+   /** tolerance for the deviation of the largest entries from one */
+   Number tol_;
+   /** lower bound for the scaling factors */
+   Number min_value_;
+   /** maximal number of threads */
+   Index num_threads_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
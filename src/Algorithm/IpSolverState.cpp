@@ -0,0 +1,490 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpSolverState.hpp"
+#include "IpIteratesVector.hpp"
+#include "IpTripletHelper.hpp"
+#include "IpUtils.hpp"
+
+#include <istream>
+#include <ostream>
+#include <limits>
+#include <string>
+
+namespace Ipopt
+{
+
+/** format identifier and version that is written at the beginning of a snapshot */
+static const char* const solver_state_header = "IpoptSolverState";
+static const int solver_state_version = 1;
+
+/** copies the values of a vector into an std::vector */
+static void StoreValues(
+   const Vector&        vec,
+   std::vector<Number>& values
+)
+{
+   values.resize(vec.Dim());
+   if( vec.Dim() > 0 )
+   {
+      TripletHelper::FillValuesFromVector(vec.Dim(), vec, &values[0]);
+   }
+}
+
+/** copies n values starting at values into a vector */
+static void RetrieveValues(
+   Index         n,
+   const Number* values,
+   Vector&       vec
+)
+{
+   if( n > 0 )
+   {
+      TripletHelper::PutValuesInVector(n, values, vec);
+   }
+}
+
+/** writes a labelled array of values as one line */
+static void WriteValues(
+   std::ostream&              os,
+   const char*                label,
+   const std::vector<Number>& values
+)
+{
+   os << label << ' ' << values.size();
+   for( std::vector<Number>::const_iterator it = values.begin(); it != values.end(); ++it )
+   {
+      os << ' ' << *it;
+   }
+   os << '\n';
+}
+
+/** reads n values into values
+ *
+ *  The size n comes from the stream and may be corrupted, so storage
+ *  is only reserved up to a moderate size and otherwise grows with the
+ *  values that are actually read.
+ */
+static bool ReadArray(
+   std::istream&        is,
+   Index                n,
+   std::vector<Number>& values
+)
+{
+   values.clear();
+   values.reserve(Min(n, (Index) 65536));
+   for( Index i = 0; i < n; i++ )
+   {
+      Number value;
+      if( !(is >> value) )
+      {
+         return false;
+      }
+      values.push_back(value);
+   }
+   return true;
+}
+
+/** reads a labelled array of values that has been written by WriteValues
+ *
+ *  If expected is nonnegative, then the array must have this size.
+ */
+static bool ReadValues(
+   std::istream&        is,
+   const char*          label,
+   std::vector<Number>& values,
+   Index                expected = -1
+)
+{
+   std::string token;
+   Index n;
+   if( !(is >> token >> n) || token != label || n < 0 || (expected >= 0 && n != expected) )
+   {
+      return false;
+   }
+   return ReadArray(is, n, values);
+}
+
+/** reads a label followed by a value */
+template<typename T>
+static bool ReadLabelled(
+   std::istream& is,
+   const char*   label,
+   T&            value
+)
+{
+   std::string token;
+   return (is >> token >> value) && token == label;
+}
+
+SolverState::SolverState()
+{
+   Clear();
+}
+
+SolverState::~SolverState()
+{ }
+
+void SolverState::Clear()
+{
+   have_iterate_ = false;
+   for( Index i = 0; i < n_iterate_comps_; i++ )
+   {
+      iterate_[i].clear();
+   }
+   mu_ = -1.;
+   tau_ = -1.;
+   have_perturbations_ = false;
+   delta_x_ = 0.;
+   delta_s_ = 0.;
+   delta_c_ = 0.;
+   delta_d_ = 0.;
+   have_scaling_ = false;
+   obj_scaling_ = 1.;
+   for( Index i = 0; i < 3; i++ )
+   {
+      have_scaling_comp_[i] = false;
+      scaling_[i].clear();
+   }
+   qn_sigma_ = 1.;
+   qn_npairs_ = 0;
+   qn_dim_ = 0;
+   qn_s_.clear();
+   qn_y_.clear();
+}
+
+void SolverState::SetIterate(
+   const IteratesVector& iterate
+)
+{
+   DBG_ASSERT(iterate.NComps() == n_iterate_comps_);
+   for( Index i = 0; i < n_iterate_comps_; i++ )
+   {
+      StoreValues(*iterate.GetComp(i), iterate_[i]);
+   }
+   have_iterate_ = true;
+}
+
+bool SolverState::GetIterate(
+   IteratesVector& iterate
+) const
+{
+   if( !have_iterate_ || iterate.NComps() != n_iterate_comps_ )
+   {
+      return false;
+   }
+   for( Index i = 0; i < n_iterate_comps_; i++ )
+   {
+      if( iterate.GetComp(i)->Dim() != (Index) iterate_[i].size() )
+      {
+         return false;
+      }
+   }
+   for( Index i = 0; i < n_iterate_comps_; i++ )
+   {
+      RetrieveValues((Index) iterate_[i].size(), iterate_[i].empty() ? NULL : &iterate_[i][0],
+                     *iterate.GetCompNonConst(i));
+   }
+   return true;
+}
+
+void SolverState::SetBarrierParameter(
+   Number mu,
+   Number tau
+)
+{
+   mu_ = mu;
+   tau_ = tau;
+}
+
+void SolverState::SetPerturbations(
+   Number delta_x,
+   Number delta_s,
+   Number delta_c,
+   Number delta_d
+)
+{
+   delta_x_ = delta_x;
+   delta_s_ = delta_s;
+   delta_c_ = delta_c;
+   delta_d_ = delta_d;
+   have_perturbations_ = true;
+}
+
+void SolverState::GetPerturbations(
+   Number& delta_x,
+   Number& delta_s,
+   Number& delta_c,
+   Number& delta_d
+) const
+{
+   delta_x = delta_x_;
+   delta_s = delta_s_;
+   delta_c = delta_c_;
+   delta_d = delta_d_;
+}
+
+void SolverState::SetScaling(
+   Number        obj_scaling,
+   const Vector* x_scaling,
+   const Vector* c_scaling,
+   const Vector* d_scaling
+)
+{
+   obj_scaling_ = obj_scaling;
+   const Vector* comps[3] = { x_scaling, c_scaling, d_scaling };
+   for( Index i = 0; i < 3; i++ )
+   {
+      have_scaling_comp_[i] = comps[i] != NULL;
+      if( comps[i] != NULL )
+      {
+         StoreValues(*comps[i], scaling_[i]);
+      }
+      else
+      {
+         scaling_[i].clear();
+      }
+   }
+   have_scaling_ = true;
+}
+
+bool SolverState::GetXScaling(
+   Vector& x_scaling
+) const
+{
+   if( !have_scaling_comp_[0] || x_scaling.Dim() != (Index) scaling_[0].size() )
+   {
+      return false;
+   }
+   RetrieveValues(x_scaling.Dim(), scaling_[0].empty() ? NULL : &scaling_[0][0], x_scaling);
+   return true;
+}
+
+bool SolverState::GetCScaling(
+   Vector& c_scaling
+) const
+{
+   if( !have_scaling_comp_[1] || c_scaling.Dim() != (Index) scaling_[1].size() )
+   {
+      return false;
+   }
+   RetrieveValues(c_scaling.Dim(), scaling_[1].empty() ? NULL : &scaling_[1][0], c_scaling);
+   return true;
+}
+
+bool SolverState::GetDScaling(
+   Vector& d_scaling
+) const
+{
+   if( !have_scaling_comp_[2] || d_scaling.Dim() != (Index) scaling_[2].size() )
+   {
+      return false;
+   }
+   RetrieveValues(d_scaling.Dim(), scaling_[2].empty() ? NULL : &scaling_[2][0], d_scaling);
+   return true;
+}
+
+bool SolverState::ScalingMatches(
+   Index n_x,
+   Index n_c,
+   Index n_d
+) const
+{
+   if( !have_scaling_ )
+   {
+      return false;
+   }
+   const Index dims[3] = { n_x, n_c, n_d };
+   for( Index i = 0; i < 3; i++ )
+   {
+      if( have_scaling_comp_[i] && (Index) scaling_[i].size() != dims[i] )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+void SolverState::SetQuasiNewtonPairs(
+   Number               sigma,
+   Index                npairs,
+   const Vector* const* s,
+   const Vector* const* y
+)
+{
+   qn_sigma_ = sigma;
+   qn_npairs_ = npairs;
+   qn_dim_ = npairs > 0 ? s[0]->Dim() : 0;
+   qn_s_.resize(npairs * qn_dim_);
+   qn_y_.resize(npairs * qn_dim_);
+   for( Index k = 0; k < npairs; k++ )
+   {
+      DBG_ASSERT(s[k]->Dim() == qn_dim_ && y[k]->Dim() == qn_dim_);
+      if( qn_dim_ > 0 )
+      {
+         TripletHelper::FillValuesFromVector(qn_dim_, *s[k], &qn_s_[k * qn_dim_]);
+         TripletHelper::FillValuesFromVector(qn_dim_, *y[k], &qn_y_[k * qn_dim_]);
+      }
+   }
+}
+
+bool SolverState::GetQuasiNewtonPair(
+   Index   k,
+   Vector& s,
+   Vector& y
+) const
+{
+   if( k < 0 || k >= qn_npairs_ || s.Dim() != qn_dim_ || y.Dim() != qn_dim_ )
+   {
+      return false;
+   }
+   if( qn_dim_ > 0 )
+   {
+      RetrieveValues(qn_dim_, &qn_s_[k * qn_dim_], s);
+      RetrieveValues(qn_dim_, &qn_y_[k * qn_dim_], y);
+   }
+   return true;
+}
+
+bool SolverState::Write(
+   std::ostream& os
+) const
+{
+   std::streamsize old_precision = os.precision(std::numeric_limits<Number>::digits10 + 3);
+
+   os << solver_state_header << ' ' << solver_state_version << '\n';
+
+   os << "iterate " << (have_iterate_ ? 1 : 0) << '\n';
+   if( have_iterate_ )
+   {
+      static const char* const labels[n_iterate_comps_] = { "x", "s", "y_c", "y_d", "z_L", "z_U", "v_L", "v_U" };
+      for( Index i = 0; i < n_iterate_comps_; i++ )
+      {
+         WriteValues(os, labels[i], iterate_[i]);
+      }
+   }
+
+   os << "mu " << mu_ << '\n';
+   os << "tau " << tau_ << '\n';
+
+   os << "perturbations " << (have_perturbations_ ? 1 : 0) << ' ' << delta_x_ << ' ' << delta_s_ << ' ' << delta_c_
+      << ' ' << delta_d_ << '\n';
+
+   os << "scaling " << (have_scaling_ ? 1 : 0) << ' ' << obj_scaling_ << '\n';
+   if( have_scaling_ )
+   {
+      static const char* const labels[3] = { "x_scaling", "c_scaling", "d_scaling" };
+      for( Index i = 0; i < 3; i++ )
+      {
+         if( have_scaling_comp_[i] )
+         {
+            WriteValues(os, labels[i], scaling_[i]);
+         }
+         else
+         {
+            // size -1 marks a part that is not scaled
+            os << labels[i] << " -1\n";
+         }
+      }
+   }
+
+   os << "quasi_newton " << qn_npairs_ << ' ' << qn_dim_ << ' ' << qn_sigma_ << '\n';
+   if( qn_npairs_ > 0 )
+   {
+      WriteValues(os, "s", qn_s_);
+      WriteValues(os, "y", qn_y_);
+   }
+
+   os << "end\n";
+
+   os.precision(old_precision);
+
+   return !os.fail();
+}
+
+bool SolverState::Read(
+   std::istream& is
+)
+{
+   Clear();
+
+   bool ok = true;
+   std::string token;
+   int version;
+   if( !(is >> token >> version) || token != solver_state_header || version != solver_state_version )
+   {
+      ok = false;
+   }
+
+   int flag = 0;
+   if( ok )
+   {
+      ok = ReadLabelled(is, "iterate", flag);
+   }
+   if( ok && flag != 0 )
+   {
+      static const char* const labels[n_iterate_comps_] = { "x", "s", "y_c", "y_d", "z_L", "z_U", "v_L", "v_U" };
+      for( Index i = 0; ok && i < n_iterate_comps_; i++ )
+      {
+         ok = ReadValues(is, labels[i], iterate_[i]);
+      }
+      have_iterate_ = ok;
+   }
+
+   if( ok )
+   {
+      ok = ReadLabelled(is, "mu", mu_) && ReadLabelled(is, "tau", tau_);
+   }
+
+   if( ok )
+   {
+      ok = ReadLabelled(is, "perturbations", flag) && (is >> delta_x_ >> delta_s_ >> delta_c_ >> delta_d_);
+      have_perturbations_ = ok && flag != 0;
+   }
+
+   if( ok )
+   {
+      ok = ReadLabelled(is, "scaling", flag) && (is >> obj_scaling_);
+   }
+   if( ok && flag != 0 )
+   {
+      static const char* const labels[3] = { "x_scaling", "c_scaling", "d_scaling" };
+      for( Index i = 0; ok && i < 3; i++ )
+      {
+         Index n;
+         ok = ReadLabelled(is, labels[i], n) && n >= -1;
+         if( ok && n >= 0 )
+         {
+            have_scaling_comp_[i] = true;
+            ok = ReadArray(is, n, scaling_[i]);
+         }
+      }
+      have_scaling_ = ok;
+   }
+
+   if( ok )
+   {
+      ok = ReadLabelled(is, "quasi_newton", qn_npairs_) && (is >> qn_dim_ >> qn_sigma_) && qn_npairs_ >= 0
+           && qn_dim_ >= 0;
+   }
+   if( ok && qn_npairs_ > 0 )
+   {
+      // the values of all pairs need to be addressable by an Index
+      ok = qn_dim_ == 0 || qn_npairs_ <= std::numeric_limits<Index>::max() / qn_dim_;
+      ok = ok && ReadValues(is, "s", qn_s_, qn_npairs_ * qn_dim_) && ReadValues(is, "y", qn_y_, qn_npairs_ * qn_dim_);
+   }
+
+   if( ok )
+   {
+      ok = (is >> token) && token == "end";
+   }
+
+   if( !ok )
+   {
+      Clear();
+   }
+   return ok;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,308 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPSOLVERSTATE_HPP__
+#define __IPSOLVERSTATE_HPP__
+
+#include "IpReferenced.hpp"
+#include "IpTypes.hpp"
+
+#include <iosfwd>
+#include <vector>
+
+namespace Ipopt
+{
+
+class Vector;
+class IteratesVector;
+
+/** Snapshot of the state of the Ipopt algorithm at the end of an
+ *  optimization run.
+ *
+ *  The snapshot can be used to warm start a later optimization run
+ *  for a problem with the same structure (see
+ *  IpoptApplication::GetSolverState and
+ *  IpoptApplication::SetWarmStartState).  It contains
+ *  - the primal-dual iterate,
+ *  - the barrier parameter and the fraction-to-the-boundary parameter,
+ *  - the most recent perturbations of the primal-dual system,
+ *  - the scaling factors of the problem, and
+ *  - the pairs of the limited-memory BFGS approximation of the Hessian.
+ *
+ *  The iterate and the quasi-Newton pairs refer to the internal
+ *  (scaled) formulation of the problem, so they are only meaningful
+ *  together with the stored scaling factors.  Since a snapshot only
+ *  consists of numbers, it can be written to a stream and read back
+ *  (also in another process).
+ *
+ *  @since 3.15.0
+ */
+class IPOPTLIB_EXPORT SolverState: public ReferencedObject
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Constructor for an empty snapshot */
+   SolverState();
+
+   /** Destructor */
+   virtual ~SolverState();
+   ///@}
+
+   /**@name Primal-dual iterate */
+   ///@{
+   /** Store the values of a primal-dual iterate */
+   void SetIterate(
+      const IteratesVector& iterate
+   );
+
+   /** Whether an iterate is stored */
+   bool HasIterate() const
+   {
+      return have_iterate_;
+   }
+
+   /** Copy the stored iterate into the components of iterate.
+    *
+    *  The components of iterate need to be allocated.
+    *
+    *  @return false, if no iterate is stored or the dimensions do not match
+    */
+   bool GetIterate(
+      IteratesVector& iterate
+   ) const;
+   ///@}
+
+   /**@name Barrier parameter */
+   ///@{
+   /** Store the barrier parameter and the fraction-to-the-boundary parameter */
+   void SetBarrierParameter(
+      Number mu,
+      Number tau
+   );
+
+   /** Whether the barrier parameter is stored */
+   bool HasBarrierParameter() const
+   {
+      return mu_ > 0.;
+   }
+
+   Number Mu() const
+   {
+      return mu_;
+   }
+
+   Number Tau() const
+   {
+      return tau_;
+   }
+   ///@}
+
+   /**@name Perturbations of the primal-dual system */
+   ///@{
+   /** Store the most recent perturbations for the x, s, c, and d blocks of the primal-dual system */
+   void SetPerturbations(
+      Number delta_x,
+      Number delta_s,
+      Number delta_c,
+      Number delta_d
+   );
+
+   /** Whether the perturbations are stored */
+   bool HasPerturbations() const
+   {
+      return have_perturbations_;
+   }
+
+   /** Get the stored perturbations */
+   void GetPerturbations(
+      Number& delta_x,
+      Number& delta_s,
+      Number& delta_c,
+      Number& delta_d
+   ) const;
+   ///@}
+
+   /**@name Scaling of the problem */
+   ///@{
+   /** Store the scaling factors.
+    *
+    *  A NULL pointer means that the corresponding part is not scaled.
+    */
+   void SetScaling(
+      Number        obj_scaling,
+      const Vector* x_scaling,
+      const Vector* c_scaling,
+      const Vector* d_scaling
+   );
+
+   /** Whether scaling factors are stored */
+   bool HasScaling() const
+   {
+      return have_scaling_;
+   }
+
+   /** Scaling factor of the objective function */
+   Number ObjScaling() const
+   {
+      return obj_scaling_;
+   }
+
+   /** Get scaling factors for the variables into x_scaling.
+    *
+    *  @return false, if the variables are not scaled or the dimension does not match
+    */
+   bool GetXScaling(
+      Vector& x_scaling
+   ) const;
+
+   /** Get scaling factors for the equality constraints into c_scaling.
+    *
+    *  @return false, if the equality constraints are not scaled or the dimension does not match
+    */
+   bool GetCScaling(
+      Vector& c_scaling
+   ) const;
+
+   /** Get scaling factors for the inequality constraints into d_scaling.
+    *
+    *  @return false, if the inequality constraints are not scaled or the dimension does not match
+    */
+   bool GetDScaling(
+      Vector& d_scaling
+   ) const;
+
+   /** Whether scaling factors are stored and fit to a problem with the given
+    *  numbers of variables, equality, and inequality constraints
+    */
+   bool ScalingMatches(
+      Index n_x,
+      Index n_c,
+      Index n_d
+   ) const;
+   ///@}
+
+   /**@name Limited-memory quasi-Newton approximation */
+   ///@{
+   /** Store the scaling factor of the initial matrix and the pairs of
+    *  the limited-memory BFGS update
+    *
+    *  s[k] and y[k] are the k-th oldest pairs; all vectors must be
+    *  in the same vector space.
+    */
+   void SetQuasiNewtonPairs(
+      Number               sigma,
+      Index                npairs,
+      const Vector* const* s,
+      const Vector* const* y
+   );
+
+   /** Number of stored quasi-Newton pairs */
+   Index NumQuasiNewtonPairs() const
+   {
+      return qn_npairs_;
+   }
+
+   /** Dimension of the vectors in the stored quasi-Newton pairs */
+   Index QuasiNewtonDim() const
+   {
+      return qn_dim_;
+   }
+
+   /** Scaling factor of the initial matrix of the quasi-Newton approximation */
+   Number QuasiNewtonSigma() const
+   {
+      return qn_sigma_;
+   }
+
+   /** Get the k-th oldest quasi-Newton pair.
+    *
+    *  @return false, if there is no such pair or the dimensions do not match
+    */
+   bool GetQuasiNewtonPair(
+      Index   k,
+      Vector& s,
+      Vector& y
+   ) const;
+   ///@}
+
+   /**@name Serialization */
+   ///@{
+   /** Write the snapshot to a stream in a text format.
+    *
+    *  @return false, if writing failed
+    */
+   bool Write(
+      std::ostream& os
+   ) const;
+
+   /** Read a snapshot that has been written by Write.
+    *
+    *  @return false, if the stream does not contain a valid snapshot; the snapshot is empty then
+    */
+   bool Read(
+      std::istream& is
+   );
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   SolverState(
+      const SolverState&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const SolverState&
+   );
+   ///@}
+
+   /** Remove all information from the snapshot */
+   void Clear();
+
+   /** Number of components of an iterate */
+   static const Index n_iterate_comps_ = 8;
+
+   bool have_iterate_;
+   /** Values of x, s, y_c, y_d, z_L, z_U, v_L, and v_U */
+   std::vector<Number> iterate_[n_iterate_comps_];
+
+   Number mu_;
+   Number tau_;
+
+   bool have_perturbations_;
+   Number delta_x_;
+   Number delta_s_;
+   Number delta_c_;
+   Number delta_d_;
+
+   bool have_scaling_;
+   Number obj_scaling_;
+   /** Whether the variables, equality, and inequality constraints are scaled */
+   bool have_scaling_comp_[3];
+   /** Scaling factors for the variables, equality, and inequality constraints */
+   std::vector<Number> scaling_[3];
+
+   Number qn_sigma_;
+   Index qn_npairs_;
+   Index qn_dim_;
+   /** Values of the vectors s of the quasi-Newton pairs, one after the other */
+   std::vector<Number> qn_s_;
+   /** Values of the vectors y of the quasi-Newton pairs, one after the other */
+   std::vector<Number> qn_y_;
+};
+
+} // namespace Ipopt
+
+#endif
@@ -0,0 +1,254 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpTelemetryIterationOutput.hpp"
+
+namespace Ipopt
+{
+
+/** appends ,"key":value to a record buffer, with null for non-finite values */
+static void AppendNumber(
+   char*       buf,
+   size_t      buflen,
+   size_t&     pos,
+   const char* key,
+   Number      value
+)
+{
+   if( pos >= buflen )
+   {
+      return;
+   }
+   int n;
+   if( IsFiniteNumber(value) )
+   {
+      n = Snprintf(buf + pos, buflen - pos, ",\"%s\":%.17g", key, value);
+   }
+   else
+   {
+      n = Snprintf(buf + pos, buflen - pos, ",\"%s\":null", key);
+   }
+   if( n > 0 )
+   {
+      pos += (size_t) n;
+   }
+}
+
+/** appends ,"key":value to a record buffer */
+static void AppendIndex(
+   char*       buf,
+   size_t      buflen,
+   size_t&     pos,
+   const char* key,
+   Index       value
+)
+{
+   if( pos >= buflen )
+   {
+      return;
+   }
+   int n = Snprintf(buf + pos, buflen - pos, ",\"%s\":%" IPOPT_INDEX_FORMAT, key, value);
+   if( n > 0 )
+   {
+      pos += (size_t) n;
+   }
+}
+
+/** appends ,"key":walltime of a timed task that is not running at the moment */
+static void AppendTaskTime(
+   char*            buf,
+   size_t           buflen,
+   size_t&          pos,
+   const char*      key,
+   const TimedTask& task
+)
+{
+   AppendNumber(buf, buflen, pos, key, task.IsStarted() ? 0. : task.TotalWallclockTime());
+}
+
+TelemetryIterationOutput::TelemetryIterationOutput(
+   const SmartPtr<IterationOutput>& orig_iteration_output
+)
+   : orig_iteration_output_(orig_iteration_output),
+     file_(NULL)
+{ }
+
+TelemetryIterationOutput::~TelemetryIterationOutput()
+{
+   if( file_ != NULL )
+   {
+      fclose(file_);
+   }
+}
+
+void TelemetryIterationOutput::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   SmartPtr<RegisteredCategory> prev_cat = roptions->RegisteringCategory();
+   roptions->SetRegisteringCategory("Output");
+   roptions->AddStringOption1(
+      "iteration_telemetry_file",
+      "File name for a machine-readable record of every iteration (leave unset for no records).",
+      "",
+      "*", "Any acceptable standard file name",
+      "If set, one line with a JSON object is written to this file per iteration. "
+      "It holds the iteration number, objective function value, constraint violation (as specified by inf_pr_output), dual infeasibility, "
+      "barrier parameter, search direction norm, Hessian regularization, step sizes, line search trials, info string, "
+      "the wallclock time since the start of the algorithm, the number of function evaluations, "
+      "the number of factorizations of the primal-dual system and of perturbations of it for wrong inertia (both including the restoration phase), "
+      "and the cumulative wallclock time of the main algorithm phases (these are nonzero only if timing_statistics is enabled). "
+      "Records are flushed to the file at the end of each iteration.",
+      true);
+   roptions->SetRegisteringCategory(prev_cat);
+}
+
+bool TelemetryIterationOutput::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   Index enum_int;
+   options.GetEnumValue("inf_pr_output", enum_int, prefix);
+   inf_pr_output_ = InfPrOutput(enum_int);
+
+   if( file_ != NULL )
+   {
+      fclose(file_);
+      file_ = NULL;
+   }
+   std::string filename;
+   options.GetStringValue("iteration_telemetry_file", filename, prefix);
+   if( filename != "" )
+   {
+      file_ = fopen(filename.c_str(), "w");
+      if( file_ == NULL )
+      {
+         Jnlst().Printf(J_WARNING, J_MAIN, "Could not open iteration telemetry file %s.\n", filename.c_str());
+      }
+   }
+
+   bool retval = true;
+   if( IsValid(orig_iteration_output_) )
+   {
+      retval = orig_iteration_output_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   }
+
+   return retval;
+}
+
+void TelemetryIterationOutput::WriteOutput()
+{
+   if( IsValid(orig_iteration_output_) )
+   {
+      orig_iteration_output_->WriteOutput();
+   }
+
+   char buf[1024];
+   const size_t buflen = sizeof(buf) - 2;  // leave room for closing brace and terminating zero
+   size_t pos = 0;
+
+   int n = Snprintf(buf, buflen, "{\"iter\":%" IPOPT_INDEX_FORMAT, IpData().iter_count());
+   pos = n > 0 ? (size_t) n : 0;
+
+   Number inf_pr = 0.0;
+   switch( inf_pr_output_ )
+   {
+      case INTERNAL:
+         inf_pr = IpCq().curr_primal_infeasibility(NORM_MAX);
+         break;
+      case ORIGINAL:
+         inf_pr = IpCq().unscaled_curr_nlp_constraint_violation(NORM_MAX);
+         break;
+   }
+   Number dnrm = 0.;
+   if( IsValid(IpData().delta()) && IsValid(IpData().delta()->x()) && IsValid(IpData().delta()->s()) )
+   {
+      dnrm = Max(IpData().delta()->x()->Amax(), IpData().delta()->s()->Amax());
+   }
+
+   AppendNumber(buf, buflen, pos, "objective", IpCq().unscaled_curr_f());
+   AppendNumber(buf, buflen, pos, "inf_pr", inf_pr);
+   AppendNumber(buf, buflen, pos, "inf_du", IpCq().curr_dual_infeasibility(NORM_MAX));
+   AppendNumber(buf, buflen, pos, "mu", IpData().curr_mu());
+   AppendNumber(buf, buflen, pos, "d_norm", dnrm);
+   AppendNumber(buf, buflen, pos, "regu_x", IpData().info_regu_x());
+   AppendNumber(buf, buflen, pos, "alpha_du", IpData().info_alpha_dual());
+   AppendNumber(buf, buflen, pos, "alpha_pr", IpData().info_alpha_primal());
+   AppendIndex(buf, buflen, pos, "ls", IpData().info_ls_count());
+
+   if( pos < buflen )
+   {
+      // info string and step type consist of letters, but make sure that we still write valid JSON
+      char alpha_pr_char = IpData().info_alpha_primal_char();
+      if( alpha_pr_char == '"' || alpha_pr_char == '\\' || alpha_pr_char < ' ' )
+      {
+         alpha_pr_char = ' ';
+      }
+      std::string info_string = IpData().info_string();
+      for( std::string::iterator it = info_string.begin(); it != info_string.end(); ++it )
+      {
+         if( *it == '"' || *it == '\\' || *it < ' ' )
+         {
+            *it = ' ';
+         }
+      }
+      n = Snprintf(buf + pos, buflen - pos, ",\"alpha_pr_char\":\"%c\",\"info\":\"%s\"", alpha_pr_char, info_string.c_str());
+      if( n > 0 )
+      {
+         pos += (size_t) n;
+      }
+   }
+
+   TimingStatistics& timing = IpData().TimingStats();
+   Number walltime = 0.;
+   if( timing.OverallAlgorithm().IsStarted() )
+   {
+      walltime = WallclockTime() - timing.OverallAlgorithm().StartWallclockTime();
+   }
+   AppendNumber(buf, buflen, pos, "wall_time", walltime);
+
+   AppendIndex(buf, buflen, pos, "f_evals", IpNLP().f_evals());
+   AppendIndex(buf, buflen, pos, "grad_f_evals", IpNLP().grad_f_evals());
+   AppendIndex(buf, buflen, pos, "c_evals", IpNLP().c_evals());
+   AppendIndex(buf, buflen, pos, "d_evals", IpNLP().d_evals());
+   AppendIndex(buf, buflen, pos, "jac_c_evals", IpNLP().jac_c_evals());
+   AppendIndex(buf, buflen, pos, "jac_d_evals", IpNLP().jac_d_evals());
+   AppendIndex(buf, buflen, pos, "h_evals", IpNLP().h_evals());
+   AppendIndex(buf, buflen, pos, "factorizations",
+               timing.LinearSystemFactorization().NumberOfCalls() + IpData().resto_factorization_count());
+   AppendIndex(buf, buflen, pos, "inertia_corrections", IpData().inertia_correction_count());
+
+   AppendTaskTime(buf, buflen, pos, "time_search_dir", timing.ComputeSearchDirection());
+   AppendTaskTime(buf, buflen, pos, "time_factorization", timing.LinearSystemFactorization());
+   AppendTaskTime(buf, buflen, pos, "time_backsolve", timing.LinearSystemBackSolve());
+   AppendTaskTime(buf, buflen, pos, "time_line_search", timing.ComputeAcceptableTrialPoint());
+   AppendTaskTime(buf, buflen, pos, "time_hessian_update", timing.UpdateHessian());
+   AppendTaskTime(buf, buflen, pos, "time_mu_update", timing.UpdateBarrierParameter());
+
+   if( pos > buflen )
+   {
+      // record has been truncated, which should not happen with the fields above
+      pos = buflen;
+   }
+   buf[pos] = '}';
+   buf[pos + 1] = '\0';
+
+   WriteRecord(buf);
+}
+
+void TelemetryIterationOutput::WriteRecord(
+   const char* record
+)
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+   fputs(record, file_);
+   fputc('\n', file_);
+   fflush(file_);
+}
+
+} // namespace Ipopt
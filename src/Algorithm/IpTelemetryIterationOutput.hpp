@@ -0,0 +1,110 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPTELEMETRYITERATIONOUTPUT_HPP__
+#define __IPTELEMETRYITERATIONOUTPUT_HPP__
+
+#include "IpIterationOutput.hpp"
+
+#include <cstdio>
+
+namespace Ipopt
+{
+
+/** Iteration output that writes one machine-readable record per iteration.
+ *
+ *  Each record is a single line holding a JSON object with the
+ *  quantities of the iteration summary line (objective, inf_pr,
+ *  inf_du, mu, ||d||, regularization, step sizes), the number of
+ *  function evaluations so far, and the cumulative wallclock times
+ *  of the main algorithm phases.  Values that are not finite are
+ *  written as null.
+ *
+ *  The usual output is delegated to another IterationOutput object
+ *  that is given to the constructor.  By default, records are appended
+ *  to the file given by option iteration_telemetry_file.  Derived
+ *  classes can overwrite WriteRecord to send records elsewhere.
+ *
+ *  @since 3.15.0
+ */
+class IPOPTLIB_EXPORT TelemetryIterationOutput: public IterationOutput
+{
+public:
+   /**@name Constructors / Destructor */
+   ///@{
+   /** Constructor */
+   TelemetryIterationOutput(
+      const SmartPtr<IterationOutput>& orig_iteration_output /**< iteration output to which the usual output is delegated, can be NULL */
+   );
+
+   /** Destructor */
+   virtual ~TelemetryIterationOutput();
+   ///@}
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** Method to do all the summary output per iteration.
+    *
+    *  Calls WriteOutput of the wrapped iteration output and writes the
+    *  record for the current iteration.
+    */
+   virtual void WriteOutput();
+
+   /** Methods for OptionsList */
+   ///@{
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+   ///@}
+
+protected:
+   /** Method that receives the record of an iteration.
+    *
+    *  The record is a zero-terminated JSON object without trailing newline.
+    *  The default implementation writes it as a line into the telemetry file.
+    */
+   virtual void WriteRecord(
+      const char* record
+   );
+
+private:
+   /**@name Default Compiler Generated Methods (Hidden to avoid
+    * implicit creation/calling).
+    *
+    * These methods are not implemented
+    * and we do not want the compiler to implement them for us, so we
+    * declare them private and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   TelemetryIterationOutput();
+
+   /** Copy Constructor */
+   TelemetryIterationOutput(
+      const TelemetryIterationOutput&
+   );
+
+   /** Overloaded Assignment Operator */
+   void operator=(
+      const TelemetryIterationOutput&
+   );
+   ///@}
+
+   /** Iteration output for the usual summary line */
+   SmartPtr<IterationOutput> orig_iteration_output_;
+
+   /** Option indication what should be written as inf_pr */
+   InfPrOutput inf_pr_output_;
+
+   /** File into which records are written, NULL if not open */
+   FILE* file_;
+};
+
+} // namespace Ipopt
+
+#endif
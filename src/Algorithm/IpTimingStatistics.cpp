@@ -155,6 +155,90 @@ void TimingStatistics::ResetTimes()
    h_eval_time_.Reset();
 }
 
+void TimingStatistics::SetWallclockOnly(
+   bool wallclock_only
+)
+{
+   wallclock_only_ = wallclock_only;
+   PrintProblemStatistics_.SetWallclockOnly(wallclock_only);
+   InitializeIterates_.SetWallclockOnly(wallclock_only);
+   UpdateHessian_.SetWallclockOnly(wallclock_only);
+   OutputIteration_.SetWallclockOnly(wallclock_only);
+   UpdateBarrierParameter_.SetWallclockOnly(wallclock_only);
+   ComputeSearchDirection_.SetWallclockOnly(wallclock_only);
+   ComputeAcceptableTrialPoint_.SetWallclockOnly(wallclock_only);
+   AcceptTrialPoint_.SetWallclockOnly(wallclock_only);
+   CheckConvergence_.SetWallclockOnly(wallclock_only);
+   PDSystemSolverTotal_.SetWallclockOnly(wallclock_only);
+   PDSystemSolverSolveOnce_.SetWallclockOnly(wallclock_only);
+   ComputeResiduals_.SetWallclockOnly(wallclock_only);
+   StdAugSystemSolverMultiSolve_.SetWallclockOnly(wallclock_only);
+   LinearSystemScaling_.SetWallclockOnly(wallclock_only);
+   LinearSystemSymbolicFactorization_.SetWallclockOnly(wallclock_only);
+   LinearSystemFactorization_.SetWallclockOnly(wallclock_only);
+   LinearSystemBackSolve_.SetWallclockOnly(wallclock_only);
+   LinearSystemStructureConverter_.SetWallclockOnly(wallclock_only);
+   LinearSystemStructureConverterInit_.SetWallclockOnly(wallclock_only);
+   QualityFunctionSearch_.SetWallclockOnly(wallclock_only);
+   TryCorrector_.SetWallclockOnly(wallclock_only);
+   Task1_.SetWallclockOnly(wallclock_only);
+   Task2_.SetWallclockOnly(wallclock_only);
+   Task3_.SetWallclockOnly(wallclock_only);
+   Task4_.SetWallclockOnly(wallclock_only);
+   Task5_.SetWallclockOnly(wallclock_only);
+   Task6_.SetWallclockOnly(wallclock_only);
+   f_eval_time_.SetWallclockOnly(wallclock_only);
+   grad_f_eval_time_.SetWallclockOnly(wallclock_only);
+   c_eval_time_.SetWallclockOnly(wallclock_only);
+   d_eval_time_.SetWallclockOnly(wallclock_only);
+   jac_c_eval_time_.SetWallclockOnly(wallclock_only);
+   jac_d_eval_time_.SetWallclockOnly(wallclock_only);
+   h_eval_time_.SetWallclockOnly(wallclock_only);
+}
+
+void TimingStatistics::SetTrace(
+   const SmartPtr<TimingTrace>& trace
+)
+{
+   trace_ = trace;
+   TimingTrace* raw_trace = GetRawPtr(trace);
+   OverallAlgorithm_.SetTrace(raw_trace, "OverallAlgorithm");
+   PrintProblemStatistics_.SetTrace(raw_trace, "PrintProblemStatistics");
+   InitializeIterates_.SetTrace(raw_trace, "InitializeIterates");
+   UpdateHessian_.SetTrace(raw_trace, "UpdateHessian");
+   OutputIteration_.SetTrace(raw_trace, "OutputIteration");
+   UpdateBarrierParameter_.SetTrace(raw_trace, "UpdateBarrierParameter");
+   ComputeSearchDirection_.SetTrace(raw_trace, "ComputeSearchDirection");
+   ComputeAcceptableTrialPoint_.SetTrace(raw_trace, "ComputeAcceptableTrialPoint");
+   AcceptTrialPoint_.SetTrace(raw_trace, "AcceptTrialPoint");
+   CheckConvergence_.SetTrace(raw_trace, "CheckConvergence");
+   PDSystemSolverTotal_.SetTrace(raw_trace, "PDSystemSolverTotal");
+   PDSystemSolverSolveOnce_.SetTrace(raw_trace, "PDSystemSolverSolveOnce");
+   ComputeResiduals_.SetTrace(raw_trace, "ComputeResiduals");
+   StdAugSystemSolverMultiSolve_.SetTrace(raw_trace, "StdAugSystemSolverMultiSolve");
+   LinearSystemScaling_.SetTrace(raw_trace, "LinearSystemScaling");
+   LinearSystemSymbolicFactorization_.SetTrace(raw_trace, "LinearSystemSymbolicFactorization");
+   LinearSystemFactorization_.SetTrace(raw_trace, "LinearSystemFactorization");
+   LinearSystemBackSolve_.SetTrace(raw_trace, "LinearSystemBackSolve");
+   LinearSystemStructureConverter_.SetTrace(raw_trace, "LinearSystemStructureConverter");
+   LinearSystemStructureConverterInit_.SetTrace(raw_trace, "LinearSystemStructureConverterInit");
+   QualityFunctionSearch_.SetTrace(raw_trace, "QualityFunctionSearch");
+   TryCorrector_.SetTrace(raw_trace, "TryCorrector");
+   Task1_.SetTrace(raw_trace, "Task1");
+   Task2_.SetTrace(raw_trace, "Task2");
+   Task3_.SetTrace(raw_trace, "Task3");
+   Task4_.SetTrace(raw_trace, "Task4");
+   Task5_.SetTrace(raw_trace, "Task5");
+   Task6_.SetTrace(raw_trace, "Task6");
+   f_eval_time_.SetTrace(raw_trace, "ObjectiveFunction");
+   grad_f_eval_time_.SetTrace(raw_trace, "ObjectiveFunctionGradient");
+   c_eval_time_.SetTrace(raw_trace, "EqualityConstraints");
+   d_eval_time_.SetTrace(raw_trace, "InequalityConstraints");
+   jac_c_eval_time_.SetTrace(raw_trace, "EqualityConstraintJacobian");
+   jac_d_eval_time_.SetTrace(raw_trace, "InequalityConstraintJacobian");
+   h_eval_time_.SetTrace(raw_trace, "LagrangianHessian");
+}
+
 void TimingStatistics::PrintAllTimingStatistics(
    const Journalist& jnlst,
    EJournalLevel     level,
@@ -10,6 +10,8 @@
 #include "IpReferenced.hpp"
 #include "IpJournalist.hpp"
 #include "IpTimedTask.hpp"
+#include "IpTimingTrace.hpp"
+#include "IpSmartPtr.hpp"
 
 namespace Ipopt
 {
@@ -22,6 +24,7 @@ public:
    ///@{
    /** Default constructor. */
    TimingStatistics()
+      : wallclock_only_(false)
    { }
 
    /** Destructor */
@@ -55,6 +58,54 @@ public:
     */
    void DisableTimes();
 
+   /** Measure only wallclock time for all timed tasks except for OverallAlgorithm.
+    *
+    *  This saves system calls if the CPU and system times of the tasks
+    *  are not needed, e.g., since the timing statistics are not printed.
+    *  @since 3.15.0
+    */
+   void SetWallclockOnly(
+      bool wallclock_only
+   );
+
+   /** Whether only wallclock time is measured for the timed tasks except for OverallAlgorithm
+    *  @since 3.15.0
+    */
+   bool IsWallclockOnly() const
+   {
+      return wallclock_only_;
+   }
+
+   /** Record all executions of timed tasks in the given trace.
+    *
+    *  Pass NULL to stop recording.
+    *  @since 3.15.0
+    */
+   void SetTrace(
+      const SmartPtr<TimingTrace>& trace
+   );
+
+   /** Trace that executions of timed tasks are recorded in, or NULL.
+    *  @since 3.15.0
+    */
+   SmartPtr<TimingTrace> Trace() const
+   {
+      return trace_;
+   }
+
+   /** Set the iteration number that is stored with subsequently recorded task executions.
+    *  @since 3.15.0
+    */
+   void SetTraceIteration(
+      Index iter
+   )
+   {
+      if( IsValid(trace_) )
+      {
+         trace_->SetIteration(iter);
+      }
+   }
+
    /** Method for printing all timing information */
    void PrintAllTimingStatistics(
       const Journalist& jnlst,
@@ -316,6 +367,12 @@ private:
    TimedTask jac_d_eval_time_;
    TimedTask h_eval_time_;
    ///@}
+
+   /** Whether only wallclock time is measured for the tasks except for OverallAlgorithm */
+   bool wallclock_only_;
+
+   /** Trace that task executions are recorded in, if valid */
+   SmartPtr<TimingTrace> trace_;
 };
 
 } // namespace Ipopt
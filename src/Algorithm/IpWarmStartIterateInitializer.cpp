@@ -126,7 +126,37 @@ bool WarmStartIterateInitializer::SetInitialIterates()
    SmartPtr<IteratesVector> init_vec;
    bool have_iterate = false;
 
-   if( warm_start_entire_iterate_ )
+   // Use the iterate of a previous run, if available; it is taken
+   // as it is, apart from the push of the variables away from the
+   // bounds below
+   SmartPtr<const SolverState> state = IpData().WarmStartState();
+   if( IsValid(state) && state->HasIterate() )
+   {
+      // the NLP is asked for x only, as for a cold start, since not every NLP can skip that
+      if( !IpData().InitializeDataStructures(IpNLP(), true, false, false, false, false) )
+      {
+         return false;
+      }
+
+      init_vec = IpData().curr()->MakeNewIteratesVector(true);
+
+      have_iterate = GetSnapshotIterate(IpNLP(), *state, *init_vec);
+
+      if( !have_iterate )
+      {
+         Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                        "Iterate of previous run does not fit to the problem or its scaling, ignoring it.\n");
+      }
+   }
+   if( IsValid(state) && !have_iterate )
+   {
+      // the barrier parameter, perturbations, and quasi-Newton pairs of the
+      // previous run only make sense together with its iterate
+      IpData().SetWarmStartState(NULL);
+      state = NULL;
+   }
+
+   if( !have_iterate && warm_start_entire_iterate_ )
    {
       if( !IpData().InitializeDataStructures(IpNLP(), false, false, false, false, false) )
       {
@@ -346,6 +376,13 @@ bool WarmStartIterateInitializer::SetInitialIterates()
    IpData().set_trial(init_vec);
    IpData().AcceptTrialPoint();
 
+   // Continue with the barrier parameter of a previous run
+   if( IsValid(state) && state->HasBarrierParameter() )
+   {
+      IpData().Set_mu(state->Mu());
+      IpData().Set_tau(state->Tau());
+   }
+
    IpData().curr()->x()->Print(Jnlst(), J_VECTOR, J_INITIALIZATION, "initial x");
    IpData().curr()->s()->Print(Jnlst(), J_VECTOR, J_INITIALIZATION, "initial s");
    IpData().curr()->y_c()->Print(Jnlst(), J_VECTOR, J_INITIALIZATION, "initial y_c");
@@ -365,6 +402,70 @@ bool WarmStartIterateInitializer::SetInitialIterates()
    return true;
 }
 
+/** checks whether scaling factors agree, where missing factors of a snapshot are taken as one */
+static bool SameScalingFactors(
+   const Vector& curr_factors,
+   Vector&       state_factors,
+   bool          have_state_factors
+)
+{
+   if( !have_state_factors )
+   {
+      state_factors.Set(1.);
+   }
+   state_factors.Axpy(-1., curr_factors);
+   return state_factors.Amax() == 0.;
+}
+
+bool WarmStartIterateInitializer::GetSnapshotIterate(
+   IpoptNLP&          ip_nlp,
+   const SolverState& state,
+   IteratesVector&    iterate
+)
+{
+   if( !state.HasIterate() || !state.GetIterate(iterate) )
+   {
+      return false;
+   }
+
+   // the iterate is stored in the scaled problem, so it can only be used with the same scaling
+   if( state.HasScaling() && !state.ScalingMatches(iterate.x()->Dim(), iterate.y_c()->Dim(), iterate.y_d()->Dim()) )
+   {
+      return false;
+   }
+
+   // the current scaling factors are obtained by scaling vectors of ones, as when the snapshot was stored
+   SmartPtr<NLPScalingObject> scaling = ip_nlp.NLP_scaling();
+   if( scaling->apply_obj_scaling(1.) != (state.HasScaling() ? state.ObjScaling() : 1.) )
+   {
+      return false;
+   }
+
+   SmartPtr<Vector> ones = iterate.x()->MakeNew();
+   ones->Set(1.);
+   SmartPtr<Vector> factors = iterate.x()->MakeNew();
+   bool have_factors = state.GetXScaling(*factors);
+   if( !SameScalingFactors(*scaling->apply_vector_scaling_x(ConstPtr(ones)), *factors, have_factors) )
+   {
+      return false;
+   }
+
+   ones = iterate.y_c()->MakeNew();
+   ones->Set(1.);
+   factors = iterate.y_c()->MakeNew();
+   have_factors = state.GetCScaling(*factors);
+   if( !SameScalingFactors(*scaling->apply_vector_scaling_c(ConstPtr(ones)), *factors, have_factors) )
+   {
+      return false;
+   }
+
+   ones = iterate.y_d()->MakeNew();
+   ones->Set(1.);
+   factors = iterate.y_d()->MakeNew();
+   have_factors = state.GetDScaling(*factors);
+   return SameScalingFactors(*scaling->apply_vector_scaling_d(ConstPtr(ones)), *factors, have_factors);
+}
+
 void WarmStartIterateInitializer::process_target_mu(
    Number                  factor,
    const Vector&           curr_vars,
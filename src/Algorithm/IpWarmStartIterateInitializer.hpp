@@ -37,6 +37,23 @@ public:
     */
    virtual bool SetInitialIterates();
 
+   /** Get the iterate of a snapshot of a previous run, if it fits to the problem.
+    *
+    *  The iterate must fit in its dimensions, and the scaling of the
+    *  problem must be the one with which the iterate was stored.
+    *
+    *  @param ip_nlp   problem with initialized scaling
+    *  @param state    snapshot of a previous run
+    *  @param iterate  new iterates vector for the problem, gets the iterate of the snapshot
+    *  @return whether the iterate fits to the problem
+    *  @since 3.15.0
+    */
+   static bool GetSnapshotIterate(
+      IpoptNLP&          ip_nlp,
+      const SolverState& state,
+      IteratesVector&    iterate
+   );
+
    static void RegisterOptions(
       SmartPtr<RegisteredOptions> roptions
    );
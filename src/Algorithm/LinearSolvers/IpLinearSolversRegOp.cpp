@@ -9,6 +9,7 @@
 #include "IpLinearSolvers.h"
 #include "IpRegOptions.hpp"
 #include "IpTSymLinearSolver.hpp"
+#include "IpRuizTSymScalingMethod.hpp"
 
 #include "IpMa27TSolverInterface.hpp"
 #include "IpMa57TSolverInterface.hpp"
@@ -40,6 +41,7 @@ void RegisterOptions_LinearSolvers(
 {
    roptions->SetRegisteringCategory("Linear Solver");
    TSymLinearSolver::RegisterOptions(roptions);
+   RuizTSymScalingMethod::RegisterOptions(roptions);
 
    IpoptLinearSolver availablesolvers = IpoptGetAvailableLinearSolvers(false);
 
@@ -459,6 +459,11 @@ ESymSolverStatus MumpsSolverInterface::Factorization(
    const std::lock_guard<std::mutex> lock(mumps_call_mutex);
 #endif
 
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemFactorization().Start();
+   }
+
    mumps_data->job = 2;  //numerical factorization
 
    dump_matrix(mumps_data);
@@ -498,10 +503,19 @@ ESymSolverStatus MumpsSolverInterface::Factorization(
       {
          Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
                         "MUMPS was not able to obtain enough memory.\n");
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().LinearSystemFactorization().End();
+         }
          return SYMSOLVER_FATAL_ERROR;
       }
    }
 
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemFactorization().End();
+   }
+
    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                   "Number of doubles for MUMPS to hold factorization (INFO(9)) = %" IPOPT_INDEX_FORMAT "\n", mumps_data->info[8]);
    Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
@@ -0,0 +1,274 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpRuizTSymScalingMethod.hpp"
+#include "IpThreads.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** computes the maxima of the absolute values of the scaled nonzeros begin,...,end-1 in each row
+ *
+ *  Only one triangle of the symmetric matrix is given, so each
+ *  off-diagonal entry counts for its row and its column.
+ *  Row indices are 1-based.  row_max needs to be initialized to zero.
+ */
+static void ComputeScaledSymMaxima(
+   Index         begin,
+   Index         end,
+   const Index*  airn,
+   const Index*  ajcn,
+   const Number* a,
+   const Number* scaling_factors,
+   Number*       row_max
+)
+{
+   for( Index k = begin; k < end; k++ )
+   {
+      const Index i = airn[k] - 1;
+      const Index j = ajcn[k] - 1;
+      const Number v = std::abs(a[k]) * scaling_factors[i] * scaling_factors[j];
+      if( v > row_max[i] )
+      {
+         row_max[i] = v;
+      }
+      if( v > row_max[j] )
+      {
+         row_max[j] = v;
+      }
+   }
+}
+
+/** calls ComputeScaledSymMaxima for one block of the nonzeros per part
+ *
+ *  The maxima of block k are written to row_max + k*n.
+ */
+class ComputeScaledSymMaximaWork: public ParallelWork
+{
+public:
+   ComputeScaledSymMaximaWork(
+      Index         nblocks,
+      Index         n,
+      Index         nnz,
+      const Index*  airn,
+      const Index*  ajcn,
+      const Number* a,
+      const Number* scaling_factors,
+      Number*       row_max
+   )
+      : block_size_((nnz + nblocks - 1) / nblocks),
+        n_(n),
+        nnz_(nnz),
+        airn_(airn),
+        ajcn_(ajcn),
+        a_(a),
+        scaling_factors_(scaling_factors),
+        row_max_(row_max)
+   { }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      ComputeScaledSymMaxima(std::min(k * block_size_, nnz_), std::min((k + 1) * block_size_, nnz_), airn_, ajcn_, a_,
+                             scaling_factors_, row_max_ + k * n_);
+   }
+
+private:
+   Index         block_size_;
+   Index         n_;
+   Index         nnz_;
+   const Index*  airn_;
+   const Index*  ajcn_;
+   const Number* a_;
+   const Number* scaling_factors_;
+   Number*       row_max_;
+};
+
+RuizTSymScalingMethod::RuizTSymScalingMethod()
+   : last_dim_(-1),
+     last_scaling_factors_(NULL),
+     row_max_size_(0),
+     row_max_(NULL)
+{ }
+
+RuizTSymScalingMethod::~RuizTSymScalingMethod()
+{
+   delete[] last_scaling_factors_;
+   delete[] row_max_;
+}
+
+void RuizTSymScalingMethod::RegisterOptions(
+   const SmartPtr<RegisteredOptions>& roptions
+)
+{
+   roptions->AddLowerBoundedIntegerOption(
+      "linear_system_scaling_ruiz_max_iter",
+      "Maximum number of iterations of Ruiz scaling for the linear system.",
+      1,
+      10,
+      "Each iteration divides every row and column of the augmented system by the square root of its largest entry. "
+      "This option is only used if \"linear_system_scaling\" is chosen as \"ruiz\".",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "linear_system_scaling_ruiz_tol",
+      "Tolerance for Ruiz scaling of the linear system.",
+      0., true,
+      1e-1,
+      "The iterations of Ruiz scaling stop when the largest entry in every nonzero row of the scaled augmented system "
+      "deviates from one by at most this value. "
+      "This option is only used if \"linear_system_scaling\" is chosen as \"ruiz\".",
+      true);
+   roptions->AddBoolOption(
+      "linear_system_scaling_ruiz_reuse",
+      "Whether Ruiz scaling starts from the scaling factors of the previous linear system.",
+      true,
+      "If the values of the augmented system change only a little, the previous scaling factors are often still "
+      "acceptable, so that a single pass over the matrix is sufficient. "
+      "This option is only used if \"linear_system_scaling\" is chosen as \"ruiz\".",
+      true);
+}
+
+bool RuizTSymScalingMethod::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetIntegerValue("linear_system_scaling_ruiz_max_iter", max_iter_, prefix);
+   options.GetNumericValue("linear_system_scaling_ruiz_tol", tol_, prefix);
+   options.GetBoolValue("linear_system_scaling_ruiz_reuse", reuse_, prefix);
+   // The option num_threads is registered by IpoptApplication
+   options.GetIntegerValue("num_threads", num_threads_, prefix);
+
+   delete[] last_scaling_factors_;
+   last_scaling_factors_ = NULL;
+   last_dim_ = -1;
+
+   return true;
+}
+
+bool RuizTSymScalingMethod::ComputeSymTScalingFactors(
+   Index         n,
+   Index         nnz,
+   const Index*  airn,
+   const Index*  ajcn,
+   const Number* a,
+   Number*       scaling_factors
+)
+{
+   DBG_START_METH("RuizTSymScalingMethod::ComputeSymTScalingFactors",
+                  dbg_verbosity);
+
+   if( reuse_ && last_dim_ == n )
+   {
+      std::copy(last_scaling_factors_, last_scaling_factors_ + n, scaling_factors);
+   }
+   else
+   {
+      std::fill(scaling_factors, scaling_factors + n, 1.);
+   }
+
+   const Index nblocks = NumWorkThreads(num_threads_, nnz);
+   // maxima of the rows for each block, one after the other
+   if( row_max_size_ < nblocks * n )
+   {
+      delete[] row_max_;
+      row_max_size_ = nblocks * n;
+      row_max_ = new Number[row_max_size_];
+   }
+   Number* row_max = row_max_;
+   ComputeScaledSymMaximaWork work(nblocks, n, nnz, airn, ajcn, a, scaling_factors, row_max);
+
+   Index iter = 0;
+   Number deviation = 0.;
+   for( ; iter < max_iter_; iter++ )
+   {
+      std::fill(row_max, row_max + nblocks * n, 0.);
+      DoParallelWork(nblocks, work);
+      for( Index k = 1; k < nblocks; k++ )
+      {
+         for( Index i = 0; i < n; i++ )
+         {
+            row_max[i] = Max(row_max[i], row_max[k * n + i]);
+         }
+      }
+
+      deviation = 0.;
+      for( Index i = 0; i < n; i++ )
+      {
+         if( row_max[i] > 0. )
+         {
+            deviation = Max(deviation, std::abs(1. - row_max[i]));
+         }
+      }
+      if( deviation <= tol_ )
+      {
+         break;
+      }
+
+      for( Index i = 0; i < n; i++ )
+      {
+         if( row_max[i] > 0. )
+         {
+            scaling_factors[i] /= std::sqrt(row_max[i]);
+         }
+      }
+   }
+
+   Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                  "Ruiz scaling of linear system: %" IPOPT_INDEX_FORMAT " iterations, largest deviation of row maxima from one %e (%" IPOPT_INDEX_FORMAT " threads).\n",
+                  iter, deviation, nblocks);
+
+   // If some of the entries in a are too large or not finite, the
+   // scaling factors are invalid.  Here, we check for this and return
+   // no scaling factors if that is the case
+   Number sum = 0.;
+   Number smin = 1.;
+   Number smax = 0.;
+   for( Index i = 0; i < n; i++ )
+   {
+      sum += scaling_factors[i];
+      smin = Min(smin, scaling_factors[i]);
+      smax = Max(smax, scaling_factors[i]);
+   }
+   if( !IsFiniteNumber(sum) || smax > 1e40 || smin < 1e-40 )
+   {
+      Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                     "Scaling factors are invalid - setting them all to 1.\n");
+      std::fill(scaling_factors, scaling_factors + n, 1.);
+      last_dim_ = -1;
+      return true;
+   }
+
+   if( reuse_ )
+   {
+      if( last_dim_ != n )
+      {
+         delete[] last_scaling_factors_;
+         last_scaling_factors_ = new Number[n];
+         last_dim_ = n;
+      }
+      std::copy(scaling_factors, scaling_factors + n, last_scaling_factors_);
+   }
+
+   if( DBG_VERBOSITY() >= 2 )
+   {
+      for( Index i = 0; i < n; i++ )
+      {
+         DBG_PRINT((2, "scaling_factors[%5" IPOPT_INDEX_FORMAT "] = %23.15e\n",
+                    i, scaling_factors[i]));
+      }
+   }
+
+   return true;
+}
+
+} // namespace Ipopt
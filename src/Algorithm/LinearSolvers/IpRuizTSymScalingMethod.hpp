@@ -0,0 +1,104 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPRUIZTSYMSCALINGMETHOD_HPP__
+#define __IPRUIZTSYMSCALINGMETHOD_HPP__
+
+#include "IpUtils.hpp"
+#include "IpTSymScalingMethod.hpp"
+
+namespace Ipopt
+{
+
+/** Class for the method for computing scaling factors for symmetric
+ *  matrices in triplet format by symmetric Ruiz equilibration.
+ *
+ *  In each iteration, every row (and column) of the symmetric matrix is
+ *  divided by the square root of its largest absolute entry, until all
+ *  these entries are close to one.  For large matrices, the nonzeros can
+ *  be processed in blocks in separate threads (see option num_threads).
+ *
+ *  The scaling factors of the previous call are kept and, if the
+ *  dimension of the matrix did not change, used as starting point for
+ *  the iterations.  If the values of the matrix changed only a little,
+ *  a single pass over the nonzeros is then sufficient.
+ *
+ *  @since 3.15.0
+ */
+class RuizTSymScalingMethod: public TSymScalingMethod
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   RuizTSymScalingMethod();
+
+   virtual ~RuizTSymScalingMethod();
+   ///@}
+
+   /** Register the options for this class */
+   static void RegisterOptions(
+      const SmartPtr<RegisteredOptions>& roptions
+   );
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** Method for computing the symmetric scaling factors, given the
+    *  symmetric matrix in triplet (MA27) format.
+    */
+   virtual bool ComputeSymTScalingFactors(
+      Index         n,
+      Index         nnz,
+      const Index*  airn,
+      const Index*  ajcn,
+      const Number* a,
+      Number*       scaling_factors
+   );
+
+private:
+   /**@name Default Compiler Generated Methods (Hidden to avoid
+    * implicit creation/calling).  These methods are not implemented
+    * and we do not want the compiler to implement them for us, so we
+    * declare them private and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   RuizTSymScalingMethod(
+      const RuizTSymScalingMethod&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const RuizTSymScalingMethod&
+   );
+   ///@}
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** maximal number of equilibration iterations */
+   Index max_iter_;
+   /** tolerance for the deviation of the largest entries from one */
+   Number tol_;
+   /** whether the scaling factors of the previous call are used as starting point */
+   bool reuse_;
+   /** maximal number of threads */
+   Index num_threads_;
+   ///@}
+
+   /** Dimension of the matrix of the previous call, or -1 if there are no previous scaling factors */
+   Index last_dim_;
+   /** Scaling factors of the previous call */
+   Number* last_scaling_factors_;
+
+   /** Length of row_max_ */
+   Index row_max_size_;
+   /** Row maxima for each block of nonzeros, one after the other; kept to avoid an allocation per call */
+   Number* row_max_;
+};
+
+} // namespace Ipopt
+
+#endif
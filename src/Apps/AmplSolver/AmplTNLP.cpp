@@ -195,6 +195,9 @@ AmplTNLP::AmplTNLP(
      g_sol_(NULL),
      lambda_sol_(NULL),
      obj_sol_(0.0),
+     obj_val_cache_(0.0),
+     g_cache_(NULL),
+     hess_obj_weights_(NULL),
      objval_called_with_current_x_(false),
      conval_called_with_current_x_(false),
      hesset_called_(false),
@@ -231,6 +234,9 @@ AmplTNLP::AmplTNLP(
      g_sol_(NULL),
      lambda_sol_(NULL),
      obj_sol_(0.0),
+     obj_val_cache_(0.0),
+     g_cache_(NULL),
+     hess_obj_weights_(NULL),
      objval_called_with_current_x_(false),
      conval_called_with_current_x_(false),
      hesset_called_(false),
@@ -345,6 +351,10 @@ AmplTNLP::~AmplTNLP()
    g_sol_ = NULL;
    delete[] lambda_sol_;
    lambda_sol_ = NULL;
+   delete[] g_cache_;
+   g_cache_ = NULL;
+   delete[] hess_obj_weights_;
+   hess_obj_weights_ = NULL;
 
    if( Oinfo_ptr_ )
    {
@@ -731,18 +741,23 @@ bool AmplTNLP::eval_h(
       {
          return false;
       }
+      // sphes requires that objective and constraints have been
+      // evaluated at x; values cached for the current x are not recomputed
       if( !objval_called_with_current_x_ )
       {
          Number dummy;
          internal_objval(x, dummy);
-         internal_conval(x, m);
       }
       if( !conval_called_with_current_x_ )
       {
          internal_conval(x, m);
       }
 
-      real* OW = new real[Max(1, n_obj)];
+      if( hess_obj_weights_ == NULL )
+      {
+         hess_obj_weights_ = new Number[Max(1, n_obj)];
+      }
+      real* OW = hess_obj_weights_;
       if( n_obj > 0 )
       {
          for( Index i = 0; i < n_obj; i++ )
@@ -752,7 +767,6 @@ bool AmplTNLP::eval_h(
          OW[obj_no] = obj_sign_ * obj_factor;
       }
       sphes(values, -1, OW, const_cast<Number*>(lambda));
-      delete[] OW;
       return true;
    }
    else
@@ -903,11 +917,17 @@ bool AmplTNLP::internal_objval(
                   dbg_verbosity);
    ASL_pfgh* asl = asl_;
    DBG_ASSERT(asl);
-   objval_called_with_current_x_ = false; // in case the call below fails
+
+   if( objval_called_with_current_x_ )
+   {
+      obj_val = obj_val_cache_;
+      return true;
+   }
 
    if( n_obj == 0 )
    {
       obj_val = 0;
+      obj_val_cache_ = obj_val;
       objval_called_with_current_x_ = true;
       return true;
    }
@@ -917,6 +937,7 @@ bool AmplTNLP::internal_objval(
       if( nerror_ok(nerror_) )
       {
          obj_val = obj_sign_ * retval;
+         obj_val_cache_ = obj_val;
          objval_called_with_current_x_ = true;
          return true;
       }
@@ -936,27 +957,33 @@ bool AmplTNLP::internal_conval(
    ASL_pfgh* asl = asl_;
    DBG_ASSERT(asl);
    DBG_ASSERT(m == n_con);
-   conval_called_with_current_x_ = false; // in case the call below fails
 
-   bool allocated = false;
-   if( !g )
+   if( m == 0 )
    {
-      g = new Number[m];
-      allocated = true;
+      conval_called_with_current_x_ = true;
+      return true;
    }
-   conval(const_cast<Number*>(x), g, (fint* )nerror_);
 
-   if( allocated )
+   if( !conval_called_with_current_x_ )
    {
-      delete[] g;
+      // all constraints are evaluated in one call and kept for the current x
+      if( g_cache_ == NULL )
+      {
+         g_cache_ = new Number[m];
+      }
+      conval(const_cast<Number*>(x), g_cache_, (fint* )nerror_);
+      if( !nerror_ok(nerror_) )
+      {
+         return false;
+      }
+      conval_called_with_current_x_ = true;
    }
 
-   if( nerror_ok(nerror_) )
+   if( g )
    {
-      conval_called_with_current_x_ = true;
-      return true;
+      IpBlasCopy(m, g_cache_, 1, g, 1);
    }
-   return false;
+   return true;
 }
 
 bool AmplTNLP::apply_new_x(
@@ -661,15 +661,28 @@ protected:
    Number  obj_sol_;
    ///@}
 
+   /**@name Values computed at the current x */
+   ///@{
+   /** objective value, valid if objval_called_with_current_x_ is true */
+   Number obj_val_cache_;
+   /** constraint values, valid if conval_called_with_current_x_ is true */
+   Number* g_cache_;
+   ///@}
+
+   /** work space for the objective weights passed to sphes */
+   Number* hess_obj_weights_;
+
    /**@name Flags to track internal state */
    ///@{
    /** whether the objective value has been calculated with the current x
     *
-    *  set to false in apply_new_x, and set to true in internal_objval
+    *  set to false in apply_new_x, and set to true in internal_objval;
+    *  while true, obj_val_cache_ holds the objective value
     */
    bool objval_called_with_current_x_;
    /** whether the constraint values have been calculated with the current x
-    *  set to false in apply_new_x, and set to true in internal_conval
+    *  set to false in apply_new_x, and set to true in internal_conval;
+    *  while true, g_cache_ holds the constraint values
     */
    bool conval_called_with_current_x_;
    /** whether we have called hesset */
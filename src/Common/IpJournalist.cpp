@@ -11,6 +11,15 @@
 #include <cstdio>
 #include <cstring>
 
+#if __cplusplus >= 201103L
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#endif
+
 namespace Ipopt
 {
 
@@ -374,16 +383,159 @@ void Journal::SetAllPrintLevels(
 //                 Implementation of the FileJournal class               //
 ///////////////////////////////////////////////////////////////////////////
 
+#if __cplusplus >= 201103L
+/** Writes output to a file in a separate thread.
+ *
+ *  The output is kept in a ring buffer until the thread has written it.
+ */
+class FileJournalWriter
+{
+public:
+   /** Constructor, starts the thread.
+    *
+    *  Throws std::system_error if the thread cannot be started.
+    */
+   FileJournalWriter(
+      FILE*  file,
+      size_t capacity
+   )
+      : file_(file),
+        ring_(capacity),
+        head_(0),
+        tail_(0),
+        stop_(false)
+   {
+      thread_ = std::thread(&FileJournalWriter::Run, this);
+   }
+
+   /** Destructor, waits until everything has been written and stops the thread. */
+   ~FileJournalWriter()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         stop_ = true;
+      }
+      cond_.notify_all();
+      thread_.join();
+   }
+
+   /** Append output to the ring buffer, waiting for space if it is full. */
+   void Append(
+      const char* str,
+      size_t      len
+   )
+   {
+      const size_t capacity = ring_.size();
+      while( len > 0 )
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         while( head_ - tail_ == capacity )
+         {
+            cond_.wait(lock);
+         }
+         const size_t chunk = std::min(len, capacity - (head_ - tail_));
+         const size_t start = head_ % capacity;
+         const size_t first = std::min(chunk, capacity - start);
+         memcpy(&ring_[start], str, first);
+         memcpy(&ring_[0], str + first, chunk - first);
+         head_ += chunk;
+         str += chunk;
+         len -= chunk;
+         lock.unlock();
+         cond_.notify_all();
+      }
+   }
+
+   /** Wait until everything in the ring buffer has been written. */
+   void Drain()
+   {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while( tail_ != head_ )
+      {
+         cond_.wait(lock);
+      }
+   }
+
+private:
+   /** Default Constructor */
+   FileJournalWriter();
+
+   /** Copy Constructor */
+   FileJournalWriter(
+      const FileJournalWriter&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const FileJournalWriter&
+   );
+
+   /** Loop of the thread: write whatever is in the ring buffer */
+   void Run()
+   {
+      const size_t capacity = ring_.size();
+      std::unique_lock<std::mutex> lock(mutex_);
+      while( true )
+      {
+         while( tail_ == head_ && !stop_ )
+         {
+            cond_.wait(lock);
+         }
+         if( tail_ == head_ )
+         {
+            // stopped and everything written
+            return;
+         }
+         // the part up to the end of the ring buffer can be written without holding the lock
+         const size_t start = tail_ % capacity;
+         const size_t len = std::min(head_ - tail_, capacity - start);
+         lock.unlock();
+         fwrite(&ring_[start], 1, len, file_);
+         lock.lock();
+         tail_ += len;
+         cond_.notify_all();
+      }
+   }
+
+   /** FILE pointer for the output destination */
+   FILE* file_;
+
+   /** the ring buffer */
+   std::vector<char> ring_;
+   /** number of characters appended so far */
+   size_t head_;
+   /** number of characters written so far */
+   size_t tail_;
+   /** whether the thread should stop once everything has been written */
+   bool stop_;
+
+   std::mutex mutex_;
+   /** signals changes of head_, tail_, or stop_ */
+   std::condition_variable cond_;
+   std::thread thread_;
+};
+#endif
+
 FileJournal::FileJournal(
    const std::string& name,
    EJournalLevel      default_level
 )
    : Journal(name, default_level),
-     file_(NULL)
+     file_(NULL),
+     buffer_(NULL),
+     buffer_size_(0),
+     buffer_len_(0),
+     background_writer_(false),
+     writer_(NULL)
 { }
 
 FileJournal::~FileJournal()
 {
+   WriteBuffer();
+   StopWriter();
+   delete[] buffer_;
+   buffer_ = NULL;
+
    if( file_ && file_ != stdout && file_ != stderr )
    {
       // close the file
@@ -394,6 +546,9 @@ FileJournal::~FileJournal()
 
 bool FileJournal::Open(const char* fname)
 {
+   WriteBuffer();
+   StopWriter();
+
    if( file_ && file_ != stdout && file_ != stderr )
    {
       // file already opened, close it
@@ -404,24 +559,113 @@ bool FileJournal::Open(const char* fname)
    if( strcmp("stdout", fname) == 0 )
    {
       file_ = stdout;
-      return true;
    }
    else if( strcmp("stderr", fname) == 0 )
    {
       file_ = stderr;
-      return true;
    }
    else
    {
       // open the file on disk
       file_ = fopen(fname, "w+");
+      if( !file_ )
+      {
+         return false;
+      }
+   }
+
+   StartWriter();
+   return true;
+}
+
+void FileJournal::SetBufferSize(
+   Index buffer_size
+)
+{
+   DBG_ASSERT(buffer_size >= 0);
+   WriteBuffer();
+   StopWriter();
+   if( buffer_size != buffer_size_ )
+   {
+      delete[] buffer_;
+      buffer_ = NULL;
+      buffer_size_ = 0;
+#if defined(HAVE_VSNPRINTF) && defined(IPOPT_HAS_VA_COPY)
+      // buffering requires vsnprintf, otherwise output is written immediately
+      if( buffer_size > 0 )
+      {
+         buffer_ = new char[buffer_size];
+         buffer_size_ = buffer_size;
+      }
+#endif
+   }
+   StartWriter();
+}
+
+void FileJournal::SetBackgroundWriter(
+   bool background_writer
+)
+{
+   WriteBuffer();
+   StopWriter();
+   background_writer_ = background_writer;
+   StartWriter();
+}
+
+void FileJournal::StartWriter()
+{
+#if __cplusplus >= 201103L
+   if( background_writer_ && buffer_size_ > 0 && file_ && writer_ == NULL )
+   {
+      try
+      {
+         writer_ = new FileJournalWriter(file_, 4 * (size_t) buffer_size_);
+      }
+      catch( const std::system_error& )
+      {
+         // no thread available, so output is written in the calling thread
+         writer_ = NULL;
+      }
+   }
+#endif
+}
+
+void FileJournal::StopWriter()
+{
+#if __cplusplus >= 201103L
+   delete writer_;
+   writer_ = NULL;
+#endif
+}
+
+void FileJournal::WriteBuffer()
+{
+   if( buffer_len_ > 0 )
+   {
+#if __cplusplus >= 201103L
+      if( writer_ != NULL )
+      {
+         writer_->Append(buffer_, buffer_len_);
+         buffer_len_ = 0;
+         return;
+      }
+#endif
       if( file_ )
       {
-         return true;
+         fwrite(buffer_, 1, buffer_len_, file_);
       }
+      buffer_len_ = 0;
    }
+}
 
-   return false;
+void FileJournal::DrainWriter()
+{
+#if __cplusplus >= 201103L
+   if( writer_ != NULL )
+   {
+      writer_->Drain();
+   }
+#endif
 }
 
 void FileJournal::PrintImpl(
@@ -433,6 +677,22 @@ void FileJournal::PrintImpl(
    DBG_START_METH("Journal::Print", 0);
    if( file_ )
    {
+      if( buffer_size_ > 0 )
+      {
+         Index len = (Index) strlen(str);
+         if( buffer_len_ + len > buffer_size_ )
+         {
+            WriteBuffer();
+         }
+         if( len <= buffer_size_ )
+         {
+            memcpy(buffer_ + buffer_len_, str, len);
+            buffer_len_ += len;
+            return;
+         }
+         // longer than the buffer, so it is written directly after everything before
+         DrainWriter();
+      }
       fprintf(file_, "%s", str);
       DBG_EXEC(0, fflush(file_));
    }
@@ -448,6 +708,31 @@ void FileJournal::PrintfImpl(
    DBG_START_METH("Journal::Printf", 0);
    if( file_ )
    {
+#if defined(HAVE_VSNPRINTF) && defined(IPOPT_HAS_VA_COPY)
+      if( buffer_size_ > 0 )
+      {
+         // try to format into the remaining space of the buffer
+         va_list apcopy;
+         va_copy(apcopy, ap);
+         int len = vsnprintf(buffer_ + buffer_len_, buffer_size_ - buffer_len_, pformat, apcopy);
+         va_end(apcopy);
+         if( len >= 0 && buffer_len_ + len < buffer_size_ )
+         {
+            buffer_len_ += len;
+            return;
+         }
+         // did not fit: write buffer to file and try again with the full buffer
+         WriteBuffer();
+         if( len >= 0 && len < buffer_size_ )
+         {
+            vsnprintf(buffer_, buffer_size_, pformat, ap);
+            buffer_len_ = len;
+            return;
+         }
+         // longer than the buffer, so it is written directly after everything before
+         DrainWriter();
+      }
+#endif
       vfprintf(file_, pformat, ap);
       DBG_EXEC(0, fflush(file_));
    }
@@ -455,6 +740,8 @@ void FileJournal::PrintfImpl(
 
 void FileJournal::FlushBufferImpl()
 {
+   WriteBuffer();
+   DrainWriter();
    if( file_ )
    {
       fflush(file_);
@@ -24,6 +24,7 @@ namespace Ipopt
 // forward declarations
 class Journal;
 class FileJournal;
+class FileJournalWriter;
 
 /**@name Journalist Enumerations. */
 ///@{
@@ -435,6 +436,35 @@ public:
       const char* fname
    );
 
+   /** Collect output in a buffer of the given size (in bytes).
+    *
+    *  Buffered output is written to the file when the buffer is full
+    *  or when FlushBuffer is called, so that high print levels do not
+    *  require a write operation for each line.
+    *  A size of 0 disables buffering.
+    *
+    *  @since 3.15.0
+    */
+   virtual void SetBufferSize(
+      Index buffer_size
+   );
+
+   /** Write buffered output to the file in a background thread.
+    *
+    *  If enabled and a buffer is used (see SetBufferSize), then a full
+    *  buffer is copied into a ring buffer of four times its size, from
+    *  which a separate thread writes to the file, so that output
+    *  operations do not wait for the file system.  Flushing waits until
+    *  the ring buffer has been written.  This has no effect if Ipopt has
+    *  been compiled without support for threads or if no thread can be
+    *  started.
+    *
+    *  @since 3.15.0
+    */
+   virtual void SetBackgroundWriter(
+      bool background_writer
+   );
+
 protected:
    /**@name Implementation version of Print methods
     *
@@ -485,8 +515,36 @@ private:
    );
    ///@}
 
+   /** Write content of output buffer to file, or pass it to the background writer */
+   void WriteBuffer();
+
+   /** Start the background writer, if requested and possible */
+   void StartWriter();
+
+   /** Wait until the background writer has written everything and stop it */
+   void StopWriter();
+
+   /** Wait until the background writer has written everything */
+   void DrainWriter();
+
    /** FILE pointer for the output destination */
    FILE* file_;
+
+   /**@name Output buffer, used if buffer_size_ > 0 */
+   ///@{
+   char* buffer_;
+   Index buffer_size_;
+   /** number of characters currently stored in buffer_ */
+   Index buffer_len_;
+   ///@}
+
+   /**@name Background writer */
+   ///@{
+   /** whether a background writer should be used */
+   bool background_writer_;
+   /** the background writer, if running */
+   FileJournalWriter* writer_;
+   ///@}
 };
 
 /** StreamJournal class.
@@ -9,6 +9,7 @@
 
 #include "IpUtils.hpp"
 #include <vector>
+#include <utility>
 #include <algorithm>
 
 //#define IP_DEBUG_OBSERVER
@@ -117,22 +118,13 @@ private:
    );
    ///@}
 
-   /** A list of the subjects currently being observed. */
-   std::vector<const Subject*> subjects_;
-
-   /** Private Method for Receiving Notification
-    *  should only be called by the friend class
-    *  Subject.
+   /** A list of the subjects currently being observed.
     *
-    *  This method will, in turn, call
-    *  the overloaded ReceiveNotification method
-    *  for the derived class to process.
+    *  For each subject, the position of this observer in the list of
+    *  observers of the subject is stored, so that the observer can be
+    *  detached in constant time.
     */
-   inline
-   void ProcessNotification(
-      NotifyType     notify_type,
-      const Subject* subject
-   );
+   std::vector<std::pair<const Subject*, size_t> > subjects_;
 
    friend class Subject;
 };
@@ -223,7 +215,25 @@ private:
    );
    ///@}
 
-   mutable std::vector<Observer*> observers_;
+   /** Remove the link to the observer at position pos of observers_.
+    *
+    *  The last entries of observers_ and of the list of subjects of
+    *  the observer are moved into the free positions, so that this
+    *  takes constant time.
+    */
+   inline
+   void RemoveObserverAt(
+      size_t pos
+   ) const;
+
+   /** A list of the attached observers.
+    *
+    *  For each observer, the position of this subject in the list of
+    *  subjects of the observer is stored.
+    */
+   mutable std::vector<std::pair<Observer*, size_t> > observers_;
+
+   friend class Observer;
 };
 
 /* inline methods */
@@ -235,18 +245,18 @@ inline Observer::~Observer()
    {
       for( size_t i = 0; i < subjects_.size(); ++i )
       {
-         DBG_PRINT((1, "subjects_[%zd] = %p\n", i, (const void*)subjects_[i]));
+         DBG_PRINT((1, "subjects_[%zd] = %p\n", i, (const void*)subjects_[i].first));
       }
    }
 #endif
    // Detach all subjects
-   for( size_t i = subjects_.size(); i > 0; --i )
+   while( !subjects_.empty() )
    {
 #ifdef IP_DEBUG_OBSERVER
-      DBG_PRINT((1, "About to detach subjects_[%zd] = %p\n", i, (const void*)subjects_[i - 1]));
+      DBG_PRINT((1, "About to detach subjects_[%zd] = %p\n", subjects_.size() - 1, (const void*)subjects_.back().first));
 #endif
 
-      RequestDetach(NT_All, subjects_[i - 1]);
+      subjects_.back().first->RemoveObserverAt(subjects_.back().second);
    }
 }
 
@@ -258,17 +268,10 @@ void Observer::RequestAttach(
 {
 #ifdef IP_DEBUG_OBSERVER
    DBG_START_METH("Observer::RequestAttach", dbg_verbosity);
-
-   // Add the subject to the list if it does not already exist
-   std::vector<const Subject*>::iterator attached_subject;
-   attached_subject = std::find(subjects_.begin(), subjects_.end(), subject);
-   DBG_ASSERT(attached_subject == subjects_.end());
    DBG_ASSERT(subject);
 #endif
 
-   // add the subject to the list
-   subjects_.push_back(subject);
-   // Attach the observer to the subject
+   // Attach the observer to the subject, this also adds the subject to our list
    subject->AttachObserver(notify_type, this);
 }
 
@@ -286,69 +289,22 @@ void Observer::RequestDetach(
 
    if( subject )
    {
-      std::vector<const Subject*>::iterator attached_subject;
-      attached_subject = std::find(subjects_.begin(), subjects_.end(), subject);
-#ifdef IP_DEBUG_OBSERVER
-
-      DBG_ASSERT(attached_subject != subjects_.end());
-#endif
-
-      if( attached_subject != subjects_.end() )
-      {
-#ifdef IP_DEBUG_OBSERVER
-         DBG_PRINT((1, "Removing subject: %p from the list\n", (const void*)subject));
-#endif
-
-         subjects_.erase(attached_subject);
-      }
-
-      // Detach the observer from the subject
+      // Detach the observer from the subject, this also removes the subject from our list
       subject->DetachObserver(notify_type, this);
    }
 }
 
-inline
-void Observer::ProcessNotification(
-   NotifyType     notify_type,
-   const Subject* subject
-)
-{
-#ifdef IP_DEBUG_OBSERVER
-   DBG_START_METH("Observer::ProcessNotification", dbg_verbosity);
-   DBG_ASSERT(subject);
-#endif
-
-   if( subject )
-   {
-      std::vector<const Subject*>::iterator attached_subject;
-      attached_subject = std::find(subjects_.begin(), subjects_.end(), subject);
-
-      // We must be processing a notification for a
-      // subject that was previously attached.
-#ifdef IP_DEBUG_OBSERVER
-
-      DBG_ASSERT(attached_subject != subjects_.end());
-#endif
-
-      this->ReceiveNotification(notify_type, subject);
-
-      if( notify_type == NT_BeingDestroyed )
-      {
-         // the subject is going away, remove it from our list
-         subjects_.erase(attached_subject);
-      }
-   }
-}
-
 inline Subject::~Subject()
 {
 #ifdef IP_DEBUG_OBSERVER
    DBG_START_METH("Subject::~Subject", dbg_verbosity);
 #endif
 
-   for( std::vector<Observer*>::iterator iter = observers_.begin(); iter != observers_.end(); ++iter )
+   // notify all observers and remove this subject from their lists
+   while( !observers_.empty() )
    {
-      (*iter)->ProcessNotification(Observer::NT_BeingDestroyed, this);
+      observers_.back().first->ReceiveNotification(Observer::NT_BeingDestroyed, this);
+      RemoveObserverAt(observers_.size() - 1);
    }
 }
 
@@ -364,15 +320,10 @@ void Subject::AttachObserver(
    // they must filter the notifications that they are not interested
    // in (i.e. a hub, not a router)
    DBG_ASSERT(observer);
-
-   std::vector<Observer*>::iterator attached_observer;
-   attached_observer = std::find(observers_.begin(), observers_.end(), observer);
-   DBG_ASSERT(attached_observer == observers_.end());
-
-   DBG_ASSERT(observer);
 #endif
 
-   observers_.push_back(observer);
+   observers_.push_back(std::make_pair(observer, observer->subjects_.size()));
+   observer->subjects_.push_back(std::make_pair(this, observers_.size() - 1));
 }
 
 inline
@@ -388,18 +339,50 @@ void Subject::DetachObserver(
 
    if( observer )
    {
-      std::vector<Observer*>::iterator attached_observer;
-      attached_observer = std::find(observers_.begin(), observers_.end(), observer);
+      // the list of subjects of an observer is short, so we search there
+      for( size_t i = observer->subjects_.size(); i > 0; --i )
+      {
+         if( observer->subjects_[i - 1].first == this )
+         {
+            RemoveObserverAt(observer->subjects_[i - 1].second);
+            return;
+         }
+      }
 #ifdef IP_DEBUG_OBSERVER
+      DBG_ASSERT(false && "observer is not attached to subject");
+#endif
+   }
+}
 
-      DBG_ASSERT(attached_observer != observers_.end());
+inline
+void Subject::RemoveObserverAt(
+   size_t pos
+) const
+{
+   Observer* observer = observers_[pos].first;
+   const size_t obs_pos = observers_[pos].second;
+#ifdef IP_DEBUG_OBSERVER
+   DBG_ASSERT(obs_pos < observer->subjects_.size());
+   DBG_ASSERT(observer->subjects_[obs_pos].first == this);
+   DBG_ASSERT(observer->subjects_[obs_pos].second == pos);
 #endif
 
-      if( attached_observer != observers_.end() )
-      {
-         observers_.erase(attached_observer);
-      }
+   // move the last observer into the free position
+   if( pos + 1 < observers_.size() )
+   {
+      observers_[pos] = observers_.back();
+      observers_[pos].first->subjects_[observers_[pos].second].second = pos;
+   }
+   observers_.pop_back();
+
+   // move the last subject of the observer into the free position
+   std::vector<std::pair<const Subject*, size_t> >& subjects = observer->subjects_;
+   if( obs_pos + 1 < subjects.size() )
+   {
+      subjects[obs_pos] = subjects.back();
+      subjects[obs_pos].first->observers_[subjects[obs_pos].second].second = obs_pos;
    }
+   subjects.pop_back();
 }
 
 inline
@@ -411,9 +394,9 @@ void Subject::Notify(
    DBG_START_METH("Subject::Notify", dbg_verbosity);
 #endif
 
-   for( std::vector<Observer*>::iterator iter = observers_.begin(); iter != observers_.end(); ++iter )
+   for( std::vector<std::pair<Observer*, size_t> >::iterator iter = observers_.begin(); iter != observers_.end(); ++iter )
    {
-      (*iter)->ProcessNotification(notify_type, this);
+      iter->first->ReceiveNotification(notify_type, this);
    }
 }
 
@@ -1350,6 +1350,38 @@ void RegisteredOptions::AddBoolOption(
    AddOption(option);
 }
 
+void RegisteredOptions::AddOptionsCopy(
+   const RegisteredOptions& roptions
+)
+{
+   for( RegCategoriesList::const_iterator it = roptions.registered_categories_.begin(); it != roptions.registered_categories_.end(); ++it )
+   {
+      SmartPtr<RegisteredCategory>& reg_categ = registered_categories_[it->first];
+      if( !IsValid(reg_categ) )
+      {
+         reg_categ = new RegisteredCategory(it->second->Name(), it->second->Priority());
+      }
+   }
+
+   // add the options in the order of their registration, so that the categories list them in the same order
+   std::map<Index, const RegisteredOption*> options;
+   for( RegOptionsList::const_iterator it = roptions.registered_options_.begin(); it != roptions.registered_options_.end(); ++it )
+   {
+      options[it->second->Counter()] = GetRawPtr(it->second);
+   }
+
+   for( std::map<Index, const RegisteredOption*>::const_iterator it = options.begin(); it != options.end(); ++it )
+   {
+      SmartPtr<RegisteredOption> option = new RegisteredOption(*it->second);
+      if( IsValid(option->registering_category_) )
+      {
+         option->registering_category_ = registered_categories_[option->registering_category_->Name()];
+      }
+      AddOption(option);
+      next_counter_ = Max(next_counter_, option->Counter() + 1);
+   }
+}
+
 SmartPtr<const RegisteredOption> RegisteredOptions::GetOption(
    const std::string& name
 )
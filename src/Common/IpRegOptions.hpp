@@ -207,10 +207,14 @@ public:
         type_(copy.type_),
         advanced_(copy.advanced_),
         has_lower_(copy.has_lower_),
+        lower_strict_(copy.lower_strict_),
         lower_(copy.lower_),
         has_upper_(copy.has_upper_),
+        upper_strict_(copy.upper_strict_),
         upper_(copy.upper_),
+        default_number_(copy.default_number_),
         valid_strings_(copy.valid_strings_),
+        default_string_(copy.default_string_),
         counter_(copy.counter_)
    { }
 
@@ -1048,6 +1052,17 @@ public:
       bool               advanced = false       ///< whether option is for advanced users @since 3.14.0
    );
 
+   /** Register copies of all options of another RegisteredOptions object
+    *
+    * The copies and their categories do not share any objects with the
+    * other RegisteredOptions object, so that both can be used in different
+    * threads.  None of the options may have been registered here already.
+    * @since 3.15.0
+    */
+   virtual void AddOptionsCopy(
+      const RegisteredOptions& roptions
+   );
+
    /** Get a registered option
     *
     * @return NULL, if the option does not exist
@@ -0,0 +1,145 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpThreads.hpp"
+
+#include <algorithm>
+
+#if __cplusplus >= 201103L
+#include <exception>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
+#endif
+
+namespace Ipopt
+{
+
+Index NumThreads(
+   Index max_threads
+)
+{
+#if __cplusplus >= 201103L
+   if( max_threads <= 0 )
+   {
+      max_threads = (Index) std::thread::hardware_concurrency();
+   }
+   return std::max((Index) 1, max_threads);
+#else
+   (void) max_threads;
+   return 1;
+#endif
+}
+
+Index NumWorkThreads(
+   Index max_threads,
+   Index work
+)
+{
+   // threads do not pay off for little work
+   const Index min_work = 100000;
+   return std::max((Index) 1, std::min(NumThreads(max_threads), work / min_work));
+}
+
+#if __cplusplus >= 201103L
+/** joins all started threads when going out of scope
+ *
+ *  Destroying a thread that has not been joined terminates the program,
+ *  so this makes sure that the threads are joined also if an exception
+ *  is thrown.
+ */
+class ThreadJoiner
+{
+public:
+   ThreadJoiner(
+      std::vector<std::thread>& threads
+   )
+      : threads_(threads)
+   { }
+
+   ~ThreadJoiner()
+   {
+      for( size_t k = 0; k < threads_.size(); k++ )
+      {
+         if( threads_[k].joinable() )
+         {
+            threads_[k].join();
+         }
+      }
+   }
+
+private:
+   std::vector<std::thread>& threads_;
+};
+
+/** does one part of the work and keeps an exception for the calling thread */
+static void DoPartKeepException(
+   ParallelWork&       work,
+   Index               part,
+   std::exception_ptr& exception
+)
+{
+   try
+   {
+      work.DoPart(part);
+   }
+   catch( ... )
+   {
+      exception = std::current_exception();
+   }
+}
+#endif
+
+void DoParallelWork(
+   Index         nparts,
+   ParallelWork& work
+)
+{
+#if __cplusplus >= 201103L
+   if( nparts <= 1 )
+   {
+      if( nparts == 1 )
+      {
+         work.DoPart(0);
+      }
+      return;
+   }
+
+   std::vector<std::exception_ptr> exceptions(nparts);
+   {
+      std::vector<std::thread> threads;
+      threads.reserve(nparts - 1);
+      ThreadJoiner joiner(threads);
+      for( Index k = 1; k < nparts; k++ )
+      {
+         try
+         {
+            threads.push_back(std::thread(DoPartKeepException, std::ref(work), k, std::ref(exceptions[k])));
+         }
+         catch( const std::system_error& )
+         {
+            // no more threads available
+            DoPartKeepException(work, k, exceptions[k]);
+         }
+      }
+      DoPartKeepException(work, 0, exceptions[0]);
+   }
+
+   for( Index k = 0; k < nparts; k++ )
+   {
+      if( exceptions[k] )
+      {
+         std::rethrow_exception(exceptions[k]);
+      }
+   }
+#else
+   for( Index k = 0; k < nparts; k++ )
+   {
+      work.DoPart(k);
+   }
+#endif
+}
+
+} // namespace Ipopt
@@ -0,0 +1,74 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPTHREADS_HPP__
+#define __IPTHREADS_HPP__
+
+#include "IpTypes.hpp"
+
+namespace Ipopt
+{
+
+/** Work that is split into parts that can be done in parallel.
+ *
+ *  @since 3.15.0
+ */
+class IPOPTLIB_EXPORT ParallelWork
+{
+public:
+   /** Destructor */
+   virtual ~ParallelWork()
+   { }
+
+   /** Do one part of the work.
+    *
+    *  Different parts are done concurrently from different threads.
+    */
+   virtual void DoPart(
+      Index part
+   ) = 0;
+};
+
+/** Number of threads that may be used.
+ *
+ *  @return max_threads if positive, otherwise the number of hardware threads, and 1 if Ipopt has been compiled without support for threads
+ *  @since 3.15.0
+ */
+IPOPTLIB_EXPORT Index NumThreads(
+   Index max_threads ///< maximal number of threads (usually the value of option num_threads), 0 for the number of hardware threads
+);
+
+/** Number of threads to use for some work of given size.
+ *
+ *  Starting a thread does not pay off for little work, so each thread
+ *  gets at least 100000 units of work, e.g., nonzeros of a matrix.
+ *
+ *  @return a number between 1 and max_threads, and 1 if Ipopt has been compiled without support for threads
+ *  @since 3.15.0
+ */
+IPOPTLIB_EXPORT Index NumWorkThreads(
+   Index max_threads, ///< maximal number of threads (usually the value of option num_threads), 0 for the number of hardware threads
+   Index work         ///< amount of work
+);
+
+/** Do all parts of some work in parallel.
+ *
+ *  Part 0 is done in the calling thread and every other part in a new
+ *  thread.  If a thread cannot be started, its part is done in the
+ *  calling thread instead.  This function returns after all parts have
+ *  been done, also if some of them throw an exception, and then
+ *  rethrows the exception of the part with smallest number.
+ *  If Ipopt has been compiled without support for threads, the parts
+ *  are done one after the other.
+ *
+ *  @since 3.15.0
+ */
+IPOPTLIB_EXPORT void DoParallelWork(
+   Index         nparts, ///< number of parts
+   ParallelWork& work    ///< the work
+);
+
+} // namespace Ipopt
+
+#endif
@@ -8,6 +8,7 @@
 #define __IPTIMEDTASK_HPP__
 
 #include "IpUtils.hpp"
+#include "IpTimingTrace.hpp"
 
 namespace Ipopt
 {
@@ -23,7 +24,11 @@ public:
       total_cputime_(0.),
       total_systime_(0.),
       total_walltime_(0.),
+      num_calls_(0),
+      trace_(NULL),
+      trace_name_(NULL),
       enabled_(true),
+      wallclock_only_(false),
       start_called_(false),
       end_called_(true)
    {}
@@ -49,12 +54,41 @@ public:
       enabled_ = false;
    }
 
+   /** Measure only wallclock time, not CPU and system time.
+    *
+    *  This saves a system call in Start() and End().  The total CPU and
+    *  system times are then not increased.
+    *  @since 3.15.0
+    */
+   void SetWallclockOnly(
+      bool wallclock_only
+   )
+   {
+      wallclock_only_ = wallclock_only;
+   }
+
+   /** Record each execution of the task in a trace.
+    *
+    *  The name is not copied and must be valid as long as the trace
+    *  is used. Pass NULL as trace to stop recording.
+    *  @since 3.15.0
+    */
+   void SetTrace(
+      TimingTrace* trace,
+      const char*  name
+   )
+   {
+      trace_ = trace;
+      trace_name_ = name;
+   }
+
    /** Method for resetting time to zero. */
    void Reset()
    {
       total_cputime_ = 0.;
       total_systime_ = 0.;
       total_walltime_ = 0.;
+      num_calls_ = 0;
       start_called_ = false;
       end_called_ = true;
    }
@@ -62,6 +96,8 @@ public:
    /** Method that is called before execution of the task. */
    void Start()
    {
+      // the calls are counted also if timing is disabled
+      ++num_calls_;
       if( !enabled_ )
       {
          return;
@@ -71,8 +107,15 @@ public:
       DBG_ASSERT(!start_called_);
       end_called_ = false;
       start_called_ = true;
-      start_cputime_ = CpuTime();
-      start_systime_ = SysTime();
+      if( wallclock_only_ )
+      {
+         start_cputime_ = 0.;
+         start_systime_ = 0.;
+      }
+      else
+      {
+         CpuAndSysTime(start_cputime_, start_systime_);
+      }
       start_walltime_ = WallclockTime();
    }
 
@@ -88,9 +131,20 @@ public:
       DBG_ASSERT(start_called_);
       end_called_ = true;
       start_called_ = false;
-      total_cputime_ += CpuTime() - start_cputime_;
-      total_systime_ += SysTime() - start_systime_;
-      total_walltime_ += WallclockTime() - start_walltime_;
+      if( !wallclock_only_ )
+      {
+         Number cputime;
+         Number systime;
+         CpuAndSysTime(cputime, systime);
+         total_cputime_ += cputime - start_cputime_;
+         total_systime_ += systime - start_systime_;
+      }
+      Number walltime = WallclockTime();
+      total_walltime_ += walltime - start_walltime_;
+      if( trace_ != NULL )
+      {
+         trace_->AddSpan(trace_name_, start_walltime_, walltime);
+      }
    }
 
    /** Method that is called after execution of the task for which
@@ -107,9 +161,20 @@ public:
       {
          end_called_ = true;
          start_called_ = false;
-         total_cputime_ += CpuTime() - start_cputime_;
-         total_systime_ += SysTime() - start_systime_;
-         total_walltime_ += WallclockTime() - start_walltime_;
+         if( !wallclock_only_ )
+         {
+            Number cputime;
+            Number systime;
+            CpuAndSysTime(cputime, systime);
+            total_cputime_ += cputime - start_cputime_;
+            total_systime_ += systime - start_systime_;
+         }
+         Number walltime = WallclockTime();
+         total_walltime_ += walltime - start_walltime_;
+         if( trace_ != NULL )
+         {
+            trace_->AddSpan(trace_name_, start_walltime_, walltime);
+         }
       }
       DBG_ASSERT(end_called_);
    }
@@ -165,12 +230,28 @@ public:
       return start_walltime_;
    }
 
+   /** Method returning how often the task has been started so far.
+    *
+    *  The calls are also counted if timing is disabled.
+    * @since 3.15.0
+    */
+   Index NumberOfCalls() const
+   {
+      return num_calls_;
+   }
+
    /// @since 3.14.0
    bool IsEnabled() const
    {
       return enabled_;
    }
 
+   /// @since 3.15.0
+   bool IsWallclockOnly() const
+   {
+      return wallclock_only_;
+   }
+
    /// @since 3.14.0
    bool IsStarted() const
    {
@@ -204,10 +285,18 @@ private:
    Number start_walltime_;
    /** Total wall clock time for task measured so far. */
    Number total_walltime_;
+   /** Number of executions of the task measured so far. */
+   Index num_calls_;
+
+   /** Trace into which executions of the task are recorded, if not NULL */
+   TimingTrace* trace_;
+   /** Name of the task in the trace */
+   const char* trace_name_;
 
    /** @name status fields */
    ///@{
    bool enabled_;
+   bool wallclock_only_;
    bool start_called_;
    bool end_called_;
    ///@}
@@ -0,0 +1,117 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpTimingTrace.hpp"
+#include "IpUtils.hpp"
+
+#include <cstdio>
+#include <algorithm>
+#include <map>
+
+namespace Ipopt
+{
+
+bool TimingTrace::WriteChromeTrace(
+   const std::string& filename
+) const
+{
+   FILE* fp = fopen(filename.c_str(), "w");
+   if( fp == NULL )
+   {
+      return false;
+   }
+
+   fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+   for( size_t i = 0; i < spans_.size(); i++ )
+   {
+      // complete events ("X") do not need to be properly nested
+      fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"iter\":%" IPOPT_INDEX_FORMAT "}}",
+              i > 0 ? "," : "", spans_[i].name, 1e6 * spans_[i].start, 1e6 * (spans_[i].end - spans_[i].start), spans_[i].iter);
+   }
+   fprintf(fp, "\n]}\n");
+
+   fclose(fp);
+   return true;
+}
+
+/** start time, end time, and index of a span */
+typedef std::pair<std::pair<Number, Number>, size_t> SpanKey;
+
+/** Order spans by start time, enclosing spans first. */
+static bool SpanStartsBefore(
+   const SpanKey& a,
+   const SpanKey& b
+)
+{
+   if( a.first.first != b.first.first )
+   {
+      return a.first.first < b.first.first;
+   }
+   return a.first.second > b.first.second;
+}
+
+bool TimingTrace::WriteFoldedStacks(
+   const std::string& filename
+) const
+{
+   FILE* fp = fopen(filename.c_str(), "w");
+   if( fp == NULL )
+   {
+      return false;
+   }
+
+   // sort span indices by start time, with enclosing spans first
+   std::vector<SpanKey> order(spans_.size());
+   for( size_t i = 0; i < spans_.size(); i++ )
+   {
+      order[i].first = std::make_pair(spans_[i].start, spans_[i].end);
+      order[i].second = i;
+   }
+   std::stable_sort(order.begin(), order.end(), SpanStartsBefore);
+
+   // walk through the spans, keeping the stack of enclosing spans,
+   // and accumulate the self time for each stack
+   std::map<std::string, Number> self_time;
+   std::vector<size_t> stack;
+   std::vector<std::string> stack_names;
+   std::vector<Number> children_time;
+   for( size_t k = 0; k <= order.size(); k++ )
+   {
+      // close all spans on the stack that end before the next span starts
+      while( !stack.empty() && (k == order.size() || spans_[stack.back()].end <= spans_[order[k].second].start) )
+      {
+         const Span& closed = spans_[stack.back()];
+         Number duration = closed.end - closed.start;
+         self_time[stack_names.back()] += Max(Number(0.), duration - children_time.back());
+         stack.pop_back();
+         stack_names.pop_back();
+         children_time.pop_back();
+         if( !children_time.empty() )
+         {
+            children_time.back() += duration;
+         }
+      }
+      if( k == order.size() )
+      {
+         break;
+      }
+
+      const Span& span = spans_[order[k].second];
+      std::string name = stack_names.empty() ? std::string(span.name) : stack_names.back() + ";" + span.name;
+      stack.push_back(order[k].second);
+      stack_names.push_back(name);
+      children_time.push_back(0.);
+   }
+
+   for( std::map<std::string, Number>::const_iterator it = self_time.begin(); it != self_time.end(); ++it )
+   {
+      fprintf(fp, "%s %.0f\n", it->first.c_str(), 1e6 * it->second);
+   }
+
+   fclose(fp);
+   return true;
+}
+
+} // namespace Ipopt
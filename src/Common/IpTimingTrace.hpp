@@ -0,0 +1,141 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPTIMINGTRACE_HPP__
+#define __IPTIMINGTRACE_HPP__
+
+#include "IpReferenced.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Ipopt
+{
+
+/** This class records the time spans of timed tasks during a run.
+ *
+ *  Every time a TimedTask that is attached to a trace ends, the
+ *  task name, its start and end wallclock time, and the current
+ *  iteration number are stored.  The recorded spans can be written
+ *  as Chrome trace events (viewable with chrome://tracing or
+ *  Perfetto) or as folded stacks for flame graph tools.
+ *
+ *  @since 3.15.0
+ */
+class IPOPTLIB_EXPORT TimingTrace: public ReferencedObject
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Default constructor. */
+   TimingTrace()
+      : iter_(-1)
+   { }
+
+   /** Destructor */
+   virtual ~TimingTrace()
+   { }
+   ///@}
+
+   /** Set the iteration number that is stored with the following spans. */
+   void SetIteration(
+      Index iter
+   )
+   {
+      iter_ = iter;
+   }
+
+   /** Record a finished task.
+    *
+    *  The name is not copied and must be valid as long as the trace.
+    */
+   void AddSpan(
+      const char* name,
+      Number      start_walltime,
+      Number      end_walltime
+   )
+   {
+      Span span;
+      span.name = name;
+      span.start = start_walltime;
+      span.end = end_walltime;
+      span.iter = iter_;
+      spans_.push_back(span);
+   }
+
+   /** Remove all recorded spans. */
+   void Clear()
+   {
+      spans_.clear();
+      iter_ = -1;
+   }
+
+   /** Number of recorded spans. */
+   Index NumSpans() const
+   {
+      return (Index) spans_.size();
+   }
+
+   /** Write recorded spans as JSON in the Chrome trace event format.
+    *
+    *  @return false if the file could not be opened
+    */
+   bool WriteChromeTrace(
+      const std::string& filename
+   ) const;
+
+   /** Write recorded spans as folded stacks.
+    *
+    *  Each line holds a semicolon-separated stack of task names
+    *  followed by the time in microseconds spent in the innermost
+    *  task, but not in any task nested into it.  Tasks are nested
+    *  according to their start and end times.
+    *
+    *  @return false if the file could not be opened
+    */
+   bool WriteFoldedStacks(
+      const std::string& filename
+   ) const;
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   TimingTrace(
+      const TimingTrace&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const TimingTrace&
+   );
+   ///@}
+
+   /** Time span of one task execution */
+   struct Span
+   {
+      const char* name;
+      Number start;
+      Number end;
+      Index iter;
+   };
+
+   /** Recorded spans, in the order in which the tasks ended */
+   std::vector<Span> spans_;
+
+   /** Current iteration number */
+   Index iter_;
+};
+
+} // namespace Ipopt
+
+#endif
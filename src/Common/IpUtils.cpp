@@ -81,18 +81,42 @@ inline double IpCoinGetTimeOfDay()
 #else
 
 #include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
 
 inline double IpCoinGetTimeOfDay()
 {
+#if defined(_POSIX_TIMERS) && _POSIX_TIMERS > 0 && defined(CLOCK_MONOTONIC)
+   // the monotonic clock is cheaper to read and not affected by changes of the system time
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+#else
    struct timeval tv;
    gettimeofday(&tv, NULL);
    return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1000000.0;
+#endif
 }
 
 #endif // _MSC_VER
 
 /** 8< (END) ******************************** */
 
+/* keyword to declare a thread-local variable, see IpTaggedObject.cpp */
+#ifndef IPOPT_THREAD_LOCAL
+
+#if __cplusplus >= 201103L
+#define IPOPT_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define IPOPT_THREAD_LOCAL __declspec(thread)
+#elif defined(__APPLE__) && ((defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__ < 405)) || defined(__INTEL_COMPILER))
+#define IPOPT_THREAD_LOCAL
+#else
+#define IPOPT_THREAD_LOCAL __thread
+#endif
+
+#endif
+
 namespace Ipopt
 {
 
@@ -108,10 +132,20 @@ bool IsFiniteNumber(
 
 }
 
+#ifdef IPOPT_HAS_DRAND48
+/** state of the random number generator
+ *
+ * Each thread has its own state, so that solves in different threads
+ * do not influence each other.  Initially, it is the state after a
+ * call of IpResetRandom01().
+ */
+static IPOPT_THREAD_LOCAL unsigned short random_state[3] = { 0x330E, 1, 0 };
+#endif
+
 Number IpRandom01()
 {
 #ifdef IPOPT_HAS_DRAND48
-   return Number(drand48());
+   return Number(erand48(random_state));
 #else
 # ifdef IPOPT_HAS_RAND
    return Number(rand()) / Number(RAND_MAX);
@@ -128,7 +162,10 @@ Number IpRandom01()
 void IpResetRandom01()
 {
 #ifdef IPOPT_HAS_DRAND48
-   srand48(1);
+   // same state as after srand48(1)
+   random_state[0] = 0x330E;
+   random_state[1] = 1;
+   random_state[2] = 0;
 #else
 # ifdef IPOPT_HAS_RAND
    srand(1);
@@ -183,6 +220,25 @@ Number SysTime()
    return sys_temp;
 }
 
+void CpuAndSysTime(
+   Number& cpu_time,
+   Number& sys_time
+)
+{
+#if defined(_MSC_VER) || defined(__MSVCRT__)
+   cpu_time = CpuTime();
+   sys_time = SysTime();
+#else
+   // obtain both times with a single system call
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   cpu_time = (double)usage.ru_utime.tv_sec;
+   cpu_time += 1.0e-6 * ((double) usage.ru_utime.tv_usec);
+   sys_time = (double)usage.ru_stime.tv_sec;
+   sys_time += 1.0e-6 * ((double) usage.ru_stime.tv_usec);
+#endif
+}
+
 Number WallclockTime()
 {
    double callTime = IpCoinGetTimeOfDay();
@@ -85,10 +85,15 @@ IPOPTLIB_EXPORT bool IsFiniteNumber(
    Number val
 );
 
-/** Function returning a random number between 0 and 1 */
+/** Function returning a random number between 0 and 1
+ *
+ *  If drand48 is available, then each thread uses its own state of the
+ *  random number generator.  Otherwise, rand() is used, which is not
+ *  guaranteed to be thread-safe.
+ */
 IPOPTLIB_EXPORT Number IpRandom01();
 
-/** Function resetting the random number generator */
+/** Function resetting the random number generator (of the current thread) */
 IPOPTLIB_EXPORT void IpResetRandom01();
 
 /** method determining CPU time */
@@ -97,6 +102,16 @@ IPOPTLIB_EXPORT Number CpuTime();
 /** method determining system time */
 IPOPTLIB_EXPORT Number SysTime();
 
+/** method determining CPU and system time
+ *
+ *  Cheaper than calling CpuTime() and SysTime() separately.
+ *  @since 3.15.0
+ */
+IPOPTLIB_EXPORT void CpuAndSysTime(
+   Number& cpu_time,
+   Number& sys_time
+);
+
 /** method determining wallclock time since first call */
 IPOPTLIB_EXPORT Number WallclockTime();
 
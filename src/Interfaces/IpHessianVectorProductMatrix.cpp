@@ -0,0 +1,107 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpHessianVectorProductMatrix.hpp"
+#include "IpNLP.hpp"
+#include "IpIpoptNLP.hpp"
+
+namespace Ipopt
+{
+
+HessianVectorProductMatrix::HessianVectorProductMatrix(
+   const HessianVectorProductMatrixSpace* owner_space
+)
+   : SymMatrix(owner_space),
+     nlp_(NULL),
+     obj_factor_(0.),
+     is_zero_(true)
+{ }
+
+HessianVectorProductMatrix::~HessianVectorProductMatrix()
+{ }
+
+void HessianVectorProductMatrix::SetEvaluationPoint(
+   NLP*          nlp,
+   const Vector& x,
+   Number        obj_factor,
+   const Vector& yc,
+   const Vector& yd
+)
+{
+   DBG_ASSERT(Dim() == x.Dim());
+   nlp_ = nlp;
+   x_ = &x;
+   obj_factor_ = obj_factor;
+   yc_ = &yc;
+   yd_ = &yd;
+   is_zero_ = obj_factor == 0. && yc.Asum() == 0. && yd.Asum() == 0.;
+   ObjectChanged();
+}
+
+void HessianVectorProductMatrix::MultVectorImpl(
+   Number        alpha,
+   const Vector& x,
+   Number        beta,
+   Vector&       y
+) const
+{
+   //  A few sanity checks
+   DBG_ASSERT(Dim() == x.Dim());
+   DBG_ASSERT(Dim() == y.Dim());
+
+   if( is_zero_ || alpha == 0. )
+   {
+      if( beta != 0.0 )
+      {
+         y.Scal(beta);
+      }
+      else
+      {
+         y.Set(0.0);  // In case y hasn't been initialized yet
+      }
+      return;
+   }
+
+   DBG_ASSERT(nlp_ != NULL);
+   SmartPtr<Vector> hx = y.MakeNew();
+   bool success = nlp_->Eval_h_times_vec(*x_, obj_factor_, *yc_, *yd_, x, *hx);
+   ASSERT_EXCEPTION(success && IsFiniteNumber(hx->Nrm2()), IpoptNLP::Eval_Error,
+                    "Error evaluating the product of the Hessian of the Lagrangian with a vector");
+
+   y.AddOneVector(alpha, *hx, beta);
+}
+
+void HessianVectorProductMatrix::ComputeRowAMaxImpl(
+   Vector& /*rows_norms*/,
+   bool    /*init*/
+) const
+{
+   THROW_EXCEPTION(UNIMPLEMENTED_LINALG_METHOD_CALLED, "HessianVectorProductMatrix::ComputeRowAMaxImpl not implemented");
+}
+
+void HessianVectorProductMatrix::ComputeColAMaxImpl(
+   Vector& /*cols_norms*/,
+   bool    /*init*/
+) const
+{
+   THROW_EXCEPTION(UNIMPLEMENTED_LINALG_METHOD_CALLED, "HessianVectorProductMatrix::ComputeColAMaxImpl not implemented");
+}
+
+void HessianVectorProductMatrix::PrintImpl(
+   const Journalist&  jnlst,
+   EJournalLevel      level,
+   EJournalCategory   category,
+   const std::string& name,
+   Index              indent,
+   const std::string& prefix
+) const
+{
+   jnlst.Printf(level, category,
+                "\n");
+   jnlst.PrintfIndented(level, category, indent,
+                        "%sHessianVectorProductMatrix \"%s\" of dimension %" IPOPT_INDEX_FORMAT " with obj_factor %23.16e (entries are not available)\n",
+                        prefix.c_str(), name.c_str(), Dim(), obj_factor_);
+}
+
+} // namespace Ipopt
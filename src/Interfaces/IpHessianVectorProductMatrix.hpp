@@ -0,0 +1,183 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPHESSIANVECTORPRODUCTMATRIX_HPP__
+#define __IPHESSIANVECTORPRODUCTMATRIX_HPP__
+
+#include "IpUtils.hpp"
+#include "IpSymMatrix.hpp"
+
+namespace Ipopt
+{
+
+/** forward declarations */
+class NLP;
+class HessianVectorProductMatrixSpace;
+
+/** Class for the Hessian of the Lagrangian that is only available
+ *  through products with vectors.
+ *
+ *  The matrix stores the point (x, obj_factor, yc, yd) at which the
+ *  Hessian is evaluated and computes products with vectors by calling
+ *  NLP::Eval_h_times_vec.  Thus, it never holds any entries of the
+ *  Hessian and can only be used by algorithms that need nothing but
+ *  matrix-vector products, e.g., Krylov methods.
+ *
+ *  @since 3.15.0
+ */
+class IPOPTLIB_EXPORT HessianVectorProductMatrix: public SymMatrix
+{
+public:
+   /**@name Constructors / Destructors */
+   ///@{
+   /** Constructor, taking the corresponding matrix space. */
+   HessianVectorProductMatrix(
+      const HessianVectorProductMatrixSpace* owner_space
+   );
+
+   /** Destructor */
+   ~HessianVectorProductMatrix();
+   ///@}
+
+   /** Set the point at which the Hessian is evaluated.
+    *
+    *  The vectors are not copied, so they must not be changed afterwards.
+    *  The NLP must exist as long as products are computed with this matrix.
+    */
+   void SetEvaluationPoint(
+      NLP*          nlp,
+      const Vector& x,
+      Number        obj_factor,
+      const Vector& yc,
+      const Vector& yd
+   );
+
+protected:
+   /**@name Methods overloaded from matrix */
+   ///@{
+   virtual void MultVectorImpl(
+      Number        alpha,
+      const Vector& x,
+      Number        beta,
+      Vector&       y
+   ) const;
+
+   virtual void ComputeRowAMaxImpl(
+      Vector& rows_norms,
+      bool    init
+   ) const;
+
+   virtual void ComputeColAMaxImpl(
+      Vector& cols_norms,
+      bool    init
+   ) const;
+
+   virtual void PrintImpl(
+      const Journalist&  jnlst,
+      EJournalLevel      level,
+      EJournalCategory   category,
+      const std::string& name,
+      Index              indent,
+      const std::string& prefix
+   ) const;
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   HessianVectorProductMatrix();
+
+   /** Copy Constructor */
+   HessianVectorProductMatrix(
+      const HessianVectorProductMatrix&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const HessianVectorProductMatrix&
+   );
+   ///@}
+
+   /** NLP that computes the products */
+   NLP* nlp_;
+
+   /** @name Point at which the Hessian is evaluated */
+   ///@{
+   SmartPtr<const Vector> x_;
+   Number obj_factor_;
+   SmartPtr<const Vector> yc_;
+   SmartPtr<const Vector> yd_;
+   ///@}
+
+   /** Whether obj_factor, yc, and yd are all zero, so that the Hessian is zero */
+   bool is_zero_;
+};
+
+/** This is the matrix space for HessianVectorProductMatrix.
+ *
+ *  @since 3.15.0
+ */
+class IPOPTLIB_EXPORT HessianVectorProductMatrixSpace: public SymMatrixSpace
+{
+public:
+   /** @name Constructors / Destructors */
+   ///@{
+   /** Constructor, given the number of rows and columns. */
+   HessianVectorProductMatrixSpace(
+      Index dim
+   )
+      : SymMatrixSpace(dim)
+   { }
+
+   /** Destructor */
+   virtual ~HessianVectorProductMatrixSpace()
+   { }
+   ///@}
+
+   virtual SymMatrix* MakeNewSymMatrix() const
+   {
+      return MakeNewHessianVectorProductMatrix();
+   }
+
+   /** Method for creating a new matrix of this specific type. */
+   HessianVectorProductMatrix* MakeNewHessianVectorProductMatrix() const
+   {
+      return new HessianVectorProductMatrix(this);
+   }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   HessianVectorProductMatrixSpace();
+
+   /** Copy Constructor */
+   HessianVectorProductMatrixSpace(
+      const HessianVectorProductMatrixSpace&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const HessianVectorProductMatrixSpace&
+   );
+   ///@}
+};
+
+} // namespace Ipopt
+#endif
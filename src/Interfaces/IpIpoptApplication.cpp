@@ -13,6 +13,9 @@
 #include "IpIpoptCalculatedQuantities.hpp"
 #include "IpAlgBuilder.hpp"
 #include "IpSolveStatistics.hpp"
+#include "IpSolverState.hpp"
+#include "IpPortfolioTNLP.hpp"
+#include "IpThreads.hpp"
 #include "IpLinearSolversRegOp.hpp"
 #include "IpInterfacesRegOp.hpp"
 #include "IpAlgorithmRegOp.hpp"
@@ -29,6 +32,12 @@
 #include <cassert>
 #include <cmath>
 #include <fstream>
+#include <sstream>
+
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <thread>
+#endif
 
 // Factory to facilitate creating IpoptApplication objects from within a DLL
 
@@ -153,6 +162,7 @@ SmartPtr<IpoptApplication> IpoptApplication::clone()
    retval->inexact_algorithm_ = inexact_algorithm_;
    retval->replace_bounds_ = replace_bounds_;
    retval->rethrow_nonipoptexception_ = rethrow_nonipoptexception_;
+   retval->warm_start_state_ = warm_start_state_;
 
    return retval;
 }
@@ -234,6 +244,26 @@ ApplicationReturnStatus IpoptApplication::Initialize(
                return Invalid_Option;
             }
          }
+
+         // Collect output to console and output file in buffers, if requested
+         options_->GetIntegerValue("journal_buffer_size", ivalue, "");
+         bool background_writer;
+         options_->GetBoolValue("journal_background_writer", background_writer, "");
+         FileJournal* file_jrnl = dynamic_cast<FileJournal*>(GetRawPtr(stdout_jrnl));
+         if( file_jrnl != NULL )
+         {
+            file_jrnl->SetBufferSize(ivalue);
+            file_jrnl->SetBackgroundWriter(background_writer);
+         }
+         if( output_filename != "" )
+         {
+            file_jrnl = dynamic_cast<FileJournal*>(GetRawPtr(jnlst_->GetJournal("OutputFile:" + output_filename)));
+            if( file_jrnl != NULL )
+            {
+               file_jrnl->SetBufferSize(ivalue);
+               file_jrnl->SetBackgroundWriter(background_writer);
+            }
+         }
       }
 
       // output a description of all the options
@@ -386,6 +416,26 @@ void IpoptApplication::RegisterOptions(
       "NOTE: This option only works when read from the ipopt.opt options file! "
       "Determines the verbosity level for the file specified by \"output_file\". "
       "By default it is the same as \"print_level\".");
+   roptions->AddLowerBoundedIntegerOption(
+      "journal_buffer_size",
+      "Size of the buffer for console and file output in bytes.",
+      0,
+      0,
+      "If positive, then output to the console and to the file specified by \"output_file\" is collected in a buffer of this size "
+      "and written when the buffer is full, at the end of each iteration, and at the end of the optimization. "
+      "This reduces the number of write operations for high print levels. "
+      "Note that output that the application writes directly to the console may then appear out of order with Ipopt's output. "
+      "If 0, output is passed to the C library immediately.",
+      true);
+   roptions->AddBoolOption(
+      "journal_background_writer",
+      "Whether buffered console and file output is written by a separate thread.",
+      false,
+      "If enabled and \"journal_buffer_size\" is positive, then full buffers are passed to a thread that writes them "
+      "while the optimization continues. "
+      "Flushing the output, e.g., at the end of the optimization, waits until everything has been written. "
+      "Threads are only available if Ipopt has been built with C++11 support.",
+      true);
    roptions->AddBoolOption(
       "print_user_options",
       "Print all options set by the user.",
@@ -414,6 +464,24 @@ void IpoptApplication::RegisterOptions(
       false,
       "If selected, the program will print the time spend for selected tasks. "
       "This implies timing_statistics=yes.");
+   roptions->AddStringOption1(
+      "timing_trace_file",
+      "File name for a trace of timed tasks (leave unset for no trace).",
+      "",
+      "*", "Any acceptable standard file name",
+      "If set, the start and end time and the iteration number of every execution of a timed task "
+      "(e.g., search direction computation, factorization, backsolve, line search, function evaluations, also within the restoration phase) "
+      "are recorded and written to this file at the end of the optimization. "
+      "This implies timing_statistics=yes.",
+      true);
+   roptions->AddStringOption2(
+      "timing_trace_format",
+      "Format of the file specified by timing_trace_file.",
+      "chrome",
+      "chrome", "JSON file in Chrome trace event format, viewable with chrome://tracing or Perfetto",
+      "folded", "folded stacks with the time in microseconds spent in each stack of tasks, as used by flame graph tools",
+      "",
+      true);
 
    roptions->SetRegisteringCategory("Miscellaneous");
    roptions->AddStringOption1(
@@ -441,6 +509,41 @@ void IpoptApplication::RegisterOptions(
       "Setting this option to \"yes\" will cause the IpoptApplication object to suppress the default call to that method.",
       true);
 
+   roptions->AddLowerBoundedIntegerOption(
+      "num_threads",
+      "Maximal number of threads for computations on large problems.",
+      0,
+      1,
+      "If larger than 1, the analysis of the derivative structures when setting up the problem "
+      "and Ruiz scaling of the NLP and of the linear systems split their work on large problems into up to this many threads. "
+      "This option never leads to calls of the methods of a TNLP from several threads; "
+      "see option evaluation_num_threads for evaluating the TNLP in parallel. "
+      "If 0, the number of hardware threads is used. "
+      "Threads are only available if Ipopt has been built with C++11 support.");
+   roptions->AddLowerBoundedIntegerOption(
+      "portfolio_num_threads",
+      "Number of threads for the solves of a portfolio.",
+      0,
+      1,
+      "This option is only used by IpoptApplication::OptimizeTNLPPortfolio. "
+      "If larger than 1, the methods of the TNLP are called from several threads at the same time, "
+      "so they need to be thread-safe. "
+      "If 0, the number of hardware threads is used. "
+      "Without support for C++11 threads, the solves are run one after the other.");
+   roptions->AddBoolOption(
+      "portfolio_stop_on_success",
+      "Whether the remaining solves of a portfolio are stopped once one solve succeeded.",
+      true,
+      "This option is only used by IpoptApplication::OptimizeTNLPPortfolio. "
+      "If enabled, solves that are running are stopped at their next iteration and solves that did not start yet are skipped.");
+   roptions->AddBoolOption(
+      "portfolio_perturb_start",
+      "Whether a solve of a portfolio starts from a random perturbation of the starting point.",
+      false,
+      "This option is only used in the settings of a solve for IpoptApplication::OptimizeTNLPPortfolio. "
+      "If enabled, each component of the starting point is replaced by a random value "
+      "that differs by at most \"point_perturbation_radius\" and is within the variable bounds.");
+
    roptions->SetRegisteringCategory("Undocumented");
    roptions->AddBoolOption(
       "suppress_all_output",
@@ -582,6 +685,248 @@ ApplicationReturnStatus IpoptApplication::ReOptimizeNLP(
    return call_optimize();
 }
 
+/** One solve of a portfolio */
+struct PortfolioSolve
+{
+   SmartPtr<IpoptApplication> app;
+   SmartPtr<PortfolioTNLP>    tnlp;
+   /** whether the solve has been run (or skipped because the portfolio was stopped) */
+   bool                       run;
+   ApplicationReturnStatus    status;
+};
+
+static void RunPortfolioSolve(
+   PortfolioSolve&      solve,
+   PortfolioSharedData& shared,
+   bool                 stop_on_success
+)
+{
+   if( shared.Stopped() )
+   {
+      return;
+   }
+   // the random number generator is kept per thread, so reset it to get
+   // the same result regardless of which thread runs the solve
+   IpResetRandom01();
+   solve.status = solve.app->OptimizeTNLP(GetRawPtr(solve.tnlp));
+   solve.run = true;
+   if( stop_on_success && solve.status == Solve_Succeeded )
+   {
+      shared.Stop();
+   }
+}
+
+/** runs solves of a portfolio, one worker per part, until all solves have been taken by some worker */
+class PortfolioWorkers: public ParallelWork
+{
+public:
+   PortfolioWorkers(
+      std::vector<PortfolioSolve>& solves,
+      PortfolioSharedData&         shared,
+      bool                         stop_on_success
+   )
+      : solves_(solves),
+        shared_(shared),
+        stop_on_success_(stop_on_success),
+        next_solve_(0)
+   { }
+
+   virtual void DoPart(
+      Index /*part*/
+   )
+   {
+      for( size_t k = next_solve_++; k < solves_.size(); k = next_solve_++ )
+      {
+         RunPortfolioSolve(solves_[k], shared_, stop_on_success_);
+      }
+   }
+
+private:
+   std::vector<PortfolioSolve>& solves_;
+   PortfolioSharedData& shared_;
+   bool stop_on_success_;
+   /** index of the next solve that has not been taken by a worker */
+#if __cplusplus >= 201103L
+   std::atomic<size_t> next_solve_;
+#else
+   size_t next_solve_;
+#endif
+};
+
+/** rank of a solve of a portfolio: lower is better */
+static int PortfolioRank(
+   const PortfolioSolve& solve
+)
+{
+   if( !solve.run || !solve.tnlp->HasSolution() )
+   {
+      return 3;
+   }
+   if( solve.status == Solve_Succeeded )
+   {
+      return 0;
+   }
+   if( solve.status == Solved_To_Acceptable_Level )
+   {
+      return 1;
+   }
+   return 2;
+}
+
+ApplicationReturnStatus IpoptApplication::OptimizeTNLPPortfolio(
+   const SmartPtr<TNLP>&           tnlp,
+   const std::vector<std::string>& settings
+)
+{
+   if( settings.empty() )
+   {
+      jnlst_->Printf(J_ERROR, J_MAIN, "No settings given for portfolio of solves.\n");
+      return Invalid_Option;
+   }
+
+   Index num_threads;
+   bool stop_on_success;
+   bool skip_finalize_solution_call;
+   options_->GetIntegerValue("portfolio_num_threads", num_threads, "");
+   options_->GetBoolValue("portfolio_stop_on_success", stop_on_success, "");
+   options_->GetBoolValue("skip_finalize_solution_call", skip_finalize_solution_call, "");
+
+   // obtain the problem structure once for all solves
+   SmartPtr<PortfolioSharedData> shared = new PortfolioSharedData();
+   if( !shared->Initialize(*tnlp) )
+   {
+      jnlst_->Printf(J_ERROR, J_MAIN, "Could not obtain problem information from TNLP for portfolio of solves.\n");
+      return Invalid_Problem_Definition;
+   }
+   const Index n = shared->n_;
+   const Index m = shared->m_;
+
+   // set up an IpoptApplication for each solve
+   std::vector<PortfolioSolve> solves(settings.size());
+   std::vector<Number> x_ref;
+   std::vector<Number> x_start(n);
+   IpResetRandom01();
+   for( size_t k = 0; k < solves.size(); k++ )
+   {
+      // each solve gets its own copy of the registered options (including those
+      // added by the user) and its own journalist, since the reference counting
+      // of the objects is not thread-safe; the journalist has no journals, so
+      // that the solve does not produce any output
+      SmartPtr<IpoptApplication> app = new IpoptApplication(false, true);
+      app->jnlst_ = new Journalist();
+      app->reg_options_ = new RegisteredOptions();
+      app->reg_options_->AddOptionsCopy(*reg_options_);
+      *app->options_ = *options_;
+      app->options_->SetJournalist(app->jnlst_);
+      app->options_->SetRegisteredOptions(app->reg_options_);
+      app->read_params_dat_ = false;
+      app->rethrow_nonipoptexception_ = false;
+
+      // all solves would write into the same files, so these are only written if requested in the settings
+      app->options_->SetStringValue("output_file", "");
+      app->options_->SetStringValue("timing_trace_file", "");
+      app->options_->SetStringValue("iteration_telemetry_file", "");
+      app->options_->SetStringValue("derivative_test_report_file", "");
+      // the final solution is passed on to the TNLP below
+      app->options_->SetStringValue("skip_finalize_solution_call", "no");
+
+      std::istringstream is(settings[k]);
+      ApplicationReturnStatus status = app->Initialize(is, true);
+      if( status != Solve_Succeeded )
+      {
+         jnlst_->Printf(J_ERROR, J_MAIN, "Invalid settings for solve %d of portfolio:\n%s\n", (int) k, settings[k].c_str());
+         return status;
+      }
+
+      bool perturb_start;
+      app->options_->GetBoolValue("portfolio_perturb_start", perturb_start, "");
+      if( perturb_start )
+      {
+         if( x_ref.empty() && n > 0 )
+         {
+            x_ref.resize(n);
+            if( !tnlp->get_starting_point(n, true, &x_ref[0], false, NULL, NULL, m, false, NULL) )
+            {
+               jnlst_->Printf(J_ERROR, J_MAIN, "Could not obtain starting point from TNLP for portfolio of solves.\n");
+               return Invalid_Problem_Definition;
+            }
+         }
+         Number radius;
+         app->options_->GetNumericValue("point_perturbation_radius", radius, "");
+         for( Index i = 0; i < n; i++ )
+         {
+            const Number lower = Max(shared->x_l_[i], x_ref[i] - radius);
+            const Number upper = Min(shared->x_u_[i], x_ref[i] + radius);
+            x_start[i] = lower + IpRandom01() * (upper - lower);
+         }
+      }
+
+      solves[k].app = app;
+      solves[k].tnlp = new PortfolioTNLP(tnlp, shared, perturb_start && n > 0 ? &x_start[0] : NULL);
+      solves[k].run = false;
+      solves[k].status = Internal_Error;
+   }
+
+   // run the solves
+#if __cplusplus >= 201103L
+   if( num_threads == 0 )
+   {
+      num_threads = (Index) std::thread::hardware_concurrency();
+   }
+   num_threads = Max((Index) 1, Min(num_threads, (Index) solves.size()));
+#else
+   num_threads = 1;
+#endif
+   PortfolioWorkers workers(solves, *shared, stop_on_success);
+   DoParallelWork(num_threads, workers);
+
+   // pick the best solve
+   size_t best = 0;
+   for( size_t k = 0; k < solves.size(); k++ )
+   {
+      const int rank = PortfolioRank(solves[k]);
+      if( solves[k].run )
+      {
+         jnlst_->Printf(J_ITERSUMMARY, J_MAIN,
+                        "Portfolio solve %3d: status %3d, %5" IPOPT_INDEX_FORMAT " iterations, objective %23.16e\n", (int) k,
+                        (int) solves[k].status,
+                        IsValid(solves[k].app->Statistics()) ? solves[k].app->Statistics()->IterationCount() : 0,
+                        solves[k].tnlp->HasSolution() ? solves[k].tnlp->FinalObjective() : 0.);
+      }
+      else
+      {
+         jnlst_->Printf(J_ITERSUMMARY, J_MAIN, "Portfolio solve %3d: skipped\n", (int) k);
+      }
+
+      const int best_rank = PortfolioRank(solves[best]);
+      if( rank < best_rank || (rank == best_rank && rank <= 1
+                               && solves[k].tnlp->FinalObjective() < solves[best].tnlp->FinalObjective()) )
+      {
+         best = k;
+      }
+   }
+   jnlst_->Printf(J_SUMMARY, J_MAIN, "\nBest result of portfolio of %d solves (%" IPOPT_INDEX_FORMAT " threads) from solve %d.\n",
+                  (int) solves.size(), num_threads, (int) best);
+
+   // make the best solve the one of this IpoptApplication
+   IpoptApplication& best_app = *solves[best].app;
+   statistics_ = best_app.statistics_;
+   alg_ = best_app.alg_;
+   ip_nlp_ = best_app.ip_nlp_;
+   ip_data_ = best_app.ip_data_;
+   ip_cq_ = best_app.ip_cq_;
+   nlp_adapter_ = best_app.nlp_adapter_;
+
+   if( !skip_finalize_solution_call && solves[best].tnlp->HasSolution() )
+   {
+      solves[best].tnlp->FinalizeSolution(GetRawPtr(ip_data_), GetRawPtr(ip_cq_));
+   }
+
+   jnlst_->FlushBuffer();
+
+   return solves[best].status;
+}
+
 ApplicationReturnStatus IpoptApplication::call_optimize()
 {
    // Reset the print-level for the screen output
@@ -617,6 +962,11 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
    SolverReturn status = INTERNAL_ERROR;
    try
    {
+      // CPU and system times of the timed tasks are only measured if timing statistics
+      // have been requested explicitly or are printed, other uses need only wallclock times
+      bool timing_statistics;
+      bool cpu_times = options_->GetBoolValue("timing_statistics", timing_statistics, "") && timing_statistics;
+
       // check whether timing statistics need to be printed
       bool print_timing_statistics;
       options_->GetBoolValue("print_timing_statistics", print_timing_statistics, "");
@@ -624,6 +974,29 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
       if( print_timing_statistics )
       {
          options_->SetStringValue("timing_statistics", "yes", true, true);
+         cpu_times = true;
+      }
+      p2ip_data->TimingStats().SetWallclockOnly(!cpu_times);
+
+      // record timed tasks if a trace file is requested; this also requires timing statistics
+      std::string timing_trace_file;
+      options_->GetStringValue("timing_trace_file", timing_trace_file, "");
+      if( timing_trace_file != "" )
+      {
+         options_->SetStringValue("timing_statistics", "yes", true, true);
+         p2ip_data->TimingStats().SetTrace(new TimingTrace());
+      }
+      else
+      {
+         p2ip_data->TimingStats().SetTrace(NULL);
+      }
+
+      // Pass a snapshot of a previous run to the algorithm and the scaling
+      p2ip_data->SetWarmStartState(warm_start_state_);
+      StandardScalingBase* p2scaling = dynamic_cast<StandardScalingBase*>(GetRawPtr(p2ip_nlp->NLP_scaling()));
+      if( p2scaling != NULL )
+      {
+         p2scaling->SetWarmStartState(warm_start_state_);
       }
 
       // Set up the algorithm
@@ -875,6 +1248,30 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
       }
    }
 
+   // write the trace of timed tasks, also if the optimization was aborted
+   SmartPtr<TimingTrace> timing_trace = p2ip_data->TimingStats().Trace();
+   if( IsValid(timing_trace) )
+   {
+      std::string timing_trace_file;
+      std::string timing_trace_format;
+      options_->GetStringValue("timing_trace_file", timing_trace_file, "");
+      options_->GetStringValue("timing_trace_format", timing_trace_format, "");
+      bool written;
+      if( timing_trace_format == "folded" )
+      {
+         written = timing_trace->WriteFoldedStacks(timing_trace_file);
+      }
+      else
+      {
+         written = timing_trace->WriteChromeTrace(timing_trace_file);
+      }
+      if( !written )
+      {
+         jnlst_->Printf(J_WARNING, J_MAIN, "Could not write timing trace to file \"%s\".\n", timing_trace_file.c_str());
+      }
+      p2ip_data->TimingStats().SetTrace(NULL);
+   }
+
    /** Flag indicating if the NLP:FinalizeSolution method should not
     *  be called after optimization. */
    bool skip_finalize_solution_call;
@@ -1030,6 +1427,25 @@ SmartPtr<IpoptAlgorithm> IpoptApplication::AlgorithmObject()
    return alg_;
 }
 
+SmartPtr<SolverState> IpoptApplication::GetSolverState()
+{
+   if( IsNull(alg_) || IsNull(ip_data_) || IsNull(ip_data_->curr()) )
+   {
+      return NULL;
+   }
+
+   SmartPtr<SolverState> state = new SolverState();
+   alg_->StoreSolverState(*state);
+   return state;
+}
+
+void IpoptApplication::SetWarmStartState(
+   const SmartPtr<const SolverState>& state
+)
+{
+   warm_start_state_ = state;
+}
+
 void IpoptApplication::PrintCopyrightMessage()
 {
    IpoptAlgorithm::print_copyright_message(*jnlst_);
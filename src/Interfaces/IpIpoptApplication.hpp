@@ -8,6 +8,8 @@
 #define __IPIPOPTAPPLICATION_HPP__
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "IpJournalist.hpp"
 #include "IpTNLP.hpp"
@@ -27,6 +29,7 @@ class AlgorithmBuilder;
 class RegisteredOptions;
 class OptionsList;
 class SolveStatistics;
+class SolverState;
 
 /** This is the main application class for making calls to Ipopt. */
 class IPOPTLIB_EXPORT IpoptApplication: public ReferencedObject
@@ -175,6 +178,44 @@ public:
    virtual ApplicationReturnStatus ReOptimizeNLP(
       const SmartPtr<NLP>& nlp
    );
+
+   /** Solve a problem (that inherits from TNLP) several times with
+    *  different options and return the best result.
+    *
+    *  Each entry of settings specifies the options of one solve in
+    *  the format of an options file; they are applied on top of the
+    *  options of this IpoptApplication.  For example, solves can
+    *  differ in "mu_strategy" or "linear_solver", or start from a
+    *  random perturbation of the starting point (option
+    *  "portfolio_perturb_start" together with
+    *  "point_perturbation_radius").
+    *
+    *  The solves run one after the other, or concurrently in up to
+    *  "portfolio_num_threads" threads.  The dimensions, bounds, and
+    *  sparsity structures are requested from the TNLP only once, but
+    *  each solve still sets up its own problem from them.  With more
+    *  than one thread, all other methods of the TNLP may be called
+    *  from several threads at the same time, so they need to be
+    *  thread-safe.  If
+    *  "portfolio_stop_on_success" is enabled, the remaining solves
+    *  are stopped once one solve succeeded.  Options that have been
+    *  added to RegOptions() can be used in the settings as well.
+    *
+    *  Only the best result is passed to TNLP::finalize_solution:
+    *  the successful solve with the smallest objective value, or, if
+    *  there is none, the solve that reached an acceptable point with
+    *  the smallest objective value, or the first solve otherwise.
+    *  Statistics, GetSolverState, and the other getters then refer
+    *  to this solve.  The solves do not produce any output and do
+    *  not use the snapshot given to SetWarmStartState.
+    *
+    *  @return the status of the best solve, or Invalid_Option if some settings could not be read
+    *  @since 3.15.0
+    */
+   virtual ApplicationReturnStatus OptimizeTNLPPortfolio(
+      const SmartPtr<TNLP>&           tnlp,
+      const std::vector<std::string>& settings
+   );
    ///@}
 
    /** Method for opening an output file with given print_level.
@@ -234,6 +275,42 @@ public:
    SmartPtr<IpoptAlgorithm> AlgorithmObject();
    ///@}
 
+   /**@name Warm start from previous optimization runs */
+   ///@{
+   /** Get a snapshot of the state of the algorithm at the end of the
+    *  most recent optimization run.
+    *
+    *  The snapshot contains the final primal-dual iterate, the barrier
+    *  parameter, the most recent perturbations of the primal-dual
+    *  system, the scaling factors, and the limited-memory quasi-Newton
+    *  pairs (if a BFGS approximation of the Hessian is used).  It can
+    *  be given to SetWarmStartState of this or another
+    *  IpoptApplication to start a later optimization run for a
+    *  problem with the same structure from there.
+    *
+    *  @return NULL, if no optimization run has produced an iterate yet
+    *  @since 3.15.0
+    */
+   virtual SmartPtr<SolverState> GetSolverState();
+
+   /** Set a snapshot of a previous optimization run that is used to
+    *  warm start all following calls of OptimizeTNLP, OptimizeNLP,
+    *  and ReOptimizeTNLP, ReOptimizeNLP.
+    *
+    *  The iterate of the snapshot replaces the starting point of the
+    *  NLP and the barrier parameter is initialized from the snapshot.
+    *  If the iterate does not fit the dimensions of the problem, or
+    *  the scaling of the problem differs from the one of the snapshot,
+    *  then the whole snapshot is ignored and the run starts as without
+    *  a snapshot.  Pass NULL to switch off the warm start.
+    *
+    *  @since 3.15.0
+    */
+   virtual void SetWarmStartState(
+      const SmartPtr<const SolverState>& state
+   );
+   ///@}
+
    /** Method for printing Ipopt copyright message now instead of
     *  just before the optimization.
     *
@@ -348,6 +425,11 @@ private:
     */
    SmartPtr<NLP> nlp_adapter_;
 
+   /** Snapshot of a previous run that is used to warm start the
+    *  following optimization runs, NULL if none.
+    */
+   SmartPtr<const SolverState> warm_start_state_;
+
    /** @name Algorithmic parameters */
    ///@{
    /** Flag indicating if we are to use the inexact linear solver option */
@@ -169,6 +169,80 @@ public:
       const Vector& yd,
       SymMatrix&    h
    ) = 0;
+
+   /** Compute the product of the Hessian of the Lagrangian with a vector.
+    *
+    *  This is used by HessianVectorProductMatrix, which an NLP can
+    *  return as Hessian space and fill in Eval_h, if the Hessian is
+    *  available only through products with vectors.  The default
+    *  implementation returns false.
+    *
+    *  @since 3.15.0
+    */
+   virtual bool Eval_h_times_vec(
+      const Vector& /*x*/,
+      Number        /*obj_factor*/,
+      const Vector& /*yc*/,
+      const Vector& /*yd*/,
+      const Vector& /*v*/,
+      Vector&       /*hv*/
+   )
+   {
+      return false;
+   }
+
+   /** Evaluate objective and constraints at several points.
+    *
+    *  This is used to evaluate several trial points of the line search
+    *  at once, so implementations may evaluate the points in parallel.
+    *  The vectors in c and d are filled like in Eval_c and Eval_d.
+    *  success[i] is set to indicate whether all functions could be
+    *  evaluated at point i.
+    *
+    *  The default implementation returns false, in which case the points
+    *  are evaluated one after another by the other evaluation routines.
+    *
+    *  @return false, if evaluation at several points is not supported
+    *  @since 3.15.0
+    */
+   virtual bool Eval_f_c_d_AtPoints(
+      Index                /*npoints*/,
+      const Vector* const* /*x*/,
+      Number*              /*f*/,
+      Vector* const*       /*c*/,
+      Vector* const*       /*d*/,
+      bool*                /*success*/
+   )
+   {
+      return false;
+   }
+
+   /** Evaluate objective gradient and constraint Jacobians at several points.
+    *
+    *  This is used by equilibration-based scaling to evaluate the first
+    *  derivatives at several perturbed points at once, so implementations
+    *  may evaluate the points in parallel.
+    *  The vectors and matrices are filled like in Eval_grad_f, Eval_jac_c,
+    *  and Eval_jac_d.  success[i] is set to indicate whether all
+    *  derivatives could be evaluated at point i.
+    *
+    *  The default implementation returns false, in which case the points
+    *  are evaluated one after another by the other evaluation routines.
+    *
+    *  @return false, if evaluation at several points is not supported
+    *  @since 3.15.0
+    */
+   virtual bool Eval_grad_f_jac_c_d_AtPoints(
+      Index                /*npoints*/,
+      const Vector* const* /*x*/,
+      Vector* const*       /*g_f*/,
+      Matrix* const*       /*jac_c*/,
+      Matrix* const*       /*jac_d*/,
+      bool*                /*success*/
+   )
+   {
+      return false;
+   }
    ///@}
 
    /** @name NLP solution routines.
@@ -0,0 +1,395 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpPortfolioTNLP.hpp"
+
+#include <algorithm>
+
+namespace Ipopt
+{
+
+PortfolioSharedData::PortfolioSharedData()
+   : n_(-1),
+     m_(-1),
+     nnz_jac_g_(-1),
+     nnz_h_lag_(-1),
+     index_style_(TNLP::C_STYLE),
+     have_hess_structure_(false),
+     stopped_(false)
+{ }
+
+PortfolioSharedData::~PortfolioSharedData()
+{ }
+
+bool PortfolioSharedData::Initialize(
+   TNLP& tnlp
+)
+{
+   if( !tnlp.get_nlp_info(n_, m_, nnz_jac_g_, nnz_h_lag_, index_style_) )
+   {
+      return false;
+   }
+
+   x_l_.resize(n_);
+   x_u_.resize(n_);
+   g_l_.resize(m_);
+   g_u_.resize(m_);
+   if( !tnlp.get_bounds_info(n_, n_ > 0 ? &x_l_[0] : NULL, n_ > 0 ? &x_u_[0] : NULL,
+                             m_, m_ > 0 ? &g_l_[0] : NULL, m_ > 0 ? &g_u_[0] : NULL) )
+   {
+      return false;
+   }
+
+   jac_irow_.resize(nnz_jac_g_);
+   jac_jcol_.resize(nnz_jac_g_);
+   if( nnz_jac_g_ > 0 && !tnlp.eval_jac_g(n_, NULL, false, m_, nnz_jac_g_, &jac_irow_[0], &jac_jcol_[0], NULL) )
+   {
+      return false;
+   }
+
+   // the Hessian structure is only needed if some solve uses exact second derivatives,
+   // so it is fine if the TNLP cannot provide it
+   have_hess_structure_ = false;
+   if( nnz_h_lag_ > 0 )
+   {
+      hess_irow_.resize(nnz_h_lag_);
+      hess_jcol_.resize(nnz_h_lag_);
+      have_hess_structure_ = tnlp.eval_h(n_, NULL, false, 1., m_, NULL, false, nnz_h_lag_, &hess_irow_[0],
+                                         &hess_jcol_[0], NULL);
+   }
+
+   return true;
+}
+
+PortfolioTNLP::PortfolioTNLP(
+   const SmartPtr<TNLP>&                tnlp,
+   const SmartPtr<PortfolioSharedData>& shared,
+   const Number*                        x_start
+)
+   : tnlp_(tnlp),
+     shared_(shared),
+     have_solution_(false),
+     status_(INTERNAL_ERROR),
+     obj_value_(0.),
+     have_metadata_(false)
+{
+   DBG_ASSERT(IsValid(tnlp_));
+   DBG_ASSERT(IsValid(shared_));
+   if( x_start != NULL )
+   {
+      x_start_.assign(x_start, x_start + shared_->n_);
+   }
+}
+
+PortfolioTNLP::~PortfolioTNLP()
+{ }
+
+bool PortfolioTNLP::get_nlp_info(
+   Index&          n,
+   Index&          m,
+   Index&          nnz_jac_g,
+   Index&          nnz_h_lag,
+   IndexStyleEnum& index_style
+)
+{
+   n = shared_->n_;
+   m = shared_->m_;
+   nnz_jac_g = shared_->nnz_jac_g_;
+   nnz_h_lag = shared_->nnz_h_lag_;
+   index_style = shared_->index_style_;
+   return true;
+}
+
+bool PortfolioTNLP::get_var_con_metadata(
+   Index                   n,
+   StringMetaDataMapType&  var_string_md,
+   IntegerMetaDataMapType& var_integer_md,
+   NumericMetaDataMapType& var_numeric_md,
+   Index                   m,
+   StringMetaDataMapType&  con_string_md,
+   IntegerMetaDataMapType& con_integer_md,
+   NumericMetaDataMapType& con_numeric_md
+)
+{
+   return tnlp_->get_var_con_metadata(n, var_string_md, var_integer_md, var_numeric_md, m, con_string_md,
+                                      con_integer_md, con_numeric_md);
+}
+
+bool PortfolioTNLP::get_bounds_info(
+   Index   n,
+   Number* x_l,
+   Number* x_u,
+   Index   m,
+   Number* g_l,
+   Number* g_u
+)
+{
+   DBG_ASSERT(n == shared_->n_);
+   DBG_ASSERT(m == shared_->m_);
+   std::copy(shared_->x_l_.begin(), shared_->x_l_.end(), x_l);
+   std::copy(shared_->x_u_.begin(), shared_->x_u_.end(), x_u);
+   std::copy(shared_->g_l_.begin(), shared_->g_l_.end(), g_l);
+   std::copy(shared_->g_u_.begin(), shared_->g_u_.end(), g_u);
+   (void) n;
+   (void) m;
+   return true;
+}
+
+bool PortfolioTNLP::get_scaling_parameters(
+   Number& obj_scaling,
+   bool&   use_x_scaling,
+   Index   n,
+   Number* x_scaling,
+   bool&   use_g_scaling,
+   Index   m,
+   Number* g_scaling
+)
+{
+   return tnlp_->get_scaling_parameters(obj_scaling, use_x_scaling, n, x_scaling, use_g_scaling, m, g_scaling);
+}
+
+bool PortfolioTNLP::get_variables_linearity(
+   Index          n,
+   LinearityType* var_types
+)
+{
+   return tnlp_->get_variables_linearity(n, var_types);
+}
+
+bool PortfolioTNLP::get_constraints_linearity(
+   Index          m,
+   LinearityType* const_types
+)
+{
+   return tnlp_->get_constraints_linearity(m, const_types);
+}
+
+bool PortfolioTNLP::get_starting_point(
+   Index   n,
+   bool    init_x,
+   Number* x,
+   bool    init_z,
+   Number* z_L,
+   Number* z_U,
+   Index   m,
+   bool    init_lambda,
+   Number* lambda
+)
+{
+   bool use_x_start = init_x && !x_start_.empty();
+   if( use_x_start && !init_z && !init_lambda )
+   {
+      std::copy(x_start_.begin(), x_start_.end(), x);
+      return true;
+   }
+
+   if( !tnlp_->get_starting_point(n, init_x, x, init_z, z_L, z_U, m, init_lambda, lambda) )
+   {
+      return false;
+   }
+   if( use_x_start )
+   {
+      std::copy(x_start_.begin(), x_start_.end(), x);
+   }
+   return true;
+}
+
+bool PortfolioTNLP::get_warm_start_iterate(
+   IteratesVector& warm_start_iterate
+)
+{
+   return tnlp_->get_warm_start_iterate(warm_start_iterate);
+}
+
+bool PortfolioTNLP::eval_f(
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Number&       obj_value
+)
+{
+   return tnlp_->eval_f(n, x, new_x, obj_value);
+}
+
+bool PortfolioTNLP::eval_grad_f(
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Number*       grad_f
+)
+{
+   return tnlp_->eval_grad_f(n, x, new_x, grad_f);
+}
+
+bool PortfolioTNLP::eval_g(
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Index         m,
+   Number*       g
+)
+{
+   return tnlp_->eval_g(n, x, new_x, m, g);
+}
+
+bool PortfolioTNLP::eval_jac_g(
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Index         m,
+   Index         nele_jac,
+   Index*        iRow,
+   Index*        jCol,
+   Number*       values
+)
+{
+   if( values == NULL )
+   {
+      DBG_ASSERT(nele_jac == shared_->nnz_jac_g_);
+      std::copy(shared_->jac_irow_.begin(), shared_->jac_irow_.end(), iRow);
+      std::copy(shared_->jac_jcol_.begin(), shared_->jac_jcol_.end(), jCol);
+      return true;
+   }
+   return tnlp_->eval_jac_g(n, x, new_x, m, nele_jac, iRow, jCol, values);
+}
+
+bool PortfolioTNLP::eval_h(
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Number        obj_factor,
+   Index         m,
+   const Number* lambda,
+   bool          new_lambda,
+   Index         nele_hess,
+   Index*        iRow,
+   Index*        jCol,
+   Number*       values
+)
+{
+   if( values == NULL && shared_->have_hess_structure_ )
+   {
+      DBG_ASSERT(nele_hess == shared_->nnz_h_lag_);
+      std::copy(shared_->hess_irow_.begin(), shared_->hess_irow_.end(), iRow);
+      std::copy(shared_->hess_jcol_.begin(), shared_->hess_jcol_.end(), jCol);
+      return true;
+   }
+   return tnlp_->eval_h(n, x, new_x, obj_factor, m, lambda, new_lambda, nele_hess, iRow, jCol, values);
+}
+
+bool PortfolioTNLP::eval_h_times_vec(
+   Index         n,
+   const Number* x,
+   bool          new_x,
+   Number        obj_factor,
+   Index         m,
+   const Number* lambda,
+   bool          new_lambda,
+   const Number* v,
+   Number*       hv
+)
+{
+   return tnlp_->eval_h_times_vec(n, x, new_x, obj_factor, m, lambda, new_lambda, v, hv);
+}
+
+Index PortfolioTNLP::get_number_of_nonlinear_variables()
+{
+   return tnlp_->get_number_of_nonlinear_variables();
+}
+
+bool PortfolioTNLP::get_list_of_nonlinear_variables(
+   Index  num_nonlin_vars,
+   Index* pos_nonlin_vars
+)
+{
+   return tnlp_->get_list_of_nonlinear_variables(num_nonlin_vars, pos_nonlin_vars);
+}
+
+void PortfolioTNLP::finalize_solution(
+   SolverReturn               status,
+   Index                      n,
+   const Number*              x,
+   const Number*              z_L,
+   const Number*              z_U,
+   Index                      m,
+   const Number*              g,
+   const Number*              lambda,
+   Number                     obj_value,
+   const IpoptData*           /*ip_data*/,
+   IpoptCalculatedQuantities* /*ip_cq*/
+)
+{
+   have_solution_ = true;
+   status_ = status;
+   x_.assign(x, x + n);
+   z_L_.assign(z_L, z_L + n);
+   z_U_.assign(z_U, z_U + n);
+   g_.assign(g, g + m);
+   lambda_.assign(lambda, lambda + m);
+   obj_value_ = obj_value;
+}
+
+void PortfolioTNLP::finalize_metadata(
+   Index                         /*n*/,
+   const StringMetaDataMapType&  var_string_md,
+   const IntegerMetaDataMapType& var_integer_md,
+   const NumericMetaDataMapType& var_numeric_md,
+   Index                         /*m*/,
+   const StringMetaDataMapType&  con_string_md,
+   const IntegerMetaDataMapType& con_integer_md,
+   const NumericMetaDataMapType& con_numeric_md
+)
+{
+   have_metadata_ = true;
+   var_string_md_ = var_string_md;
+   var_integer_md_ = var_integer_md;
+   var_numeric_md_ = var_numeric_md;
+   con_string_md_ = con_string_md;
+   con_integer_md_ = con_integer_md;
+   con_numeric_md_ = con_numeric_md;
+}
+
+bool PortfolioTNLP::intermediate_callback(
+   AlgorithmMode              mode,
+   Index                      iter,
+   Number                     obj_value,
+   Number                     inf_pr,
+   Number                     inf_du,
+   Number                     mu,
+   Number                     d_norm,
+   Number                     regularization_size,
+   Number                     alpha_du,
+   Number                     alpha_pr,
+   Index                      ls_trials,
+   const IpoptData*           ip_data,
+   IpoptCalculatedQuantities* ip_cq
+)
+{
+   if( shared_->Stopped() )
+   {
+      return false;
+   }
+   return tnlp_->intermediate_callback(mode, iter, obj_value, inf_pr, inf_du, mu, d_norm, regularization_size,
+                                       alpha_du, alpha_pr, ls_trials, ip_data, ip_cq);
+}
+
+void PortfolioTNLP::FinalizeSolution(
+   const IpoptData*           ip_data,
+   IpoptCalculatedQuantities* ip_cq
+)
+{
+   DBG_ASSERT(have_solution_);
+
+   const Index n = (Index) x_.size();
+   const Index m = (Index) g_.size();
+   if( have_metadata_ )
+   {
+      tnlp_->finalize_metadata(n, var_string_md_, var_integer_md_, var_numeric_md_, m, con_string_md_,
+                               con_integer_md_, con_numeric_md_);
+   }
+   tnlp_->finalize_solution(status_, n, n > 0 ? &x_[0] : NULL, n > 0 ? &z_L_[0] : NULL, n > 0 ? &z_U_[0] : NULL, m,
+                            m > 0 ? &g_[0] : NULL, m > 0 ? &lambda_[0] : NULL, obj_value_, ip_data, ip_cq);
+}
+
+} // namespace Ipopt
@@ -0,0 +1,393 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPPORTFOLIOTNLP_HPP__
+#define __IPPORTFOLIOTNLP_HPP__
+
+#include "IpTNLP.hpp"
+
+#include <vector>
+
+#if __cplusplus >= 201103L
+#include <atomic>
+#endif
+
+namespace Ipopt
+{
+
+/** Data that is shared by all solves of a portfolio (see
+ *  IpoptApplication::OptimizeTNLPPortfolio).
+ *
+ *  The dimensions, the bounds, and the sparsity structures of the
+ *  Jacobian and the Hessian are obtained from the TNLP only once and
+ *  then given to all solves.  Further, this holds the flag that is set
+ *  to stop all remaining solves.
+ */
+class PortfolioSharedData: public ReferencedObject
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   PortfolioSharedData();
+
+   virtual ~PortfolioSharedData();
+   ///@}
+
+   /** Obtain the problem information from the TNLP.
+    *
+    *  @return false, if the TNLP could not provide the dimensions, the bounds, or the Jacobian structure
+    */
+   bool Initialize(
+      TNLP& tnlp
+   );
+
+   /** Request that all remaining solves stop */
+   void Stop()
+   {
+      stopped_ = true;
+   }
+
+   /** Whether the solves should stop */
+   bool Stopped() const
+   {
+      return stopped_;
+   }
+
+   /**@name Problem information */
+   ///@{
+   Index n_;
+   Index m_;
+   Index nnz_jac_g_;
+   Index nnz_h_lag_;
+   TNLP::IndexStyleEnum index_style_;
+
+   std::vector<Number> x_l_;
+   std::vector<Number> x_u_;
+   std::vector<Number> g_l_;
+   std::vector<Number> g_u_;
+
+   std::vector<Index> jac_irow_;
+   std::vector<Index> jac_jcol_;
+
+   /** whether the TNLP provided the Hessian structure */
+   bool have_hess_structure_;
+   std::vector<Index> hess_irow_;
+   std::vector<Index> hess_jcol_;
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   PortfolioSharedData(
+      const PortfolioSharedData&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const PortfolioSharedData&
+   );
+   ///@}
+
+#if __cplusplus >= 201103L
+   std::atomic<bool> stopped_;
+#else
+   bool stopped_;
+#endif
+};
+
+/** This is a wrapper around a given TNLP for one solve of a
+ *  portfolio.
+ *
+ *  The problem information in PortfolioSharedData is returned instead
+ *  of asking the TNLP again, and the starting point can be replaced by
+ *  a perturbed one.  The final solution is kept instead of passing it
+ *  to the TNLP, so that only the best solution of the portfolio is
+ *  given to the TNLP (see FinalizeSolution).  The intermediate
+ *  callback stops the solve when all solves of the portfolio should
+ *  stop.  All evaluations are passed on to the TNLP, possibly from
+ *  several threads at the same time.
+ */
+class PortfolioTNLP: public TNLP
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Constructor.
+    *
+    *  @param tnlp     the TNLP of the portfolio
+    *  @param shared   the data of the portfolio, which needs to be initialized
+    *  @param x_start  starting point that replaces the one of the TNLP, or NULL; the values are copied
+    */
+   PortfolioTNLP(
+      const SmartPtr<TNLP>&                tnlp,
+      const SmartPtr<PortfolioSharedData>& shared,
+      const Number*                        x_start
+   );
+
+   /** Default destructor */
+   virtual ~PortfolioTNLP();
+   ///@}
+
+   /** @name Overloaded methods from TNLP */
+   ///@{
+   virtual bool get_nlp_info(
+      Index&          n,
+      Index&          m,
+      Index&          nnz_jac_g,
+      Index&          nnz_h_lag,
+      IndexStyleEnum& index_style
+   );
+
+   virtual bool get_var_con_metadata(
+      Index                   n,
+      StringMetaDataMapType&  var_string_md,
+      IntegerMetaDataMapType& var_integer_md,
+      NumericMetaDataMapType& var_numeric_md,
+      Index                   m,
+      StringMetaDataMapType&  con_string_md,
+      IntegerMetaDataMapType& con_integer_md,
+      NumericMetaDataMapType& con_numeric_md
+   );
+
+   virtual bool get_bounds_info(
+      Index   n,
+      Number* x_l,
+      Number* x_u,
+      Index   m,
+      Number* g_l,
+      Number* g_u
+   );
+
+   virtual bool get_scaling_parameters(
+      Number& obj_scaling,
+      bool&   use_x_scaling,
+      Index   n,
+      Number* x_scaling,
+      bool&   use_g_scaling,
+      Index   m,
+      Number* g_scaling
+   );
+
+   virtual bool get_variables_linearity(
+      Index          n,
+      LinearityType* var_types
+   );
+
+   virtual bool get_constraints_linearity(
+      Index          m,
+      LinearityType* const_types
+   );
+
+   virtual bool get_starting_point(
+      Index   n,
+      bool    init_x,
+      Number* x,
+      bool    init_z,
+      Number* z_L,
+      Number* z_U,
+      Index   m,
+      bool    init_lambda,
+      Number* lambda
+   );
+
+   virtual bool get_warm_start_iterate(
+      IteratesVector& warm_start_iterate
+   );
+
+   virtual bool eval_f(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Number&       obj_value
+   );
+
+   virtual bool eval_grad_f(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Number*       grad_f
+   );
+
+   virtual bool eval_g(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Index         m,
+      Number*       g
+   );
+
+   virtual bool eval_jac_g(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Index         m,
+      Index         nele_jac,
+      Index*        iRow,
+      Index*        jCol,
+      Number*       values
+   );
+
+   virtual bool eval_h(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Number        obj_factor,
+      Index         m,
+      const Number* lambda,
+      bool          new_lambda,
+      Index         nele_hess,
+      Index*        iRow,
+      Index*        jCol,
+      Number*       values
+   );
+
+   virtual bool eval_h_times_vec(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Number        obj_factor,
+      Index         m,
+      const Number* lambda,
+      bool          new_lambda,
+      const Number* v,
+      Number*       hv
+   );
+
+   virtual Index get_number_of_nonlinear_variables();
+
+   virtual bool get_list_of_nonlinear_variables(
+      Index  num_nonlin_vars,
+      Index* pos_nonlin_vars
+   );
+
+   virtual void finalize_solution(
+      SolverReturn               status,
+      Index                      n,
+      const Number*              x,
+      const Number*              z_L,
+      const Number*              z_U,
+      Index                      m,
+      const Number*              g,
+      const Number*              lambda,
+      Number                     obj_value,
+      const IpoptData*           ip_data,
+      IpoptCalculatedQuantities* ip_cq
+   );
+
+   virtual void finalize_metadata(
+      Index                         n,
+      const StringMetaDataMapType&  var_string_md,
+      const IntegerMetaDataMapType& var_integer_md,
+      const NumericMetaDataMapType& var_numeric_md,
+      Index                         m,
+      const StringMetaDataMapType&  con_string_md,
+      const IntegerMetaDataMapType& con_integer_md,
+      const NumericMetaDataMapType& con_numeric_md
+   );
+
+   virtual bool intermediate_callback(
+      AlgorithmMode              mode,
+      Index                      iter,
+      Number                     obj_value,
+      Number                     inf_pr,
+      Number                     inf_du,
+      Number                     mu,
+      Number                     d_norm,
+      Number                     regularization_size,
+      Number                     alpha_du,
+      Number                     alpha_pr,
+      Index                      ls_trials,
+      const IpoptData*           ip_data,
+      IpoptCalculatedQuantities* ip_cq
+   );
+   ///@}
+
+   /** Whether a final solution has been kept */
+   bool HasSolution() const
+   {
+      return have_solution_;
+   }
+
+   /** Objective function value of the kept final solution */
+   Number FinalObjective() const
+   {
+      return obj_value_;
+   }
+
+   /** Pass the kept final solution (and metadata) on to the TNLP */
+   void FinalizeSolution(
+      const IpoptData*           ip_data,
+      IpoptCalculatedQuantities* ip_cq
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   PortfolioTNLP();
+
+   /** Copy Constructor */
+   PortfolioTNLP(
+      const PortfolioTNLP&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const PortfolioTNLP&
+   );
+   ///@}
+
+   /** the TNLP of the portfolio */
+   SmartPtr<TNLP> tnlp_;
+
+   /** the data of the portfolio */
+   SmartPtr<PortfolioSharedData> shared_;
+
+   /** starting point that replaces the one of the TNLP (empty if none) */
+   std::vector<Number> x_start_;
+
+   /**@name Kept final solution */
+   ///@{
+   bool have_solution_;
+   SolverReturn status_;
+   std::vector<Number> x_;
+   std::vector<Number> z_L_;
+   std::vector<Number> z_U_;
+   std::vector<Number> g_;
+   std::vector<Number> lambda_;
+   Number obj_value_;
+   ///@}
+
+   /**@name Kept metadata */
+   ///@{
+   bool have_metadata_;
+   StringMetaDataMapType var_string_md_;
+   IntegerMetaDataMapType var_integer_md_;
+   NumericMetaDataMapType var_numeric_md_;
+   StringMetaDataMapType con_string_md_;
+   IntegerMetaDataMapType con_integer_md_;
+   NumericMetaDataMapType con_numeric_md_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -498,6 +498,55 @@ public:
       return false;
    }
 
+   /** Method to request the product of the Hessian of the Lagrangian with a vector.
+    *
+    * This method is called instead of eval_h if option hessian_evaluation is set to "products".
+    * It computes
+    * \f[ \left(\sigma_f \nabla^2 f(x_k) + \sum_{i=1}^m\lambda_i\nabla^2 g_i(x_k)\right) v \f]
+    * for the given values for \f$x\f$, \f$\sigma_f\f$, \f$\lambda\f$, and \f$v\f$,
+    * so that the Hessian never needs to be formed.
+    * This requires a linear solver that does not need the Hessian matrix itself.
+    *
+    *  @param n     (in) the number of variables \f$x\f$ in the problem; it will have the same value that was specified in TNLP::get_nlp_info
+    *  @param x     (in) the values for the primal variables \f$x\f$ at which the Hessian is to be evaluated
+    *  @param new_x (in) false if any evaluation method (`eval_*`) was previously called with the same values in x, true otherwise; see also TNLP::eval_f
+    *  @param obj_factor (in) factor \f$\sigma_f\f$ in front of the objective term in the Hessian
+    *  @param m     (in) the number of constraints \f$g(x)\f$ in the problem; it will have the same value that was specified in TNLP::get_nlp_info
+    *  @param lambda (in) the values for the constraint multipliers \f$\lambda\f$ at which the Hessian is to be evaluated
+    *  @param new_lambda (in) false if any evaluation method was previously called with the same values in lambda, true otherwise
+    *  @param v     (in) the vector that is to be multiplied with the Hessian, of length n
+    *  @param hv    (out) array of length n to store the product of the Hessian with v
+    *
+    *  @return true if success, false otherwise.
+    *
+    * The default implementation returns false.
+    *
+    * @since 3.15.0
+    */
+   virtual bool eval_h_times_vec(
+      Index         n,
+      const Number* x,
+      bool          new_x,
+      Number        obj_factor,
+      Index         m,
+      const Number* lambda,
+      bool          new_lambda,
+      const Number* v,
+      Number*       hv
+   )
+   {
+      (void) n;
+      (void) x;
+      (void) new_x;
+      (void) obj_factor;
+      (void) m;
+      (void) lambda;
+      (void) new_lambda;
+      (void) v;
+      (void) hv;
+      return false;
+   }
+
    /** @name Methods for quasi-Newton approximation.
     *
     *  If the second derivatives are approximated by %Ipopt, it is better
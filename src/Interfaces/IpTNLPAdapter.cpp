@@ -13,9 +13,11 @@
 #include "IpExpansionMatrix.hpp"
 #include "IpGenTMatrix.hpp"
 #include "IpSymTMatrix.hpp"
+#include "IpHessianVectorProductMatrix.hpp"
 #include "IpTDependencyDetector.hpp"
 #include "IpTSymDependencyDetector.hpp"
 #include "IpTripletToCSRConverter.hpp"
+#include "IpThreads.hpp"
 
 #ifdef IPOPT_HAS_HSL
 #include "CoinHslConfig.h"
@@ -32,6 +34,10 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
 
 namespace Ipopt
 {
@@ -55,8 +61,6 @@ TNLPAdapter::TNLPAdapter(
      y_d_tag_for_iterates_(0),
      x_tag_for_g_(0),
      x_tag_for_jac_g_(0),
-     jac_idx_map_(NULL),
-     h_idx_map_(NULL),
      x_fixed_map_(NULL),
      jac_fixed_idx_map_(NULL),
      jac_fixed_iRow_(NULL),
@@ -66,7 +70,22 @@ TNLPAdapter::TNLPAdapter(
      findiff_jac_ja_(NULL),
      findiff_jac_postriplet_(NULL),
      findiff_x_l_(NULL),
-     findiff_x_u_(NULL)
+     findiff_x_u_(NULL),
+     findiff_hess_jac_iRow_(NULL),
+     findiff_hess_jac_jCol_(NULL),
+     findiff_hess_iRow_(NULL),
+     findiff_hess_jCol_(NULL),
+     findiff_hess_ncolors_(0),
+     findiff_hess_color_vars_start_(NULL),
+     findiff_hess_color_vars_(NULL),
+     findiff_hess_color_nz_start_(NULL),
+     findiff_hess_color_nz_(NULL),
+     findiff_hess_pert_(NULL),
+     findiff_hess_nthreads_(1),
+     findiff_hess_grad_lag_ref_(NULL),
+     findiff_hess_grad_lag_pert_(NULL),
+     findiff_hess_jac_values_(NULL),
+     findiff_hess_x_pert_(NULL)
 {
    ASSERT_EXCEPTION(IsValid(tnlp_), INVALID_TNLP, "The TNLP passed to TNLPAdapter is NULL. This MUST be a valid TNLP!");
 }
@@ -78,8 +97,6 @@ TNLPAdapter::~TNLPAdapter()
    delete[] full_g_;
    delete[] jac_g_;
    delete[] c_rhs_;
-   delete[] jac_idx_map_;
-   delete[] h_idx_map_;
    delete[] x_fixed_map_;
    delete[] jac_fixed_idx_map_;
    delete[] jac_fixed_iRow_;
@@ -89,6 +106,19 @@ TNLPAdapter::~TNLPAdapter()
    delete[] findiff_jac_postriplet_;
    delete[] findiff_x_l_;
    delete[] findiff_x_u_;
+   delete[] findiff_hess_jac_iRow_;
+   delete[] findiff_hess_jac_jCol_;
+   delete[] findiff_hess_iRow_;
+   delete[] findiff_hess_jCol_;
+   delete[] findiff_hess_color_vars_start_;
+   delete[] findiff_hess_color_vars_;
+   delete[] findiff_hess_color_nz_start_;
+   delete[] findiff_hess_color_nz_;
+   delete[] findiff_hess_pert_;
+   delete[] findiff_hess_grad_lag_ref_;
+   delete[] findiff_hess_grad_lag_pert_;
+   delete[] findiff_hess_jac_values_;
+   delete[] findiff_hess_x_pert_;
 }
 
 void TNLPAdapter::RegisterOptions(
@@ -157,6 +187,17 @@ void TNLPAdapter::RegisterOptions(
       "The Hessian is then not approximated in this space. "
       "If the get_number_of_nonlinear_variables method in the TNLP is implemented, this option is ignored.",
       true);
+   roptions->AddLowerBoundedIntegerOption(
+      "evaluation_num_threads",
+      "Number of threads that evaluate the TNLP at perturbed points at once.",
+      0,
+      1,
+      "If larger than 1, the derivative checker, the finite-difference approximation of the Hessian "
+      "(option hessian_evaluation set to finite-difference-values), and equilibration-based scaling evaluate the TNLP at up to this many perturbed points at the same time. "
+      "The evaluation methods of the TNLP are then called from several threads at the same time, so they must be thread-safe. "
+      "If 0, the number of hardware threads is used. "
+      "Threads are only available if Ipopt has been built with C++11 support.",
+      true);
 
    roptions->SetRegisteringCategory("Derivative Checker");
    roptions->AddStringOption4(
@@ -196,6 +237,46 @@ void TNLPAdapter::RegisterOptions(
       "Indicates whether information for all estimated derivatives should be printed.",
       false,
       "Determines verbosity of derivative checker.");
+   roptions->AddLowerBoundedIntegerOption(
+      "derivative_test_sample_size",
+      "Number of randomly chosen variables for which derivatives are checked.",
+      0,
+      0,
+      "If this is set to 0, then derivatives with respect to all variables are checked. "
+      "Otherwise, only derivatives with respect to a random sample of this many variables are checked. "
+      "For the first derivative test, the sample is taken from the variables starting at derivative_test_first_index. "
+      "Since every checked variable requires an evaluation of the functions (first derivatives) or "
+      "their gradients (second derivatives), this can reduce the time for the derivative test considerably on large problems.");
+   roptions->AddBoolOption(
+      "derivative_test_colored",
+      "Whether the first derivative test perturbs several variables at once for evaluating the constraints.",
+      false,
+      "If enabled, variables that do not appear in a common constraint according to the sparsity structure "
+      "of the Jacobian are perturbed at the same time when evaluating the constraint functions, "
+      "so that the number of constraint evaluations is given by the number of colors of the sparsity structure. "
+      "The objective function is still evaluated once per checked variable. "
+      "Since the change of a constraint is then attributed to the variable that appears in it according to the sparsity structure, "
+      "a nonzero that is missing from the sparsity structure may not be detected or may be reported for another variable.");
+   roptions->AddLowerBoundedIntegerOption(
+      "derivative_test_random_directions",
+      "Number of random directions for which directional first derivatives are checked.",
+      0,
+      0,
+      "If positive, then the first derivative test additionally compares the directional derivatives "
+      "of objective and constraint functions along this many random directions with their finite difference approximations. "
+      "Each direction requires only one evaluation of the objective and constraint functions, "
+      "but a detected error can only be attributed to a function, not to a variable.");
+   roptions->AddStringOption1(
+      "derivative_test_report_file",
+      "File name for a report of the derivative checker (leave unset for no report).",
+      "",
+      "*", "Any acceptable standard file name",
+      "If set, then the derivative checker writes, for each function (objective, constraints, Hessians) "
+      "for which an error was detected, the entry with the largest relative deviation into this file. "
+      "Each line has the format \"kind function index1 index2 exact approx rel_error\", "
+      "where kind is one of grad_f, jac_g, dir_f, dir_g, obj_hess, constr_hess, "
+      "and function, index1, or index2 is -1 where not applicable (e.g., for the objective function). "
+      "Lines are sorted by decreasing relative error.");
    roptions->AddStringOption2(
       "jacobian_approximation",
       "Specifies technique to compute constraint Jacobian",
@@ -204,6 +285,23 @@ void TNLPAdapter::RegisterOptions(
       "finite-difference-values", "user-provided structure, values by finite differences",
       "",
       true);
+   roptions->AddStringOption3(
+      "hessian_evaluation",
+      "Specifies technique to compute values of the Hessian of the Lagrangian",
+      "exact",
+      "exact", "user-provided second derivatives",
+      "finite-difference-values", "user-provided structure, values by finite differences of gradients",
+      "products", "user-provided products of the Hessian with vectors",
+      "This option is only used if hessian_approximation is set to exact. "
+      "For finite-difference-values, only the structure of the Hessian needs to be provided by eval_h. "
+      "The values are approximated by finite differences of the gradient of the Lagrangian, "
+      "which is computed from the objective gradient and the constraint Jacobian. "
+      "To reduce the number of gradient evaluations, variables whose Hessian columns do not share a row "
+      "are perturbed simultaneously (coloring of the sparsity structure). "
+      "This requires jacobian_approximation to be set to exact. "
+      "For products, the Hessian is never formed and only products with vectors are requested from eval_h_times_vec. "
+      "This requires a linear solver for the KKT system that needs only such products.",
+      true);
    roptions->AddLowerBoundedNumberOption(
       "findiff_perturbation",
       "Size of the finite difference perturbation for derivative approximation.",
@@ -244,6 +342,10 @@ bool TNLPAdapter::ProcessOptions(
    options.GetNumericValue("derivative_test_tol", derivative_test_tol_, prefix);
    options.GetBoolValue("derivative_test_print_all", derivative_test_print_all_, prefix);
    options.GetIntegerValue("derivative_test_first_index", derivative_test_first_index_, prefix);
+   options.GetIntegerValue("derivative_test_sample_size", derivative_test_sample_size_, prefix);
+   options.GetBoolValue("derivative_test_colored", derivative_test_colored_, prefix);
+   options.GetIntegerValue("derivative_test_random_directions", derivative_test_random_directions_, prefix);
+   options.GetStringValue("derivative_test_report_file", derivative_test_report_file_, prefix);
 
    // The option warm_start_same_structure is registered by OrigIpoptNLP
    options.GetBoolValue("warm_start_same_structure", warm_start_same_structure_, prefix);
@@ -254,13 +356,21 @@ bool TNLPAdapter::ProcessOptions(
 
    options.GetEnumValue("jacobian_approximation", enum_int, prefix);
    jacobian_approximation_ = JacobianApproxEnum(enum_int);
+   options.GetEnumValue("hessian_evaluation", enum_int, prefix);
+   hessian_evaluation_ = HessianEvalEnum(enum_int);
    options.GetNumericValue("findiff_perturbation", findiff_perturbation_, prefix);
 
+   ASSERT_EXCEPTION(hessian_evaluation_ != HESS_FINDIFF_VALUES || jacobian_approximation_ == JAC_EXACT, OPTION_INVALID,
+                    "Option \"hessian_evaluation\" can only be set to \"finite-difference-values\" if \"jacobian_approximation\" is \"exact\".");
+
    options.GetNumericValue("point_perturbation_radius", point_perturbation_radius_, prefix);
 
    options.GetNumericValue("tol", tol_, prefix);
 
    options.GetBoolValue("dependency_detection_with_rhs", dependency_detection_with_rhs_, prefix);
+   // The option num_threads is registered by IpoptApplication
+   options.GetIntegerValue("num_threads", num_threads_, prefix);
+   options.GetIntegerValue("evaluation_num_threads", evaluation_num_threads_, prefix);
    std::string dependency_detector;
    options.GetStringValue("dependency_detector", dependency_detector, prefix);
 #ifdef IPOPT_HAS_MUMPS
@@ -307,6 +417,360 @@ bool TNLPAdapter::ProcessOptions(
    return true;
 }
 
+TNLPAdapter::GatherPlan::GatherPlan()
+   : nnz_(0),
+     nruns_(0),
+     run_start_(NULL),
+     run_end_(NULL),
+     pos_(NULL)
+{ }
+
+TNLPAdapter::GatherPlan::~GatherPlan()
+{
+   Clear();
+}
+
+void TNLPAdapter::GatherPlan::Clear()
+{
+   delete[] run_start_;
+   run_start_ = NULL;
+   delete[] run_end_;
+   run_end_ = NULL;
+   delete[] pos_;
+   pos_ = NULL;
+   nnz_ = 0;
+   nruns_ = 0;
+}
+
+void TNLPAdapter::GatherPlan::Initialize(
+   Index        nnz,
+   const Index* pos
+)
+{
+   Clear();
+   nnz_ = nnz;
+
+   Index nruns = 0;
+   for( Index i = 0; i < nnz; i++ )
+   {
+      DBG_ASSERT(i == 0 || pos[i] > pos[i - 1]);
+      if( i == 0 || pos[i] != pos[i - 1] + 1 )
+      {
+         nruns++;
+      }
+   }
+
+   // runs need two numbers each, so only use them if they are long enough on average
+   if( 4 * nruns > nnz )
+   {
+      nruns_ = -1;
+      pos_ = new Index[nnz];
+      for( Index i = 0; i < nnz; i++ )
+      {
+         pos_[i] = pos[i];
+      }
+      return;
+   }
+
+   nruns_ = nruns;
+   run_start_ = new Index[nruns];
+   run_end_ = new Index[nruns];
+   Index run = -1;
+   for( Index i = 0; i < nnz; i++ )
+   {
+      if( i == 0 || pos[i] != pos[i - 1] + 1 )
+      {
+         run++;
+         run_start_[run] = pos[i];
+      }
+      run_end_[run] = i + 1;
+   }
+}
+
+void TNLPAdapter::GatherPlan::Gather(
+   const Number* src,
+   Number*       dst
+) const
+{
+   if( nruns_ < 0 )
+   {
+      for( Index i = 0; i < nnz_; i++ )
+      {
+         dst[i] = src[pos_[i]];
+      }
+      return;
+   }
+
+   Index i = 0;
+   for( Index run = 0; run < nruns_; run++ )
+   {
+      const Index offset = run_start_[run] - i;
+      for( ; i < run_end_[run]; i++ )
+      {
+         dst[i] = src[offset + i];
+      }
+   }
+}
+
+/** nonzero structure of the Jacobians of c and d (w.r.t. non-fixed variables)
+ *  and of the Jacobian of g w.r.t. fixed variables, as built in GetSpaces
+ */
+struct JacStructure
+{
+   Index* c_idx_map;
+   Index* c_iRow;
+   Index* c_jCol;
+   Index* d_idx_map;
+   Index* d_iRow;
+   Index* d_jCol;
+   Index* fixed_idx_map;
+   Index* fixed_iRow;
+   Index* fixed_jCol;
+};
+
+/** sorts the nonzeros begin,...,end-1 of the Jacobian of g into the Jacobians of c and d and the Jacobian w.r.t. fixed variables
+ *
+ *  If out is NULL, then only the number of nonzeros for c, d, and the fixed variables
+ *  are added to nz[0], nz[1], and nz[2], respectively.
+ *  Otherwise, the nonzeros are written to out starting at the positions given by nz.
+ */
+static void PartitionJacobianStructure(
+   Index               begin,
+   Index               end,
+   const Index*        g_iRow,    /**< row indices of the Jacobian of g (1-based) */
+   const Index*        g_jCol,    /**< column indices of the Jacobian of g (1-based) */
+   const Index*        c_row_pos, /**< position of each constraint in c, or -1 */
+   const Index*        d_row_pos, /**< position of each constraint in d, or -1 */
+   const Index*        col_pos,   /**< position of each variable in x, or -1; NULL if there are no fixed variables */
+   bool                keep_fixed,/**< whether to collect the nonzeros w.r.t. fixed variables */
+   const JacStructure* out,
+   Index*              nz
+)
+{
+   Index nz_c = nz[0];
+   Index nz_d = nz[1];
+   Index nz_fixed = nz[2];
+   for( Index i = begin; i < end; i++ )
+   {
+      const Index col = col_pos != NULL ? col_pos[g_jCol[i] - 1] : g_jCol[i] - 1;
+      if( col == -1 )
+      {
+         if( keep_fixed )
+         {
+            if( out != NULL )
+            {
+               out->fixed_idx_map[nz_fixed] = i;
+               out->fixed_iRow[nz_fixed] = g_iRow[i];
+               out->fixed_jCol[nz_fixed] = g_jCol[i];
+            }
+            nz_fixed++;
+         }
+         continue;
+      }
+      const Index c_row = c_row_pos[g_iRow[i] - 1];
+      if( c_row != -1 )
+      {
+         if( out != NULL )
+         {
+            out->c_idx_map[nz_c] = i;
+            out->c_iRow[nz_c] = c_row + 1;
+            out->c_jCol[nz_c] = col + 1;
+         }
+         nz_c++;
+         continue;
+      }
+      const Index d_row = d_row_pos[g_iRow[i] - 1];
+      if( d_row != -1 )
+      {
+         if( out != NULL )
+         {
+            out->d_idx_map[nz_d] = i;
+            out->d_iRow[nz_d] = d_row + 1;
+            out->d_jCol[nz_d] = col + 1;
+         }
+         nz_d++;
+      }
+   }
+   nz[0] = nz_c;
+   nz[1] = nz_d;
+   nz[2] = nz_fixed;
+}
+
+/** calls PartitionJacobianStructure for one block of the nonzeros per part */
+class PartitionJacobianStructureWork: public ParallelWork
+{
+public:
+   PartitionJacobianStructureWork(
+      Index               nblocks,
+      Index               nnz,
+      const Index*        g_iRow,
+      const Index*        g_jCol,
+      const Index*        c_row_pos,
+      const Index*        d_row_pos,
+      const Index*        col_pos,
+      bool                keep_fixed,
+      const JacStructure* out,
+      Index*              block_nz
+   )
+      : block_size_((nnz + nblocks - 1) / nblocks),
+        nnz_(nnz),
+        g_iRow_(g_iRow),
+        g_jCol_(g_jCol),
+        c_row_pos_(c_row_pos),
+        d_row_pos_(d_row_pos),
+        col_pos_(col_pos),
+        keep_fixed_(keep_fixed),
+        out_(out),
+        block_nz_(block_nz)
+   { }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      PartitionJacobianStructure(std::min(k * block_size_, nnz_), std::min((k + 1) * block_size_, nnz_), g_iRow_,
+                                 g_jCol_, c_row_pos_, d_row_pos_, col_pos_, keep_fixed_, out_, &block_nz_[3 * k]);
+   }
+
+private:
+   Index               block_size_;
+   Index               nnz_;
+   const Index*        g_iRow_;
+   const Index*        g_jCol_;
+   const Index*        c_row_pos_;
+   const Index*        d_row_pos_;
+   const Index*        col_pos_;
+   bool                keep_fixed_;
+   const JacStructure* out_;
+   Index*              block_nz_;
+};
+
+/** calls PartitionJacobianStructure for each of nblocks blocks of the nonzeros
+ *
+ *  block_nz holds three counters for each block.
+ *  The blocks are processed in parallel.
+ */
+static void PartitionJacobianStructureBlocks(
+   Index               nblocks,
+   Index               nnz,
+   const Index*        g_iRow,
+   const Index*        g_jCol,
+   const Index*        c_row_pos,
+   const Index*        d_row_pos,
+   const Index*        col_pos,
+   bool                keep_fixed,
+   const JacStructure* out,
+   Index*              block_nz
+)
+{
+   PartitionJacobianStructureWork work(nblocks, nnz, g_iRow, g_jCol, c_row_pos, d_row_pos, col_pos, keep_fixed, out,
+                                       block_nz);
+   DoParallelWork(nblocks, work);
+}
+
+/** removes the nonzeros w.r.t. fixed variables from the nonzeros begin,...,end-1 of the Hessian
+ *
+ *  If h_idx_map is NULL, then only the number of remaining nonzeros is added to nz.
+ *  Otherwise, the remaining nonzeros are written starting at position nz.
+ */
+static void PartitionHessianStructure(
+   Index        begin,
+   Index        end,
+   const Index* full_h_iRow, /**< row indices of the full Hessian (1-based) */
+   const Index* full_h_jCol, /**< column indices of the full Hessian (1-based) */
+   const Index* h_pos,       /**< position of each variable in x, or -1 */
+   Index*       h_idx_map,
+   Index*       h_iRow,
+   Index*       h_jCol,
+   Index*       nz
+)
+{
+   Index current_nz = *nz;
+   for( Index i = begin; i < end; i++ )
+   {
+      const Index h_row = h_pos[full_h_iRow[i] - 1];
+      const Index h_col = h_pos[full_h_jCol[i] - 1];
+      if( h_row != -1 && h_col != -1 )
+      {
+         if( h_idx_map != NULL )
+         {
+            h_idx_map[current_nz] = i;
+            h_iRow[current_nz] = h_row + 1;
+            h_jCol[current_nz] = h_col + 1;
+         }
+         current_nz++;
+      }
+   }
+   *nz = current_nz;
+}
+
+/** calls PartitionHessianStructure for one block of the nonzeros per part */
+class PartitionHessianStructureWork: public ParallelWork
+{
+public:
+   PartitionHessianStructureWork(
+      Index        nblocks,
+      Index        nnz,
+      const Index* full_h_iRow,
+      const Index* full_h_jCol,
+      const Index* h_pos,
+      Index*       h_idx_map,
+      Index*       h_iRow,
+      Index*       h_jCol,
+      Index*       block_nz
+   )
+      : block_size_((nnz + nblocks - 1) / nblocks),
+        nnz_(nnz),
+        full_h_iRow_(full_h_iRow),
+        full_h_jCol_(full_h_jCol),
+        h_pos_(h_pos),
+        h_idx_map_(h_idx_map),
+        h_iRow_(h_iRow),
+        h_jCol_(h_jCol),
+        block_nz_(block_nz)
+   { }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      PartitionHessianStructure(std::min(k * block_size_, nnz_), std::min((k + 1) * block_size_, nnz_), full_h_iRow_,
+                                full_h_jCol_, h_pos_, h_idx_map_, h_iRow_, h_jCol_, &block_nz_[k]);
+   }
+
+private:
+   Index        block_size_;
+   Index        nnz_;
+   const Index* full_h_iRow_;
+   const Index* full_h_jCol_;
+   const Index* h_pos_;
+   Index*       h_idx_map_;
+   Index*       h_iRow_;
+   Index*       h_jCol_;
+   Index*       block_nz_;
+};
+
+/** calls PartitionHessianStructure for each of nblocks blocks of the nonzeros
+ *
+ *  The blocks are processed in parallel.
+ */
+static void PartitionHessianStructureBlocks(
+   Index        nblocks,
+   Index        nnz,
+   const Index* full_h_iRow,
+   const Index* full_h_jCol,
+   const Index* h_pos,
+   Index*       h_idx_map,
+   Index*       h_iRow,
+   Index*       h_jCol,
+   Index*       block_nz
+)
+{
+   PartitionHessianStructureWork work(nblocks, nnz, full_h_iRow, full_h_jCol, h_pos, h_idx_map, h_iRow, h_jCol,
+                                      block_nz);
+   DoParallelWork(nblocks, work);
+}
+
 bool TNLPAdapter::GetSpaces(
    SmartPtr<const VectorSpace>&    x_space,
    SmartPtr<const VectorSpace>&    c_space,
@@ -360,10 +824,6 @@ bool TNLPAdapter::GetSpaces(
       jac_g_ = NULL;
       delete[] c_rhs_;
       c_rhs_ = NULL;
-      delete[] jac_idx_map_;
-      jac_idx_map_ = NULL;
-      delete[] h_idx_map_;
-      h_idx_map_ = NULL;
       delete[] x_fixed_map_;
       x_fixed_map_ = NULL;
       delete[] jac_fixed_idx_map_;
@@ -624,12 +1084,43 @@ bool TNLPAdapter::GetSpaces(
          }
       } // while (!done)
 
+      // Get the non zero structure of the Jacobian, which is needed for the
+      // dependency detection and for the Jacobian spaces below
+      Index* g_iRow = new Index[nz_full_jac_g_];
+      Index* g_jCol = new Index[nz_full_jac_g_];
+      tnlp_->eval_jac_g(n_full_x_, NULL, false, n_full_g_, nz_full_jac_g_, g_iRow, g_jCol, NULL);
+
+      if( index_style_ != TNLP::FORTRAN_STYLE )
+      {
+         for( Index i = 0; i < nz_full_jac_g_; i++ )
+         {
+            DBG_ASSERT(g_iRow[i] >= 0);
+            DBG_ASSERT(g_iRow[i] < n_full_g_);
+            DBG_ASSERT(g_jCol[i] >= 0);
+            DBG_ASSERT(g_jCol[i] < n_full_x_);
+            g_iRow[i] += 1;
+            g_jCol[i] += 1;
+         }
+      }
+#if IPOPT_CHECKLEVEL > 0
+      else
+      {
+         for( Index i = 0; i < nz_full_jac_g_; i++ )
+         {
+            DBG_ASSERT(g_iRow[i] > 0);
+            DBG_ASSERT(g_iRow[i] <= n_full_g_);
+            DBG_ASSERT(g_jCol[i] > 0);
+            DBG_ASSERT(g_jCol[i] <= n_full_x_);
+         }
+      }
+#endif
+
       // If requested, check if there are linearly dependent equality
       // constraints
       if( n_c > 0 && IsValid(dependency_detector_) )
       {
          std::list<Index> c_deps;
-         if( !DetermineDependentConstraints(n_x_var, x_not_fixed_map, x_l, x_u, g_l, g_u, n_c, c_map, c_deps) )
+         if( !DetermineDependentConstraints(n_x_var, x_not_fixed_map, x_l, x_u, g_l, g_u, n_c, c_map, g_iRow, g_jCol, c_deps) )
          {
             jnlst_->Printf(J_WARNING, J_INITIALIZATION,
                            "Dependent constraint detector had a problem, assume full rank.\n");
@@ -1035,44 +1526,30 @@ bool TNLPAdapter::GetSpaces(
 
       /** Create the matrix space for the jacobians
        */
-      // Get the non zero structure
-      Index* g_iRow = new Index[nz_full_jac_g_];
-      Index* g_jCol = new Index[nz_full_jac_g_];
-      tnlp_->eval_jac_g(n_full_x_, NULL, false, n_full_g_, nz_full_jac_g_, g_iRow, g_jCol, NULL);
-
-      if( index_style_ != TNLP::FORTRAN_STYLE )
+      if( nz_full_jac_g_ > 0 && jacobian_approximation_ == JAC_FINDIFF_VALUES )
       {
-         for( Index i = 0; i < nz_full_jac_g_; i++ )
-         {
-            DBG_ASSERT(g_iRow[i] >= 0);
-            DBG_ASSERT(g_iRow[i] < n_full_g_);
-            DBG_ASSERT(g_jCol[i] >= 0);
-            DBG_ASSERT(g_jCol[i] < n_full_x_);
-            g_iRow[i] += 1;
-            g_jCol[i] += 1;
-         }
+         initialize_findiff_jac(g_iRow, g_jCol);
       }
-#if IPOPT_CHECKLEVEL > 0
-      else
+
+      if( hessian_approximation_ == EXACT && hessian_evaluation_ == HESS_FINDIFF_VALUES )
       {
+         // keep the Jacobian structure for computing the gradient of the Lagrangian
+         delete[] findiff_hess_jac_iRow_;
+         delete[] findiff_hess_jac_jCol_;
+         findiff_hess_jac_iRow_ = new Index[nz_full_jac_g_];
+         findiff_hess_jac_jCol_ = new Index[nz_full_jac_g_];
          for( Index i = 0; i < nz_full_jac_g_; i++ )
          {
-            DBG_ASSERT(g_iRow[i] > 0);
-            DBG_ASSERT(g_iRow[i] <= n_full_g_);
-            DBG_ASSERT(g_jCol[i] > 0);
-            DBG_ASSERT(g_jCol[i] <= n_full_x_);
+            findiff_hess_jac_iRow_[i] = g_iRow[i] - 1;
+            findiff_hess_jac_jCol_[i] = g_jCol[i] - 1;
          }
       }
-#endif
-
-      if( nz_full_jac_g_ > 0 && jacobian_approximation_ == JAC_FINDIFF_VALUES )
-      {
-         initialize_findiff_jac(g_iRow, g_jCol);
-      }
 
-      // ... build the non-zero structure for jac_c
-      // ... (the permutation from rows in jac_g to jac_c is
-      // ...  the same as P_c_g_)
+      // ... build the non-zero structures for jac_c and jac_d
+      // ... (the permutation from rows in jac_g to jac_c and jac_d is
+      // ...  the same as P_c_g_ and P_d_g_, respectively)
+      // ... in one pass that counts the nonzeros of each part for blocks
+      // ... of the entries and a second pass that writes them into place
       Index nz_jac_all;
       if( fixed_variable_treatment_ == MAKE_PARAMETER || fixed_variable_treatment_ == MAKE_PARAMETER_NODUAL )
       {
@@ -1082,68 +1559,72 @@ bool TNLPAdapter::GetSpaces(
       {
          nz_jac_all = nz_full_jac_g_ + n_x_fixed_;
       }
-      jac_idx_map_ = new Index[nz_jac_all];
-      Index* jac_c_iRow = new Index[nz_jac_all];
-      Index* jac_c_jCol = new Index[nz_jac_all];
-      Index current_nz = 0;
+      const bool keep_fixed = fixed_variable_treatment_ == MAKE_PARAMETER && IsValid(P_x_full_x_);
+      const Index* c_row_pos = P_c_g_->CompressedPosIndices();
+      const Index* d_row_pos = P_d_g_->CompressedPosIndices();
+      const Index* col_pos = IsValid(P_x_full_x_) ? P_x_full_x_->CompressedPosIndices() : NULL;
 
-      // prepare memory for mapping from Jacobian on fixed variables to full Jacobian
-      // cppcheck-suppress unreadVariable
-      Index jac_fixed_length = 0;
-      if( fixed_variable_treatment_ == MAKE_PARAMETER && IsValid(P_x_full_x_) )
+      const Index jac_nblocks = NumWorkThreads(num_threads_, nz_full_jac_g_);
+      Index* jac_block_nz = new Index[3 * jac_nblocks];
+      for( Index k = 0; k < 3 * jac_nblocks; k++ )
       {
-         nz_jac_fixed_ = 0;
-         // the Jacobian w.r.t. fixed variables can have at most number-of-fixed-variables*number-of-constraints nonzeros
-         jac_fixed_length = std::min(nz_jac_all, n_x_fixed_ * n_full_g);
-         jac_fixed_idx_map_ = new Index[jac_fixed_length];
-         jac_fixed_iRow_ = new Index[jac_fixed_length];
-         jac_fixed_jCol_ = new Index[jac_fixed_length];
+         jac_block_nz[k] = 0;
       }
+      PartitionJacobianStructureBlocks(jac_nblocks, nz_full_jac_g_, g_iRow, g_jCol, c_row_pos, d_row_pos, col_pos,
+                                       keep_fixed, NULL, jac_block_nz);
 
-      const Index* c_row_pos = P_c_g_->CompressedPosIndices();
-      if( IsValid(P_x_full_x_) )
+      // turn the counts into the starting positions of each block
+      Index current_nz = 0;
+      Index nz_d = 0;
+      Index nz_fixed = 0;
+      for( Index k = 0; k < jac_nblocks; k++ )
       {
-         // there are missing variables x
-         const Index* c_col_pos = P_x_full_x_->CompressedPosIndices();
-         for( Index i = 0; i < nz_full_jac_g_; i++ )
-         {
-            const Index& c_row = c_row_pos[g_iRow[i] - 1];
-            const Index& c_col = c_col_pos[g_jCol[i] - 1];
-            if( c_col != -1 && c_row != -1 )
-            {
-               jac_idx_map_[current_nz] = i;
-               jac_c_iRow[current_nz] = c_row + 1;
-               jac_c_jCol[current_nz] = c_col + 1;
-               current_nz++;
-            }
-            else if( c_col == -1 && fixed_variable_treatment_ == MAKE_PARAMETER )
-            {
-               // c_col == -1 should mean a fixed variables
-               // c_row == -1 should mean a row in d(x)  (but the distinction into c(x) and d(x) isn't relevant for us here)
-               DBG_ASSERT(nz_jac_fixed_ < jac_fixed_length);
-               jac_fixed_idx_map_[nz_jac_fixed_] = i;
-               jac_fixed_iRow_[nz_jac_fixed_] = g_iRow[i];
-               jac_fixed_jCol_[nz_jac_fixed_] = g_jCol[i];
-               nz_jac_fixed_++;
-            }
-         }
+         Index count = jac_block_nz[3 * k];
+         jac_block_nz[3 * k] = current_nz;
+         current_nz += count;
+         count = jac_block_nz[3 * k + 1];
+         jac_block_nz[3 * k + 1] = nz_d;
+         nz_d += count;
+         count = jac_block_nz[3 * k + 2];
+         jac_block_nz[3 * k + 2] = nz_fixed;
+         nz_fixed += count;
+      }
+      nz_jac_c_no_extra_ = current_nz;
+      nz_jac_d_ = nz_d;
+
+      JacStructure jac;
+      Index* jac_idx_map = new Index[nz_jac_c_no_extra_ + nz_jac_d_];
+      jac.c_idx_map = jac_idx_map;
+      jac.c_iRow = new Index[nz_jac_all];
+      jac.c_jCol = new Index[nz_jac_all];
+      jac.d_idx_map = jac_idx_map + nz_jac_c_no_extra_;
+      jac.d_iRow = new Index[nz_jac_d_];
+      jac.d_jCol = new Index[nz_jac_d_];
+      jac.fixed_idx_map = NULL;
+      jac.fixed_iRow = NULL;
+      jac.fixed_jCol = NULL;
+      if( keep_fixed )
+      {
+         // mapping from Jacobian on fixed variables to full Jacobian
+         nz_jac_fixed_ = nz_fixed;
+         jac_fixed_idx_map_ = new Index[nz_jac_fixed_];
+         jac_fixed_iRow_ = new Index[nz_jac_fixed_];
+         jac_fixed_jCol_ = new Index[nz_jac_fixed_];
+         jac.fixed_idx_map = jac_fixed_idx_map_;
+         jac.fixed_iRow = jac_fixed_iRow_;
+         jac.fixed_jCol = jac_fixed_jCol_;
       }
       else
       {
-         for( Index i = 0; i < nz_full_jac_g_; i++ )
-         {
-            const Index& c_row = c_row_pos[g_iRow[i] - 1];
-            const Index& c_col = g_jCol[i] - 1;
-            if( c_row != -1 )
-            {
-               jac_idx_map_[current_nz] = i;
-               jac_c_iRow[current_nz] = c_row + 1;
-               jac_c_jCol[current_nz] = c_col + 1;
-               current_nz++;
-            }
-         }
+         nz_jac_fixed_ = 0;
       }
-      nz_jac_c_no_extra_ = current_nz;
+      PartitionJacobianStructureBlocks(jac_nblocks, nz_full_jac_g_, g_iRow, g_jCol, c_row_pos, d_row_pos, col_pos,
+                                       keep_fixed, &jac, jac_block_nz);
+      delete[] jac_block_nz;
+      jac_c_plan_.Initialize(nz_jac_c_no_extra_, jac.c_idx_map);
+      jac_d_plan_.Initialize(nz_jac_d_, jac.d_idx_map);
+      delete[] jac_idx_map;
+
       Index n_added_constr;
       if( fixed_variable_treatment_ == MAKE_PARAMETER || fixed_variable_treatment_ == MAKE_PARAMETER_NODUAL )
       {
@@ -1155,70 +1636,33 @@ bool TNLPAdapter::GetSpaces(
          nz_jac_c_ = nz_jac_c_no_extra_ + n_x_fixed_;
          for( Index i = 0; i < n_x_fixed_; i++ )
          {
-            jac_c_iRow[current_nz] = n_c + i + 1;
-            jac_c_jCol[current_nz] = x_fixed_map_[i] + 1;
+            jac.c_iRow[current_nz] = n_c + i + 1;
+            jac.c_jCol[current_nz] = x_fixed_map_[i] + 1;
             current_nz++;
          }
          n_added_constr = n_x_fixed_;
       }
 
-      Jac_c_space_ = new GenTMatrixSpace(n_c + n_added_constr, n_x_var, nz_jac_c_, jac_c_iRow, jac_c_jCol);
-      delete[] jac_c_iRow;
-      jac_c_iRow = NULL;
-      delete[] jac_c_jCol;
-      jac_c_jCol = NULL;
-
-      // ... build the nonzero structure for jac_d
-      // ... (the permutation from rows in jac_g to jac_c is the
-      // ...  the same as P_d_g_)
-      Index* jac_d_iRow = new Index[nz_full_jac_g_];
-      Index* jac_d_jCol = new Index[nz_full_jac_g_];
-      current_nz = 0;
-      const Index* d_row_pos = P_d_g_->CompressedPosIndices();
-      if( IsValid(P_x_full_x_) )
-      {
-         const Index* d_col_pos = P_x_full_x_->CompressedPosIndices();
-         for( Index i = 0; i < nz_full_jac_g_; i++ )
-         {
-            const Index& d_row = d_row_pos[g_iRow[i] - 1];
-            const Index& d_col = d_col_pos[g_jCol[i] - 1];
-            if( d_col != -1 && d_row != -1 )
-            {
-               jac_idx_map_[current_nz + nz_jac_c_no_extra_] = i;
-               jac_d_iRow[current_nz] = d_row + 1;
-               jac_d_jCol[current_nz] = d_col + 1;
-               current_nz++;
-            }
-         }
-      }
-      else
-      {
-         for( Index i = 0; i < nz_full_jac_g_; i++ )
-         {
-            const Index& d_row = d_row_pos[g_iRow[i] - 1];
-            const Index& d_col = g_jCol[i] - 1;
-            if( d_row != -1 )
-            {
-               jac_idx_map_[current_nz + nz_jac_c_no_extra_] = i;
-               jac_d_iRow[current_nz] = d_row + 1;
-               jac_d_jCol[current_nz] = d_col + 1;
-               current_nz++;
-            }
-         }
-      }
-      nz_jac_d_ = current_nz;
-      Jac_d_space_ = new GenTMatrixSpace(n_d, n_x_var, nz_jac_d_, jac_d_iRow, jac_d_jCol);
-      delete[] jac_d_iRow;
-      jac_d_iRow = NULL;
-      delete[] jac_d_jCol;
-      jac_d_jCol = NULL;
+      Jac_c_space_ = new GenTMatrixSpace(n_c + n_added_constr, n_x_var, nz_jac_c_, jac.c_iRow, jac.c_jCol);
+      delete[] jac.c_iRow;
+      delete[] jac.c_jCol;
+
+      Jac_d_space_ = new GenTMatrixSpace(n_d, n_x_var, nz_jac_d_, jac.d_iRow, jac.d_jCol);
+      delete[] jac.d_iRow;
+      delete[] jac.d_jCol;
 
       delete[] g_iRow;
       g_iRow = NULL;
       delete[] g_jCol;
       g_jCol = NULL;
 
-      if( hessian_approximation_ == EXACT )
+      if( hessian_approximation_ == EXACT && hessian_evaluation_ == HESS_PRODUCTS )
+      {
+         // the Hessian is only available through products with vectors, so no structure is needed
+         nz_h_ = 0;
+         Hess_lagrangian_space_ = new HessianVectorProductMatrixSpace(n_x_var);
+      }
+      else if( hessian_approximation_ == EXACT )
       {
          /** Create the matrix space for the hessian of the lagrangian */
          Index* full_h_iRow = new Index[nz_full_h_];
@@ -1263,27 +1707,41 @@ bool TNLPAdapter::GetSpaces(
          }
 #endif
 
+         if( hessian_evaluation_ == HESS_FINDIFF_VALUES )
+         {
+            initialize_findiff_hess(full_h_iRow, full_h_jCol);
+         }
+
          current_nz = 0;
          if( IsValid(P_x_full_x_) )
          {
-            h_idx_map_ = new Index[nz_full_h_];
+            // count the remaining nonzeros for blocks of the entries, then write them into place
+            Index* h_idx_map = new Index[nz_full_h_];
             const Index* h_pos = P_x_full_x_->CompressedPosIndices();
-            for( Index i = 0; i < nz_full_h_; i++ )
+            const Index h_nblocks = NumWorkThreads(num_threads_, nz_full_h_);
+            Index* h_block_nz = new Index[h_nblocks];
+            for( Index k = 0; k < h_nblocks; k++ )
             {
-               const Index& h_row = h_pos[full_h_iRow[i] - 1];
-               const Index& h_col = h_pos[full_h_jCol[i] - 1];
-               if( h_row != -1 && h_col != -1 )
-               {
-                  h_idx_map_[current_nz] = i;
-                  h_iRow[current_nz] = h_row + 1;
-                  h_jCol[current_nz] = h_col + 1;
-                  current_nz++;
-               }
+               h_block_nz[k] = 0;
+            }
+            PartitionHessianStructureBlocks(h_nblocks, nz_full_h_, full_h_iRow, full_h_jCol, h_pos, NULL, h_iRow,
+                                            h_jCol, h_block_nz);
+            for( Index k = 0; k < h_nblocks; k++ )
+            {
+               Index count = h_block_nz[k];
+               h_block_nz[k] = current_nz;
+               current_nz += count;
             }
+            PartitionHessianStructureBlocks(h_nblocks, nz_full_h_, full_h_iRow, full_h_jCol, h_pos, h_idx_map, h_iRow,
+                                            h_jCol, h_block_nz);
+            delete[] h_block_nz;
+            // if no nonzero is dropped, then the TNLP can write into the Hessian directly
+            h_plan_.Initialize(current_nz < nz_full_h_ ? current_nz : 0, h_idx_map);
+            delete[] h_idx_map;
          }
          else
          {
-            h_idx_map_ = NULL;
+            h_plan_.Initialize(0, NULL);
             for( Index i = 0; i < nz_full_h_; i++ )
             {
                const Index& h_row = full_h_iRow[i] - 1;
@@ -1485,7 +1943,7 @@ bool TNLPAdapter::GetBoundsInformation(
    }
 
    // In case we are doing finite differences, keep a copy of the bounds
-   if( jacobian_approximation_ != JAC_EXACT )
+   if( jacobian_approximation_ != JAC_EXACT || (hessian_approximation_ == EXACT && hessian_evaluation_ == HESS_FINDIFF_VALUES) )
    {
       delete[] findiff_x_l_;
       delete[] findiff_x_u_;
@@ -1725,29 +2183,38 @@ bool TNLPAdapter::Eval_c(
 
    if( internal_eval_g(new_x) )
    {
-      DenseVector* dc = static_cast<DenseVector*>(&c);
-      DBG_ASSERT(dynamic_cast<DenseVector*>(&c));
-      Number* values = dc->Values();
-      const Index* c_pos = P_c_g_->ExpandedPosIndices();
-      Index n_c_no_fixed = P_c_g_->NCols();
-      for( Index i = 0; i < n_c_no_fixed; i++ )
-      {
-         values[i] = full_g_[c_pos[i]];
-         values[i] -= c_rhs_[i];
-      }
-      if( fixed_variable_treatment_ == MAKE_CONSTRAINT )
-      {
-         for( Index i = 0; i < n_x_fixed_; i++ )
-         {
-            values[n_c_no_fixed + i] = full_x_[x_fixed_map_[i]] - c_rhs_[n_c_no_fixed + i];
-         }
-      }
+      FullGToC(full_x_, full_g_, c);
       return true;
    }
 
    return false;
 }
 
+void TNLPAdapter::FullGToC(
+   const Number* full_x,
+   const Number* full_g,
+   Vector&       c
+) const
+{
+   DenseVector* dc = static_cast<DenseVector*>(&c);
+   DBG_ASSERT(dynamic_cast<DenseVector*>(&c));
+   Number* values = dc->Values();
+   const Index* c_pos = P_c_g_->ExpandedPosIndices();
+   Index n_c_no_fixed = P_c_g_->NCols();
+   for( Index i = 0; i < n_c_no_fixed; i++ )
+   {
+      values[i] = full_g[c_pos[i]];
+      values[i] -= c_rhs_[i];
+   }
+   if( fixed_variable_treatment_ == MAKE_CONSTRAINT )
+   {
+      for( Index i = 0; i < n_x_fixed_; i++ )
+      {
+         values[n_c_no_fixed + i] = full_x[x_fixed_map_[i]] - c_rhs_[n_c_no_fixed + i];
+      }
+   }
+}
+
 bool TNLPAdapter::Eval_jac_c(
    const Vector& x,
    Matrix&       jac_c
@@ -1765,11 +2232,8 @@ bool TNLPAdapter::Eval_jac_c(
       DBG_ASSERT(dynamic_cast<GenTMatrix*>(&jac_c));
       Number* values = gt_jac_c->Values();
 
-      for( Index i = 0; i < nz_jac_c_no_extra_; i++ )
-      {
-         // Assume the same structure as initially given
-         values[i] = jac_g_[jac_idx_map_[i]];
-      }
+      // Assume the same structure as initially given
+      jac_c_plan_.Gather(jac_g_, values);
       if( fixed_variable_treatment_ == MAKE_CONSTRAINT )
       {
          const Number one = 1.;
@@ -1791,24 +2255,32 @@ bool TNLPAdapter::Eval_d(
       new_x = true;
    }
 
-   DenseVector* dd = static_cast<DenseVector*>(&d);
-   DBG_ASSERT(dynamic_cast<DenseVector*>(&d));
-   Number* values = dd->Values();
    if( internal_eval_g(new_x) )
    {
-      const Index* d_pos = P_d_g_->ExpandedPosIndices();
-      for( Index i = 0; i < d.Dim(); i++ )
-      {
-         values[i] = full_g_[d_pos[i]];
-      }
+      FullGToD(full_g_, d);
       return true;
    }
 
    return false;
 }
 
-bool TNLPAdapter::Eval_jac_d(
-   const Vector& x,
+void TNLPAdapter::FullGToD(
+   const Number* full_g,
+   Vector&       d
+) const
+{
+   DenseVector* dd = static_cast<DenseVector*>(&d);
+   DBG_ASSERT(dynamic_cast<DenseVector*>(&d));
+   Number* values = dd->Values();
+   const Index* d_pos = P_d_g_->ExpandedPosIndices();
+   for( Index i = 0; i < d.Dim(); i++ )
+   {
+      values[i] = full_g[d_pos[i]];
+   }
+}
+
+bool TNLPAdapter::Eval_jac_d(
+   const Vector& x,
    Matrix&       jac_d
 )
 {
@@ -1824,11 +2296,8 @@ bool TNLPAdapter::Eval_jac_d(
       DBG_ASSERT(dynamic_cast<GenTMatrix*>(&jac_d));
       Number* values = gt_jac_d->Values();
 
-      for( Index i = 0; i < nz_jac_d_; i++ )
-      {
-         // Assume the same structure as initially given
-         values[i] = jac_g_[jac_idx_map_[nz_jac_c_no_extra_ + i]];
-      }
+      // Assume the same structure as initially given
+      jac_d_plan_.Gather(jac_g_, values);
       return true;
    }
    return false;
@@ -1842,6 +2311,15 @@ bool TNLPAdapter::Eval_h(
    SymMatrix&    h
 )
 {
+   if( hessian_evaluation_ == HESS_PRODUCTS )
+   {
+      // only remember the point; products are computed by Eval_h_times_vec
+      HessianVectorProductMatrix* hvp_h = static_cast<HessianVectorProductMatrix*>(&h);
+      DBG_ASSERT(dynamic_cast<HessianVectorProductMatrix*>(&h));
+      hvp_h->SetEvaluationPoint(this, x, obj_factor, yc, yd);
+      return true;
+   }
+
    // First see if all weights are set to zero (for example, when
    // computing the least square multiplier estimates, this is what
    // we do).  In that case, there is no need to compute values, just
@@ -1874,30 +2352,330 @@ bool TNLPAdapter::Eval_h(
    DBG_ASSERT(dynamic_cast<SymTMatrix*>(&h));
    Number* values = st_h->Values();
 
-   if( h_idx_map_ )
+   if( nz_h_ < nz_full_h_ )
    {
+      // some nonzeros are w.r.t. fixed variables
       Number* full_h = new Number[nz_full_h_];
 
-      if( tnlp_->eval_h(n_full_x_, full_x_, new_x, obj_factor, n_full_g_, full_lambda_, new_y, nz_full_h_, NULL, NULL,
-                        full_h) )
+      if( internal_eval_h(new_x, obj_factor, new_y, full_h) )
       {
-         for( Index i = 0; i < nz_h_; i++ )
-         {
-            values[i] = full_h[h_idx_map_[i]];
-         }
+         h_plan_.Gather(full_h, values);
          retval = true;
       }
       delete[] full_h;
    }
    else
    {
-      retval = tnlp_->eval_h(n_full_x_, full_x_, new_x, obj_factor, n_full_g_, full_lambda_, new_y, nz_full_h_, NULL,
-                             NULL, values);
+      retval = internal_eval_h(new_x, obj_factor, new_y, values);
+   }
+
+   return retval;
+}
+
+bool TNLPAdapter::Eval_h_times_vec(
+   const Vector& x,
+   Number        obj_factor,
+   const Vector& yc,
+   const Vector& yd,
+   const Vector& v,
+   Vector&       hv
+)
+{
+   bool new_x = false;
+   if( update_local_x(x) )
+   {
+      new_x = true;
+   }
+   bool new_y = false;
+   if( update_local_lambda(yc, yd) )
+   {
+      new_y = true;
+   }
+
+   DenseVector* dhv = static_cast<DenseVector*>(&hv);
+   DBG_ASSERT(dynamic_cast<DenseVector*>(&hv));
+   Number* values = dhv->Values();
+
+   // products with fixed variables are not needed, so these entries of v are set to zero
+   Number* full_v = new Number[n_full_x_];
+   ResortX(v, full_v, false);
+
+   bool retval;
+   if( IsValid(P_x_full_x_) )
+   {
+      Number* full_hv = new Number[n_full_x_];
+      retval = tnlp_->eval_h_times_vec(n_full_x_, full_x_, new_x, obj_factor, n_full_g_, full_lambda_, new_y, full_v,
+                                       full_hv);
+      if( retval )
+      {
+         const Index* x_pos = P_x_full_x_->ExpandedPosIndices();
+         for( Index i = 0; i < hv.Dim(); i++ )
+         {
+            values[i] = full_hv[x_pos[i]];
+         }
+      }
+      delete[] full_hv;
+   }
+   else
+   {
+      retval = tnlp_->eval_h_times_vec(n_full_x_, full_x_, new_x, obj_factor, n_full_g_, full_lambda_, new_y, full_v,
+                                       values);
    }
+   delete[] full_v;
 
    return retval;
 }
 
+/** evaluates objective and constraints of a TNLP at several points, one point per part
+ *
+ *  This is done in parallel by TNLPAdapter::Eval_f_c_d_AtPoints.
+ */
+class EvalFAndGAtPoints: public ParallelWork
+{
+public:
+   EvalFAndGAtPoints(
+      TNLP*         tnlp,
+      Index         n,
+      const Number* x,
+      Index         m,
+      Number*       g,
+      Number*       f,
+      bool*         success
+   )
+      : tnlp_(tnlp),
+        n_(n),
+        x_(x),
+        m_(m),
+        g_(g),
+        f_(f),
+        success_(success)
+   { }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      try
+      {
+         success_[k] = tnlp_->eval_f(n_, &x_[k * n_], true, f_[k]);
+         if( success_[k] && m_ > 0 )
+         {
+            success_[k] = tnlp_->eval_g(n_, &x_[k * n_], true, m_, &g_[k * m_]);
+         }
+      }
+      catch( ... )
+      {
+         // treat exceptions of the TNLP as evaluation error, as for a single point
+         success_[k] = false;
+      }
+   }
+
+private:
+   TNLP*         tnlp_;
+   Index         n_;
+   const Number* x_;
+   Index         m_;
+   Number*       g_;
+   Number*       f_;
+   bool*         success_;
+};
+
+bool TNLPAdapter::Eval_f_c_d_AtPoints(
+   Index                npoints,
+   const Vector* const* x,
+   Number*              f,
+   Vector* const*       c,
+   Vector* const*       d,
+   bool*                success
+)
+{
+#if __cplusplus >= 201103L
+   std::vector<Number> full_x(npoints * n_full_x_);
+   std::vector<Number> full_g(npoints * n_full_g_);
+   for( Index k = 0; k < npoints; k++ )
+   {
+      ResortX(*x[k], full_x.data() + k * n_full_x_);
+   }
+
+   EvalFAndGAtPoints eval(GetRawPtr(tnlp_), n_full_x_, full_x.data(), n_full_g_, full_g.data(), f, success);
+   DoParallelWork(npoints, eval);
+
+   for( Index k = 0; k < npoints; k++ )
+   {
+      if( success[k] )
+      {
+         FullGToC(full_x.data() + k * n_full_x_, full_g.data() + k * n_full_g_, *c[k]);
+         FullGToD(full_g.data() + k * n_full_g_, *d[k]);
+      }
+   }
+
+   // the TNLP has seen other points since the last evaluation through
+   // full_x_, so make sure that the next evaluation passes new_x=true
+   x_tag_for_iterates_ = 0;
+
+   return true;
+#else
+   (void) npoints;
+   (void) x;
+   (void) f;
+   (void) c;
+   (void) d;
+   (void) success;
+   return false;
+#endif
+}
+
+/** evaluates the objective gradient and constraint Jacobian of a TNLP at several points
+ *
+ *  Part k does the points k, k+nparts, k+2*nparts, ...
+ *  This is done in parallel by TNLPAdapter::Eval_grad_f_jac_c_d_AtPoints.
+ */
+class EvalGradFAndJacGAtPoints: public ParallelWork
+{
+public:
+   EvalGradFAndJacGAtPoints(
+      TNLP*         tnlp,
+      Index         nparts,
+      Index         npoints,
+      Index         n,
+      const Number* x,
+      Index         m,
+      Index         nnz_jac_g,
+      Number*       grad_f,
+      Number*       jac_g,
+      bool*         success
+   )
+      : tnlp_(tnlp),
+        nparts_(nparts),
+        npoints_(npoints),
+        n_(n),
+        x_(x),
+        m_(m),
+        nnz_jac_g_(nnz_jac_g),
+        grad_f_(grad_f),
+        jac_g_(jac_g),
+        success_(success)
+   { }
+
+   virtual void DoPart(
+      Index part
+   )
+   {
+      for( Index k = part; k < npoints_; k += nparts_ )
+      {
+         try
+         {
+            success_[k] = tnlp_->eval_grad_f(n_, &x_[k * n_], true, &grad_f_[k * n_]);
+            if( success_[k] && m_ > 0 )
+            {
+               success_[k] = tnlp_->eval_jac_g(n_, &x_[k * n_], true, m_, nnz_jac_g_, NULL, NULL,
+                                               &jac_g_[k * nnz_jac_g_]);
+            }
+         }
+         catch( ... )
+         {
+            // treat exceptions of the TNLP as evaluation error, as for a single point
+            success_[k] = false;
+         }
+      }
+   }
+
+private:
+   TNLP*         tnlp_;
+   Index         nparts_;
+   Index         npoints_;
+   Index         n_;
+   const Number* x_;
+   Index         m_;
+   Index         nnz_jac_g_;
+   Number*       grad_f_;
+   Number*       jac_g_;
+   bool*         success_;
+};
+
+bool TNLPAdapter::Eval_grad_f_jac_c_d_AtPoints(
+   Index                npoints,
+   const Vector* const* x,
+   Vector* const*       g_f,
+   Matrix* const*       jac_c,
+   Matrix* const*       jac_d,
+   bool*                success
+)
+{
+#if __cplusplus >= 201103L
+   const Index nthreads = Min(NumThreads(evaluation_num_threads_), npoints);
+   if( nthreads <= 1 || jacobian_approximation_ != JAC_EXACT )
+   {
+      return false;
+   }
+
+   std::vector<Number> full_x(npoints * n_full_x_);
+   std::vector<Number> full_grad_f(npoints * n_full_x_);
+   std::vector<Number> full_jac_g(npoints * nz_full_jac_g_);
+   for( Index k = 0; k < npoints; k++ )
+   {
+      ResortX(*x[k], full_x.data() + k * n_full_x_);
+   }
+
+   EvalGradFAndJacGAtPoints eval(GetRawPtr(tnlp_), nthreads, npoints, n_full_x_, full_x.data(), n_full_g_,
+                                 nz_full_jac_g_, full_grad_f.data(), full_jac_g.data(), success);
+   DoParallelWork(nthreads, eval);
+
+   for( Index k = 0; k < npoints; k++ )
+   {
+      if( !success[k] )
+      {
+         continue;
+      }
+
+      DenseVector* dg_f = static_cast<DenseVector*>(g_f[k]);
+      DBG_ASSERT(dynamic_cast<DenseVector*>(g_f[k]));
+      Number* values = dg_f->Values();
+      const Number* point_grad_f = full_grad_f.data() + k * n_full_x_;
+      if( IsValid(P_x_full_x_) )
+      {
+         const Index* x_pos = P_x_full_x_->ExpandedPosIndices();
+         for( Index i = 0; i < g_f[k]->Dim(); i++ )
+         {
+            values[i] = point_grad_f[x_pos[i]];
+         }
+      }
+      else
+      {
+         IpBlasCopy(n_full_x_, point_grad_f, 1, values, 1);
+      }
+
+      GenTMatrix* gt_jac_c = static_cast<GenTMatrix*>(jac_c[k]);
+      DBG_ASSERT(dynamic_cast<GenTMatrix*>(jac_c[k]));
+      values = gt_jac_c->Values();
+      jac_c_plan_.Gather(full_jac_g.data() + k * nz_full_jac_g_, values);
+      if( fixed_variable_treatment_ == MAKE_CONSTRAINT )
+      {
+         const Number one = 1.;
+         IpBlasCopy(n_x_fixed_, &one, 0, &values[nz_jac_c_no_extra_], 1);
+      }
+
+      GenTMatrix* gt_jac_d = static_cast<GenTMatrix*>(jac_d[k]);
+      DBG_ASSERT(dynamic_cast<GenTMatrix*>(jac_d[k]));
+      jac_d_plan_.Gather(full_jac_g.data() + k * nz_full_jac_g_, gt_jac_d->Values());
+   }
+
+   // the TNLP has seen other points since the last evaluation through
+   // full_x_, so make sure that the next evaluation passes new_x=true
+   x_tag_for_iterates_ = 0;
+
+   return true;
+#else
+   (void) npoints;
+   (void) x;
+   (void) g_f;
+   (void) jac_c;
+   (void) jac_d;
+   (void) success;
+   return false;
+#endif
+}
+
 void TNLPAdapter::GetScalingParameters(
    const SmartPtr<const VectorSpace> x_space,
    const SmartPtr<const VectorSpace> c_space,
@@ -2877,128 +3655,888 @@ void TNLPAdapter::initialize_findiff_jac(
 
 }
 
-bool TNLPAdapter::CheckDerivatives(
-   TNLPAdapter::DerivativeTestEnum deriv_test,
-   Index                           deriv_test_start_index
+bool TNLPAdapter::internal_eval_h(
+   bool    new_x,
+   Number  obj_factor,
+   bool    new_y,
+   Number* full_h
 )
 {
-   if( deriv_test == NO_TEST )
+   if( hessian_evaluation_ == HESS_EXACT )
    {
-      return true;
+      return tnlp_->eval_h(n_full_x_, full_x_, new_x, obj_factor, n_full_g_, full_lambda_, new_y, nz_full_h_, NULL, NULL,
+                           full_h);
    }
 
-   Index nerrors = 0;
-
-   ASSERT_EXCEPTION(IsValid(jnlst_), ERROR_IN_TNLP_DERIVATIVE_TEST,
-                    "No Journalist given to TNLPAdapter.  Need Journalist, otherwise can't produce any output in DerivativeChecker!");
-
-   bool retval = true;
-   // Since this method should be independent of all other internal
-   // data (so that it can be called indpenendent of GetSpace etc),
-   // we are not using any internal fields
-
-   // Obtain the problem size
-   Index nx; // number of variables
-   Index ng; // number of constriants
-   Index nz_jac_g; // number of nonzeros in constraint Jacobian
-   Index nz_hess_lag; // number of nonzeros in Lagrangian Hessian
-   TNLP::IndexStyleEnum index_style;
-   retval = tnlp_->get_nlp_info(nx, ng, nz_jac_g, nz_hess_lag, index_style);
-   ASSERT_EXCEPTION(retval, INVALID_TNLP, "get_nlp_info returned false for derivative checker");
+   return internal_findiff_h(new_x, obj_factor, full_h);
+}
 
-   // Obtain starting point as reference point at which derivative
-   // test should be performed
-   Number* xref = new Number[nx];
-   tnlp_->get_starting_point(nx, true, xref, false, NULL, NULL, ng, false, NULL);
+void TNLPAdapter::initialize_findiff_hess(
+   const Index* iRow,
+   const Index* jCol
+)
+{
+   DBG_START_METH("TNLPAdapter::initialize_findiff_hess", dbg_verbosity);
 
-   // Perform a random perturbation.  We need the bounds to make sure
-   // they are not violated
-   Number* x_l = new Number[nx];
-   Number* x_u = new Number[nx];
-   Number* g_l = new Number[ng];
-   Number* g_u = new Number[ng];
-   retval = tnlp_->get_bounds_info(nx, x_l, x_u, ng, g_l, g_u);
-   ASSERT_EXCEPTION(retval, INVALID_TNLP, "get_bounds_info returned false in derivative checker");
-   IpResetRandom01();
-   for( Index i = 0; i < nx; i++ )
+   // setup the column-wise structure of the full symmetric matrix
+   std::vector<Index> col_start(n_full_x_ + 1, 0);
+   for( Index i = 0; i < nz_full_h_; i++ )
    {
-      const Number lower = Max(x_l[i], xref[i] - point_perturbation_radius_);
-      const Number upper = Min(x_u[i], xref[i] + point_perturbation_radius_);
-      const Number interval = upper - lower;
-      const Number random_number = IpRandom01();
-      xref[i] = lower + random_number * interval;
+      const Index row = iRow[i] - 1;
+      const Index col = jCol[i] - 1;
+      col_start[col + 1]++;
+      if( row != col )
+      {
+         col_start[row + 1]++;
+      }
    }
-   delete[] x_l;
-   delete[] x_u;
-   delete[] g_l;
-   delete[] g_u;
-
-   // Obtain value of objective and constraints at reference point
-   bool new_x = true;
-   Number fref;
-   Number* gref = NULL;
-   if( ng > 0 )
+   for( Index j = 0; j < n_full_x_; j++ )
    {
-      gref = new Number[ng];
+      col_start[j + 1] += col_start[j];
    }
-   retval = tnlp_->eval_f(nx, xref, new_x, fref);
-   ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                    "In TNLP derivative test: f could not be evaluated at reference point.");
-   new_x = false;
-   if( ng > 0 )
+   std::vector<Index> col_rows(col_start[n_full_x_]);
+   std::vector<Index> col_pos(col_start.begin(), col_start.end() - 1);
+   for( Index i = 0; i < nz_full_h_; i++ )
    {
-      retval = tnlp_->eval_g(nx, xref, new_x, ng, gref);
-      ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                       "In TNLP derivative test: g could not be evaluated at reference point.");
+      const Index row = iRow[i] - 1;
+      const Index col = jCol[i] - 1;
+      col_rows[col_pos[col]++] = row;
+      if( row != col )
+      {
+         col_rows[col_pos[row]++] = col;
+      }
+   }
+   for( Index j = 0; j < n_full_x_; j++ )
+   {
+      std::sort(col_rows.begin() + col_start[j], col_rows.begin() + col_start[j + 1]);
+      if( std::adjacent_find(col_rows.begin() + col_start[j], col_rows.begin() + col_start[j + 1]) != col_rows.begin() + col_start[j + 1] )
+      {
+         THROW_EXCEPTION(INVALID_TNLP,
+                         "Sparsity structure of Hessian has multiple occurrences of the same position.  This is not allowed for finite differences.");
+      }
    }
 
-   // Obtain gradient of objective function at reference point
-   Number* grad_f = new Number[nx];
-   retval = tnlp_->eval_grad_f(nx, xref, true, grad_f);
-   ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                    "In TNLP derivative test: grad_f could not be evaluated at reference point.");
-
-   Index* g_iRow = NULL;
-   Index* g_jCol = NULL;
-   Number* jac_g = NULL;
-   if( ng > 0 )
+   // Greedy coloring of the column intersection graph: two columns get
+   // the same color only if they do not have a nonzero in the same row.
+   // Since the matrix is symmetric, the columns with a nonzero in row i
+   // are the rows of column i.
+   std::vector<Index> color(n_full_x_, -1);
+   std::vector<Index> forbidden(n_full_x_, -1);
+   findiff_hess_ncolors_ = 0;
+   for( Index j = 0; j < n_full_x_; j++ )
    {
-      // Obtain constraint Jacobian at reference point (including structure)
-      g_iRow = new Index[nz_jac_g];
-      g_jCol = new Index[nz_jac_g];
-      retval = tnlp_->eval_jac_g(nx, NULL, false, ng, nz_jac_g, g_iRow, g_jCol, NULL);
-      ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                       "In TNLP derivative test: Jacobian structure could not be evaluated.");
-      // Correct counting if required to C-style
-      if( index_style == TNLP::FORTRAN_STYLE )
+      if( col_start[j] == col_start[j + 1] )
       {
-         for( Index i = 0; i < nz_jac_g; i++ )
-         {
-            DBG_ASSERT(g_iRow[i] > 0);
-            DBG_ASSERT(g_iRow[i] <= ng);
-            DBG_ASSERT(g_jCol[i] > 0);
-            DBG_ASSERT(g_jCol[i] <= nx);
-            g_iRow[i] -= 1;
-            g_jCol[i] -= 1;
-         }
+         // column without nonzeros does not need to be perturbed
+         continue;
       }
-#if IPOPT_CHECKLEVEL > 0
-      else
+      for( Index p = col_start[j]; p < col_start[j + 1]; p++ )
       {
-         for( Index i = 0; i < nz_jac_g; i++ )
+         const Index row = col_rows[p];
+         for( Index q = col_start[row]; q < col_start[row + 1]; q++ )
          {
-            DBG_ASSERT(g_iRow[i] >= 0);
-            DBG_ASSERT(g_iRow[i] < ng);
-            DBG_ASSERT(g_jCol[i] >= 0);
-            DBG_ASSERT(g_jCol[i] < nx);
+            const Index other = col_rows[q];
+            if( color[other] >= 0 )
+            {
+               forbidden[color[other]] = j;
+            }
          }
       }
-#endif
-      // Obtain values at reference point
-      jac_g = new Number[nz_jac_g];
-      retval = tnlp_->eval_jac_g(nx, xref, new_x, ng, nz_jac_g, NULL, NULL, jac_g);
-      ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                       "In TNLP derivative test: Jacobian values could not be evaluated at reference point.");
+      Index c = 0;
+      while( c < findiff_hess_ncolors_ && forbidden[c] == j )
+      {
+         c++;
+      }
+      color[j] = c;
+      if( c == findiff_hess_ncolors_ )
+      {
+         findiff_hess_ncolors_++;
+      }
+   }
+
+   delete[] findiff_hess_iRow_;
+   delete[] findiff_hess_jCol_;
+   delete[] findiff_hess_color_vars_start_;
+   delete[] findiff_hess_color_vars_;
+   delete[] findiff_hess_color_nz_start_;
+   delete[] findiff_hess_color_nz_;
+   delete[] findiff_hess_pert_;
+   delete[] findiff_hess_grad_lag_ref_;
+   delete[] findiff_hess_grad_lag_pert_;
+   delete[] findiff_hess_jac_values_;
+   delete[] findiff_hess_x_pert_;
+
+   findiff_hess_iRow_ = new Index[nz_full_h_];
+   findiff_hess_jCol_ = new Index[nz_full_h_];
+   for( Index i = 0; i < nz_full_h_; i++ )
+   {
+      findiff_hess_iRow_[i] = iRow[i] - 1;
+      findiff_hess_jCol_[i] = jCol[i] - 1;
+   }
+
+   // sort variables by color
+   findiff_hess_color_vars_start_ = new Index[findiff_hess_ncolors_ + 1];
+   const Number zero = 0.;
+   for( Index c = 0; c <= findiff_hess_ncolors_; c++ )
+   {
+      findiff_hess_color_vars_start_[c] = 0;
+   }
+   for( Index j = 0; j < n_full_x_; j++ )
+   {
+      if( color[j] >= 0 )
+      {
+         findiff_hess_color_vars_start_[color[j] + 1]++;
+      }
+   }
+   for( Index c = 0; c < findiff_hess_ncolors_; c++ )
+   {
+      findiff_hess_color_vars_start_[c + 1] += findiff_hess_color_vars_start_[c];
+   }
+   findiff_hess_color_vars_ = new Index[findiff_hess_color_vars_start_[findiff_hess_ncolors_]];
+   std::vector<Index> pos(findiff_hess_color_vars_start_, findiff_hess_color_vars_start_ + findiff_hess_ncolors_);
+   for( Index j = 0; j < n_full_x_; j++ )
+   {
+      if( color[j] >= 0 )
+      {
+         findiff_hess_color_vars_[pos[color[j]]++] = j;
+      }
+   }
+
+   // sort nonzeros by color of their column
+   findiff_hess_color_nz_start_ = new Index[findiff_hess_ncolors_ + 1];
+   for( Index c = 0; c <= findiff_hess_ncolors_; c++ )
+   {
+      findiff_hess_color_nz_start_[c] = 0;
+   }
+   for( Index i = 0; i < nz_full_h_; i++ )
+   {
+      findiff_hess_color_nz_start_[color[findiff_hess_jCol_[i]] + 1]++;
+   }
+   for( Index c = 0; c < findiff_hess_ncolors_; c++ )
+   {
+      findiff_hess_color_nz_start_[c + 1] += findiff_hess_color_nz_start_[c];
+   }
+   findiff_hess_color_nz_ = new Index[nz_full_h_];
+   pos.assign(findiff_hess_color_nz_start_, findiff_hess_color_nz_start_ + findiff_hess_ncolors_);
+   for( Index i = 0; i < nz_full_h_; i++ )
+   {
+      findiff_hess_color_nz_[pos[color[findiff_hess_jCol_[i]]]++] = i;
+   }
+
+   findiff_hess_pert_ = new Number[n_full_x_];
+   IpBlasCopy(n_full_x_, &zero, 0, findiff_hess_pert_, 1);
+
+   // work arrays, for each thread a perturbed point and the gradient there
+   findiff_hess_nthreads_ = Max(Index(1), Min(NumThreads(evaluation_num_threads_), findiff_hess_ncolors_));
+   findiff_hess_grad_lag_ref_ = new Number[n_full_x_];
+   findiff_hess_grad_lag_pert_ = new Number[findiff_hess_nthreads_ * n_full_x_];
+   findiff_hess_jac_values_ = new Number[findiff_hess_nthreads_ * nz_full_jac_g_];
+   findiff_hess_x_pert_ = new Number[findiff_hess_nthreads_ * n_full_x_];
+
+   if( IsValid(jnlst_) )
+   {
+      jnlst_->Printf(J_DETAILED, J_INITIALIZATION,
+                     "Finite difference Hessian approximation requires %" IPOPT_INDEX_FORMAT " gradient evaluations per Hessian (%" IPOPT_INDEX_FORMAT " threads).\n",
+                     findiff_hess_ncolors_, findiff_hess_nthreads_);
+   }
+}
+
+bool TNLPAdapter::internal_findiff_grad_lag(
+   const Number* x,
+   bool          new_x,
+   Number        obj_factor,
+   Number*       jac_values,
+   Number*       grad_lag
+)
+{
+   if( obj_factor != 0. )
+   {
+      if( !tnlp_->eval_grad_f(n_full_x_, x, new_x, grad_lag) )
+      {
+         return false;
+      }
+      // if other threads evaluate at other points meanwhile, the TNLP cannot reuse values computed for the gradient
+      new_x = findiff_hess_nthreads_ > 1;
+      IpBlasScal(n_full_x_, obj_factor, grad_lag, 1);
+   }
+   else
+   {
+      const Number zero = 0.;
+      IpBlasCopy(n_full_x_, &zero, 0, grad_lag, 1);
+   }
+
+   if( n_full_g_ > 0 )
+   {
+      if( !tnlp_->eval_jac_g(n_full_x_, x, new_x, n_full_g_, nz_full_jac_g_, NULL, NULL, jac_values) )
+      {
+         return false;
+      }
+      for( Index i = 0; i < nz_full_jac_g_; i++ )
+      {
+         grad_lag[findiff_hess_jac_jCol_[i]] += full_lambda_[findiff_hess_jac_iRow_[i]] * jac_values[i];
+      }
+   }
+
+   return true;
+}
+
+/** computes the nonzeros of the finite difference Hessian for the colors c with c mod nparts == part */
+class FindiffHessColorsWork: public ParallelWork
+{
+public:
+   FindiffHessColorsWork(
+      TNLPAdapter* adapter,
+      Index        nparts,
+      Number       obj_factor,
+      Number*      full_h
+   )
+      : adapter_(adapter),
+        nparts_(nparts),
+        obj_factor_(obj_factor),
+        full_h_(full_h),
+        success_(nparts, 1)
+   { }
+
+   /** Whether the gradients could be evaluated for all colors */
+   bool Success() const
+   {
+      return std::find(success_.begin(), success_.end(), 0) == success_.end();
+   }
+
+   virtual void DoPart(
+      Index part
+   )
+   {
+      for( Index c = part; success_[part] && c < adapter_->findiff_hess_ncolors_; c += nparts_ )
+      {
+         success_[part] = adapter_->internal_findiff_h_color(c, obj_factor_, part, full_h_);
+      }
+   }
+
+private:
+   TNLPAdapter* adapter_;
+   Index        nparts_;
+   Number       obj_factor_;
+   Number*      full_h_;
+   /** for each part, whether its gradient evaluations succeeded (char instead of bool, since the parts write concurrently) */
+   std::vector<char> success_;
+};
+
+bool TNLPAdapter::internal_findiff_h(
+   bool    new_x,
+   Number  obj_factor,
+   Number* full_h
+)
+{
+   DBG_START_METH("TNLPAdapter::internal_findiff_h", dbg_verbosity);
+
+   for( Index part = 0; part < findiff_hess_nthreads_; part++ )
+   {
+      IpBlasCopy(n_full_x_, full_x_, 1, findiff_hess_x_pert_ + part * n_full_x_, 1);
+   }
+
+   bool retval = internal_findiff_grad_lag(full_x_, new_x, obj_factor, findiff_hess_jac_values_, findiff_hess_grad_lag_ref_);
+
+   if( retval )
+   {
+      // The colors are distributed onto the threads; each needs its own perturbed point.
+      FindiffHessColorsWork work(this, findiff_hess_nthreads_, obj_factor, full_h);
+      DoParallelWork(findiff_hess_nthreads_, work);
+      retval = work.Success();
+   }
+
+   // The TNLP has last seen a perturbed point, so make sure that the next
+   // evaluation at the current iterate is flagged as a new point.
+   x_tag_for_iterates_ = 0;
+
+   return retval;
+}
+
+bool TNLPAdapter::internal_findiff_h_color(
+   Index   c,
+   Number  obj_factor,
+   Index   part,
+   Number* full_h
+)
+{
+   Number* full_x_pert = findiff_hess_x_pert_ + part * n_full_x_;
+   Number* grad_lag_pert = findiff_hess_grad_lag_pert_ + part * n_full_x_;
+   const Number* grad_lag_ref = findiff_hess_grad_lag_ref_;
+   bool retval = true;
+
+   // Each color is a set of variables whose Hessian columns do not share
+   // a row, so all of them can be perturbed at the same time and each
+   // entry of the gradient difference belongs to exactly one of them.
+   // Since every variable has only one color, the parts do not write the
+   // same entries of findiff_hess_pert_ and full_h.
+   bool perturbed = false;
+   for( Index k = findiff_hess_color_vars_start_[c]; k < findiff_hess_color_vars_start_[c + 1]; k++ )
+   {
+      const Index ivar = findiff_hess_color_vars_[k];
+      if( findiff_x_l_[ivar] < findiff_x_u_[ivar] )
+      {
+         Number this_perturbation = findiff_perturbation_ * Max(Number(1.), std::abs(full_x_[ivar]));
+         full_x_pert[ivar] = full_x_[ivar] + this_perturbation;
+         if( full_x_pert[ivar] > findiff_x_u_[ivar] )
+         {
+            // if at upper bound, then change direction towards lower bound
+            this_perturbation = -this_perturbation;
+            full_x_pert[ivar] = full_x_[ivar] + this_perturbation;
+         }
+         findiff_hess_pert_[ivar] = this_perturbation;
+         perturbed = true;
+      }
+      else
+      {
+         findiff_hess_pert_[ivar] = 0.;
+      }
+   }
+
+   if( perturbed )
+   {
+      retval = internal_findiff_grad_lag(full_x_pert, true, obj_factor, findiff_hess_jac_values_ + part * nz_full_jac_g_,
+                                         grad_lag_pert);
+   }
+
+   for( Index k = findiff_hess_color_nz_start_[c]; k < findiff_hess_color_nz_start_[c + 1]; k++ )
+   {
+      const Index inz = findiff_hess_color_nz_[k];
+      const Number& this_perturbation = findiff_hess_pert_[findiff_hess_jCol_[inz]];
+      if( retval && this_perturbation != 0. )
+      {
+         const Index& irow = findiff_hess_iRow_[inz];
+         full_h[inz] = (grad_lag_pert[irow] - grad_lag_ref[irow]) / this_perturbation;
+      }
+      else
+      {
+         full_h[inz] = 0.;
+      }
+   }
+
+   for( Index k = findiff_hess_color_vars_start_[c]; k < findiff_hess_color_vars_start_[c + 1]; k++ )
+   {
+      const Index ivar = findiff_hess_color_vars_[k];
+      full_x_pert[ivar] = full_x_[ivar];
+   }
+
+   return retval;
+}
+
+/** Keeps track of the largest deviation found by the derivative checker for each function. */
+class DerivativeTestReport
+{
+public:
+   /** kinds of checked derivatives */
+   enum Kind
+   {
+      GRAD_F = 0,
+      JAC_G,
+      DIR_F,
+      DIR_G,
+      OBJ_HESS,
+      CONSTR_HESS
+   };
+
+   /** Constructor.
+    *
+    * @param enabled  whether entries are recorded at all, i.e., whether a report is written
+    */
+   DerivativeTestReport(
+      bool enabled
+   )
+      : enabled_(enabled)
+   { }
+
+   /** Record a checked derivative entry. */
+   void Record(
+      Kind   kind,
+      Index  func,
+      Index  idx1,
+      Index  idx2,
+      Number exact,
+      Number approx,
+      Number rel_error
+   )
+   {
+      if( !enabled_ )
+      {
+         return;
+      }
+      std::pair<std::map<Key, Entry>::iterator, bool> ins = worst_.insert(std::make_pair(Key(kind, func), Entry()));
+      Entry& entry = ins.first->second;
+      if( ins.second || entry.rel_error < rel_error )
+      {
+         entry.idx1 = idx1;
+         entry.idx2 = idx2;
+         entry.exact = exact;
+         entry.approx = approx;
+         entry.rel_error = rel_error;
+      }
+   }
+
+   /** Write worst entry for each function whose relative error is at least tol, sorted by decreasing error.
+    *
+    * @return false if the file could not be opened
+    */
+   bool Write(
+      const std::string& filename,
+      Number             tol,
+      Index              index_correction
+   ) const
+   {
+      static const char* kind_names[] = { "grad_f", "jac_g", "dir_f", "dir_g", "obj_hess", "constr_hess" };
+
+      FILE* fp = fopen(filename.c_str(), "w");
+      if( fp == NULL )
+      {
+         return false;
+      }
+
+      std::vector<std::pair<Number, std::map<Key, Entry>::const_iterator> > sorted;
+      for( std::map<Key, Entry>::const_iterator it = worst_.begin(); it != worst_.end(); ++it )
+      {
+         if( it->second.rel_error >= tol )
+         {
+            sorted.push_back(std::make_pair(-it->second.rel_error, it));
+         }
+      }
+      std::sort(sorted.begin(), sorted.end(), CompareFirst);
+
+      fprintf(fp, "# kind function index1 index2 exact approx rel_error\n");
+      for( size_t i = 0; i < sorted.size(); i++ )
+      {
+         const Key& key = sorted[i].second->first;
+         const Entry& entry = sorted[i].second->second;
+         fprintf(fp, "%s %" IPOPT_INDEX_FORMAT " %" IPOPT_INDEX_FORMAT " %" IPOPT_INDEX_FORMAT " %23.16e %23.16e %10.3e\n",
+                 kind_names[key.first], key.second < 0 ? key.second : key.second + index_correction,
+                 entry.idx1 < 0 ? entry.idx1 : entry.idx1 + index_correction,
+                 entry.idx2 < 0 ? entry.idx2 : entry.idx2 + index_correction,
+                 entry.exact, entry.approx, entry.rel_error);
+      }
+
+      fclose(fp);
+      return true;
+   }
+
+private:
+   /** kind of test and function (-1 for objective) */
+   typedef std::pair<Kind, Index> Key;
+
+   struct Entry
+   {
+      Index idx1;
+      Index idx2;
+      Number exact;
+      Number approx;
+      Number rel_error;
+   };
+
+   static bool CompareFirst(
+      const std::pair<Number, std::map<Key, Entry>::const_iterator>& a,
+      const std::pair<Number, std::map<Key, Entry>::const_iterator>& b
+   )
+   {
+      return a.first < b.first;
+   }
+
+   /** whether entries are recorded */
+   bool enabled_;
+
+   /** worst entry for each kind of test and function */
+   std::map<Key, Entry> worst_;
+};
+
+/** evaluates f and g at perturbed points for the derivative checker
+ *
+ *  Part k works on the group of variables vars[group_start[k]], ...,
+ *  vars[group_start[k+1]-1] in its own copy of the reference point,
+ *  given by x + k*n.  It evaluates f with each variable of the group
+ *  perturbed alone and writes the values into f[group_start[k]], ...,
+ *  and g with all variables of the group perturbed at once and writes
+ *  the values into g + k*m.
+ */
+class DerivativeTestFirstOrderWork: public ParallelWork
+{
+public:
+   DerivativeTestFirstOrderWork(
+      TNLP*         tnlp,
+      Index         n,
+      const Number* xref,
+      Number        perturbation,
+      Index         m,
+      bool          concurrent,
+      Number*       x,
+      Number*       f,
+      Number*       g,
+      bool*         success_f,
+      bool*         success_g
+   )
+      : tnlp_(tnlp),
+        n_(n),
+        xref_(xref),
+        perturbation_(perturbation),
+        m_(m),
+        concurrent_(concurrent),
+        x_(x),
+        f_(f),
+        g_(g),
+        success_f_(success_f),
+        success_g_(success_g),
+        vars_(NULL),
+        group_start_(NULL)
+   { }
+
+   /** Set the variables and the start of the groups of variables that are perturbed by the parts. */
+   void SetGroups(
+      const Index* vars,
+      const Index* group_start
+   )
+   {
+      vars_ = vars;
+      group_start_ = group_start;
+   }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      const Index first = group_start_[k];
+      const Index last = group_start_[k + 1];
+      Number* x = x_ + k * n_;
+      success_f_[k] = true;
+      for( Index p = first; p < last && success_f_[k]; p++ )
+      {
+         const Index ivar = vars_[p];
+         x[ivar] = xref_[ivar] + perturbation_ * Max(Number(1.), std::abs(xref_[ivar]));
+         success_f_[k] = tnlp_->eval_f(n_, x, true, f_[p]);
+         x[ivar] = xref_[ivar];
+      }
+      if( m_ == 0 )
+      {
+         success_g_[k] = true;
+         return;
+      }
+      for( Index p = first; p < last; p++ )
+      {
+         const Index ivar = vars_[p];
+         x[ivar] = xref_[ivar] + perturbation_ * Max(Number(1.), std::abs(xref_[ivar]));
+      }
+      // other threads evaluate at other points meanwhile, so the TNLP cannot reuse values computed for f
+      success_g_[k] = tnlp_->eval_g(n_, x, concurrent_ || last - first > 1, m_, g_ + k * m_);
+      for( Index p = first; p < last; p++ )
+      {
+         const Index ivar = vars_[p];
+         x[ivar] = xref_[ivar];
+      }
+   }
+
+private:
+   TNLP*         tnlp_;
+   Index         n_;
+   const Number* xref_;
+   Number        perturbation_;
+   Index         m_;
+   bool          concurrent_;
+   Number*       x_;
+   Number*       f_;
+   Number*       g_;
+   bool*         success_f_;
+   bool*         success_g_;
+   const Index*  vars_;
+   const Index*  group_start_;
+};
+
+/** evaluates the gradient of the objective or of one constraint with one variable perturbed per part for the derivative checker
+ *
+ *  Part k perturbs variable vars[k] in its own copy of the reference
+ *  point, given by x + k*n, and writes the gradient into grad + k*n.
+ *  For a constraint, the Jacobian is evaluated into jac + k*nnz_jac and
+ *  the row of the constraint is scattered into the gradient.
+ */
+class DerivativeTestSecondOrderWork: public ParallelWork
+{
+public:
+   DerivativeTestSecondOrderWork(
+      TNLP*         tnlp,
+      Index         n,
+      const Number* xref,
+      Number        perturbation,
+      Index         m,
+      Index         nnz_jac,
+      const Index*  jac_jcol,
+      const Index*  jac_row_start,
+      const Index*  jac_row_nz,
+      Number*       x,
+      Number*       grad,
+      Number*       jac,
+      bool*         success
+   )
+      : tnlp_(tnlp),
+        n_(n),
+        xref_(xref),
+        perturbation_(perturbation),
+        m_(m),
+        nnz_jac_(nnz_jac),
+        jac_jcol_(jac_jcol),
+        jac_row_start_(jac_row_start),
+        jac_row_nz_(jac_row_nz),
+        x_(x),
+        grad_(grad),
+        jac_(jac),
+        success_(success),
+        icon_(-1),
+        vars_(NULL)
+   { }
+
+   /** Set the function (-1 for the objective) and the variables that are perturbed by the parts. */
+   void SetFunctionAndVariables(
+      Index        icon,
+      const Index* vars
+   )
+   {
+      icon_ = icon;
+      vars_ = vars;
+   }
+
+   virtual void DoPart(
+      Index k
+   )
+   {
+      const Index ivar = vars_[k];
+      Number* x = x_ + k * n_;
+      Number* grad = grad_ + k * n_;
+      x[ivar] = xref_[ivar] + perturbation_ * Max(Number(1.), std::abs(xref_[ivar]));
+      if( icon_ == -1 )
+      {
+         success_[k] = tnlp_->eval_grad_f(n_, x, true, grad);
+      }
+      else
+      {
+         Number* jac = jac_ + k * nnz_jac_;
+         success_[k] = tnlp_->eval_jac_g(n_, x, true, m_, nnz_jac_, NULL, NULL, jac);
+         // filter the gradient of the icon-th constraint
+         const Number zero = 0.;
+         IpBlasCopy(n_, &zero, 0, grad, 1);
+         for( Index i = jac_row_start_[icon_]; i < jac_row_start_[icon_ + 1]; i++ )
+         {
+            const Index& inz = jac_row_nz_[i];
+            grad[jac_jcol_[inz]] += jac[inz];
+         }
+      }
+      x[ivar] = xref_[ivar];
+   }
+
+private:
+   TNLP*         tnlp_;
+   Index         n_;
+   const Number* xref_;
+   Number        perturbation_;
+   Index         m_;
+   Index         nnz_jac_;
+   const Index*  jac_jcol_;
+   const Index*  jac_row_start_;
+   const Index*  jac_row_nz_;
+   Number*       x_;
+   Number*       grad_;
+   Number*       jac_;
+   bool*         success_;
+   Index         icon_;
+   const Index*  vars_;
+};
+
+/** Fills indices with all numbers in [first,n), or a random subset of these of size sample_size, if positive. */
+static void SampleDerivativeTestIndices(
+   Index               first,
+   Index               n,
+   Index               sample_size,
+   std::vector<Index>& indices
+)
+{
+   indices.clear();
+   for( Index i = first; i < n; i++ )
+   {
+      indices.push_back(i);
+   }
+   if( sample_size <= 0 || sample_size >= (Index) indices.size() )
+   {
+      return;
+   }
+   // partial Fisher-Yates shuffle
+   for( Index i = 0; i < sample_size; i++ )
+   {
+      Index j = i + (Index) (IpRandom01() * (Number) (indices.size() - i));
+      if( j >= (Index) indices.size() )
+      {
+         j = (Index) indices.size() - 1;
+      }
+      std::swap(indices[i], indices[j]);
+   }
+   indices.resize(sample_size);
+   std::sort(indices.begin(), indices.end());
+}
+
+bool TNLPAdapter::CheckDerivatives(
+   TNLPAdapter::DerivativeTestEnum deriv_test,
+   Index                           deriv_test_start_index
+)
+{
+   if( deriv_test == NO_TEST )
+   {
+      return true;
+   }
+
+   Index nerrors = 0;
+
+   ASSERT_EXCEPTION(IsValid(jnlst_), ERROR_IN_TNLP_DERIVATIVE_TEST,
+                    "No Journalist given to TNLPAdapter.  Need Journalist, otherwise can't produce any output in DerivativeChecker!");
+
+   bool retval = true;
+   // Since this method should be independent of all other internal
+   // data (so that it can be called indpenendent of GetSpace etc),
+   // we are not using any internal fields
+
+   // Obtain the problem size
+   Index nx; // number of variables
+   Index ng; // number of constriants
+   Index nz_jac_g; // number of nonzeros in constraint Jacobian
+   Index nz_hess_lag; // number of nonzeros in Lagrangian Hessian
+   TNLP::IndexStyleEnum index_style;
+   retval = tnlp_->get_nlp_info(nx, ng, nz_jac_g, nz_hess_lag, index_style);
+   ASSERT_EXCEPTION(retval, INVALID_TNLP, "get_nlp_info returned false for derivative checker");
+
+   // Obtain starting point as reference point at which derivative
+   // test should be performed
+   Number* xref = new Number[nx];
+   tnlp_->get_starting_point(nx, true, xref, false, NULL, NULL, ng, false, NULL);
+
+   // Perform a random perturbation.  We need the bounds to make sure
+   // they are not violated
+   Number* x_l = new Number[nx];
+   Number* x_u = new Number[nx];
+   Number* g_l = new Number[ng];
+   Number* g_u = new Number[ng];
+   retval = tnlp_->get_bounds_info(nx, x_l, x_u, ng, g_l, g_u);
+   ASSERT_EXCEPTION(retval, INVALID_TNLP, "get_bounds_info returned false in derivative checker");
+   IpResetRandom01();
+   for( Index i = 0; i < nx; i++ )
+   {
+      const Number lower = Max(x_l[i], xref[i] - point_perturbation_radius_);
+      const Number upper = Min(x_u[i], xref[i] + point_perturbation_radius_);
+      const Number interval = upper - lower;
+      const Number random_number = IpRandom01();
+      xref[i] = lower + random_number * interval;
+   }
+   delete[] x_l;
+   delete[] x_u;
+   delete[] g_l;
+   delete[] g_u;
+
+   // Obtain value of objective and constraints at reference point
+   bool new_x = true;
+   Number fref;
+   Number* gref = NULL;
+   if( ng > 0 )
+   {
+      gref = new Number[ng];
+   }
+   retval = tnlp_->eval_f(nx, xref, new_x, fref);
+   ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                    "In TNLP derivative test: f could not be evaluated at reference point.");
+   new_x = false;
+   if( ng > 0 )
+   {
+      retval = tnlp_->eval_g(nx, xref, new_x, ng, gref);
+      ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                       "In TNLP derivative test: g could not be evaluated at reference point.");
+   }
+
+   // Obtain gradient of objective function at reference point
+   Number* grad_f = new Number[nx];
+   retval = tnlp_->eval_grad_f(nx, xref, true, grad_f);
+   ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                    "In TNLP derivative test: grad_f could not be evaluated at reference point.");
+
+   Index* g_iRow = NULL;
+   Index* g_jCol = NULL;
+   Number* jac_g = NULL;
+   // positions of Jacobian nonzeros, ordered by column and by row
+   Index* jac_col_start = NULL;
+   Index* jac_col_nz = NULL;
+   Index* jac_row_start = NULL;
+   Index* jac_row_nz = NULL;
+   if( ng > 0 )
+   {
+      // Obtain constraint Jacobian at reference point (including structure)
+      g_iRow = new Index[nz_jac_g];
+      g_jCol = new Index[nz_jac_g];
+      retval = tnlp_->eval_jac_g(nx, NULL, false, ng, nz_jac_g, g_iRow, g_jCol, NULL);
+      ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                       "In TNLP derivative test: Jacobian structure could not be evaluated.");
+      // Correct counting if required to C-style
+      if( index_style == TNLP::FORTRAN_STYLE )
+      {
+         for( Index i = 0; i < nz_jac_g; i++ )
+         {
+            DBG_ASSERT(g_iRow[i] > 0);
+            DBG_ASSERT(g_iRow[i] <= ng);
+            DBG_ASSERT(g_jCol[i] > 0);
+            DBG_ASSERT(g_jCol[i] <= nx);
+            g_iRow[i] -= 1;
+            g_jCol[i] -= 1;
+         }
+      }
+#if IPOPT_CHECKLEVEL > 0
+      else
+      {
+         for( Index i = 0; i < nz_jac_g; i++ )
+         {
+            DBG_ASSERT(g_iRow[i] >= 0);
+            DBG_ASSERT(g_iRow[i] < ng);
+            DBG_ASSERT(g_jCol[i] >= 0);
+            DBG_ASSERT(g_jCol[i] < nx);
+         }
+      }
+#endif
+      // Obtain values at reference point
+      jac_g = new Number[nz_jac_g];
+      retval = tnlp_->eval_jac_g(nx, xref, new_x, ng, nz_jac_g, NULL, NULL, jac_g);
+      ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                       "In TNLP derivative test: Jacobian values could not be evaluated at reference point.");
+
+      // Setup column- and row-wise access to the Jacobian, so that the
+      // checks do not need to search through all nonzeros
+      jac_col_start = new Index[nx + 1];
+      jac_col_nz = new Index[nz_jac_g];
+      jac_row_start = new Index[ng + 1];
+      jac_row_nz = new Index[nz_jac_g];
+      for( Index i = 0; i <= nx; i++ )
+      {
+         jac_col_start[i] = 0;
+      }
+      for( Index i = 0; i <= ng; i++ )
+      {
+         jac_row_start[i] = 0;
+      }
+      for( Index i = 0; i < nz_jac_g; i++ )
+      {
+         jac_col_start[g_jCol[i] + 1]++;
+         jac_row_start[g_iRow[i] + 1]++;
+      }
+      for( Index i = 0; i < nx; i++ )
+      {
+         jac_col_start[i + 1] += jac_col_start[i];
+      }
+      for( Index i = 0; i < ng; i++ )
+      {
+         jac_row_start[i + 1] += jac_row_start[i];
+      }
+      std::vector<Index> col_pos(jac_col_start, jac_col_start + nx);
+      std::vector<Index> row_pos(jac_row_start, jac_row_start + ng);
+      for( Index i = 0; i < nz_jac_g; i++ )
+      {
+         jac_col_nz[col_pos[g_jCol[i]]++] = i;
+         jac_row_nz[row_pos[g_iRow[i]]++] = i;
+      }
    }
 
    // Space for the perturbed point
@@ -3018,80 +4556,307 @@ bool TNLPAdapter::CheckDerivatives(
       index_correction = 1;
    }
 
+   DerivativeTestReport report(!derivative_test_report_file_.empty());
+
    if( deriv_test == FIRST_ORDER_TEST || deriv_test == SECOND_ORDER_TEST )
    {
       jnlst_->Printf(J_SUMMARY, J_NLP, "Starting derivative checker for first derivatives.\n\n");
 
-      // Now go through all variables and check the partial derivatives
-      const Index ivar_first = Max(Index(0), deriv_test_start_index);
-      for( Index ivar = ivar_first; ivar < nx; ivar++ )
+      // Column of the Jacobian for the current variable, and for each
+      // constraint the perturbed variable that appears in it (-1 if none)
+      Number* jac_col = NULL;
+      Index* jac_row_var = NULL;
+      if( ng > 0 )
       {
-         Number this_perturbation = derivative_test_perturbation_ * Max(Number(1.), std::abs(xref[ivar]));
-         xpert[ivar] = xref[ivar] + this_perturbation;
+         jac_col = new Number[ng];
+         jac_row_var = new Index[ng];
+         for( Index icon = 0; icon < ng; icon++ )
+         {
+            jac_col[icon] = 0.;
+            jac_row_var[icon] = -1;
+         }
+      }
 
-         Number fpert;
-         new_x = true;
-         retval = tnlp_->eval_f(nx, xpert, new_x, fpert);
-         ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                          "In TNLP derivative test: f could not be evaluated at perturbed point.");
-         new_x = false;
+      // Now go through all (or a sample of) variables and check the partial derivatives
+      std::vector<Index> test_vars;
+      SampleDerivativeTestIndices(Max(Index(0), deriv_test_start_index), nx, derivative_test_sample_size_, test_vars);
+
+      // Variables that are perturbed at the same time when evaluating g,
+      // given by group_vars[group_start[k]], ..., group_vars[group_start[k+1]-1]
+      std::vector<Index> group_vars;
+      std::vector<Index> group_start;
+      if( derivative_test_colored_ && ng > 0 )
+      {
+         // Greedy coloring of the column intersection graph of the
+         // Jacobian for the tested variables: two variables get the same
+         // color only if they do not appear in the same constraint.
+         std::vector<Index> color(nx, -1);
+         std::vector<Index> forbidden(test_vars.size(), -1);
+         Index ncolors = 0;
+         for( size_t k = 0; k < test_vars.size(); k++ )
+         {
+            const Index ivar = test_vars[k];
+            for( Index i = jac_col_start[ivar]; i < jac_col_start[ivar + 1]; i++ )
+            {
+               const Index row = g_iRow[jac_col_nz[i]];
+               for( Index j = jac_row_start[row]; j < jac_row_start[row + 1]; j++ )
+               {
+                  const Index other = g_jCol[jac_row_nz[j]];
+                  if( color[other] >= 0 )
+                  {
+                     forbidden[color[other]] = ivar;
+                  }
+               }
+            }
+            Index c = 0;
+            while( c < ncolors && forbidden[c] == ivar )
+            {
+               c++;
+            }
+            color[ivar] = c;
+            if( c == ncolors )
+            {
+               ncolors++;
+            }
+         }
 
-         Number deriv_approx = (fpert - fref) / this_perturbation;
-         Number deriv_exact = grad_f[ivar];
-         Number rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
-         char cflag = ' ';
-         if( rel_error >= derivative_test_tol_ )
+         // sort variables by color
+         group_start.assign(ncolors + 1, 0);
+         for( size_t k = 0; k < test_vars.size(); k++ )
          {
-            cflag = '*';
-            nerrors++;
+            group_start[color[test_vars[k]] + 1]++;
          }
-         if( cflag != ' ' || derivative_test_print_all_ )
+         for( Index c = 0; c < ncolors; c++ )
          {
-            jnlst_->Printf(J_WARNING, J_NLP, "%c grad_f[      %5" IPOPT_INDEX_FORMAT "] = %23.16e    ~ %23.16e  [%10.3e]\n", cflag,
-                           ivar + index_correction, deriv_exact, deriv_approx, rel_error);
+            group_start[c + 1] += group_start[c];
+         }
+         group_vars.resize(test_vars.size());
+         std::vector<Index> pos(group_start.begin(), group_start.end() - 1);
+         for( size_t k = 0; k < test_vars.size(); k++ )
+         {
+            group_vars[pos[color[test_vars[k]]]++] = test_vars[k];
          }
 
-         if( ng > 0 )
+         jnlst_->Printf(J_DETAILED, J_NLP, "Derivative checker evaluates the constraints at %" IPOPT_INDEX_FORMAT " points for %" IPOPT_INDEX_FORMAT " variables.\n\n",
+                        ncolors, (Index) test_vars.size());
+      }
+      else
+      {
+         group_vars = test_vars;
+         group_start.resize(test_vars.size() + 1);
+         for( size_t k = 0; k <= test_vars.size(); k++ )
          {
-            retval = tnlp_->eval_g(nx, xpert, new_x, ng, gpert);
-            ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                             "In TNLP derivative test: g could not be evaluated at reference point.");
-            for( Index icon = 0; icon < ng; icon++ )
+            group_start[k] = (Index) k;
+         }
+      }
+      const Index ngroups = (Index) group_start.size() - 1;
+
+      // The perturbed points of up to nthreads groups are evaluated at once
+      const Index nthreads = Max(Index(1), Min(NumThreads(evaluation_num_threads_), ngroups));
+      Number* xperts = new Number[nthreads * nx];
+      for( Index k = 0; k < nthreads; k++ )
+      {
+         IpBlasCopy(nx, xref, 1, xperts + k * nx, 1);
+      }
+      Number* fperts = new Number[group_vars.size()];
+      Number* gperts = new Number[nthreads * ng];
+      bool* success_f = new bool[nthreads];
+      bool* success_g = new bool[nthreads];
+      DerivativeTestFirstOrderWork work(GetRawPtr(tnlp_), nx, xref, derivative_test_perturbation_, ng, nthreads > 1,
+                                        xperts, fperts, gperts, success_f, success_g);
+
+      for( Index kbegin = 0; kbegin < ngroups; kbegin += nthreads )
+      {
+         const Index nbatch = Min(nthreads, ngroups - kbegin);
+         work.SetGroups(group_vars.empty() ? NULL : &group_vars[0], &group_start[kbegin]);
+         DoParallelWork(nbatch, work);
+
+         for( Index k = 0; k < nbatch; k++ )
+         {
+            const Index first = group_start[kbegin + k];
+            const Index last = group_start[kbegin + k + 1];
+
+            ASSERT_EXCEPTION(success_f[k], ERROR_IN_TNLP_DERIVATIVE_TEST,
+                             "In TNLP derivative test: f could not be evaluated at perturbed point.");
+            if( ng > 0 )
             {
-               deriv_approx = (gpert[icon] - gref[icon]) / this_perturbation;
-               deriv_exact = 0.;
-               bool found = false;
-               for( Index i = 0; i < nz_jac_g; i++ )
+               ASSERT_EXCEPTION(success_g[k], ERROR_IN_TNLP_DERIVATIVE_TEST,
+                                "In TNLP derivative test: g could not be evaluated at reference point.");
+               for( Index p = first; p < last; p++ )
                {
-                  if( g_iRow[i] == icon && g_jCol[i] == ivar )
+                  const Index ivar = group_vars[p];
+                  for( Index i = jac_col_start[ivar]; i < jac_col_start[ivar + 1]; i++ )
                   {
-                     found = true;
-                     deriv_exact += jac_g[i];
+                     jac_row_var[g_iRow[jac_col_nz[i]]] = ivar;
                   }
                }
-               rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
-               cflag = ' ';
+            }
+
+            for( Index p = first; p < last; p++ )
+            {
+               const Index ivar = group_vars[p];
+               Number this_perturbation = derivative_test_perturbation_ * Max(Number(1.), std::abs(xref[ivar]));
+
+               Number deriv_approx = (fperts[p] - fref) / this_perturbation;
+               Number deriv_exact = grad_f[ivar];
+               Number rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
+               char cflag = ' ';
                if( rel_error >= derivative_test_tol_ )
                {
                   cflag = '*';
                   nerrors++;
                }
-               char sflag = ' ';
-               if( found )
+               if( cflag != ' ' || derivative_test_print_all_ )
                {
-                  sflag = 'v';
+                  jnlst_->Printf(J_WARNING, J_NLP, "%c grad_f[      %5" IPOPT_INDEX_FORMAT "] = %23.16e    ~ %23.16e  [%10.3e]\n", cflag,
+                                 ivar + index_correction, deriv_exact, deriv_approx, rel_error);
                }
-               if( cflag != ' ' || derivative_test_print_all_ )
+               report.Record(DerivativeTestReport::GRAD_F, -1, ivar, -1, deriv_exact, deriv_approx, rel_error);
+
+               if( ng > 0 )
                {
-                  jnlst_->Printf(J_WARNING, J_NLP, "%c jac_g [%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e %c  ~ %23.16e  [%10.3e]\n", cflag,
-                                 icon + index_correction, ivar + index_correction, deriv_exact, sflag, deriv_approx, rel_error);
+                  const Number* gpert_k = gperts + k * ng;
+                  for( Index i = jac_col_start[ivar]; i < jac_col_start[ivar + 1]; i++ )
+                  {
+                     const Index& inz = jac_col_nz[i];
+                     jac_col[g_iRow[inz]] += jac_g[inz];
+                  }
+                  for( Index icon = 0; icon < ng; icon++ )
+                  {
+                     if( jac_row_var[icon] >= 0 && jac_row_var[icon] != ivar )
+                     {
+                        // the change of this constraint is attributed to another variable of the group
+                        continue;
+                     }
+                     deriv_approx = (gpert_k[icon] - gref[icon]) / this_perturbation;
+                     deriv_exact = jac_col[icon];
+                     rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
+                     cflag = ' ';
+                     if( rel_error >= derivative_test_tol_ )
+                     {
+                        cflag = '*';
+                        nerrors++;
+                     }
+                     char sflag = ' ';
+                     if( jac_row_var[icon] == ivar )
+                     {
+                        sflag = 'v';
+                     }
+                     if( cflag != ' ' || derivative_test_print_all_ )
+                     {
+                        jnlst_->Printf(J_WARNING, J_NLP, "%c jac_g [%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e %c  ~ %23.16e  [%10.3e]\n", cflag,
+                                       icon + index_correction, ivar + index_correction, deriv_exact, sflag, deriv_approx, rel_error);
+                     }
+                     report.Record(DerivativeTestReport::JAC_G, icon, ivar, -1, deriv_exact, deriv_approx, rel_error);
+                  }
+                  for( Index i = jac_col_start[ivar]; i < jac_col_start[ivar + 1]; i++ )
+                  {
+                     jac_col[g_iRow[jac_col_nz[i]]] = 0.;
+                  }
                }
             }
-         }
 
-         xpert[ivar] = xref[ivar];
+            if( ng > 0 )
+            {
+               for( Index p = first; p < last; p++ )
+               {
+                  const Index ivar = group_vars[p];
+                  for( Index i = jac_col_start[ivar]; i < jac_col_start[ivar + 1]; i++ )
+                  {
+                     jac_row_var[g_iRow[jac_col_nz[i]]] = -1;
+                  }
+               }
+            }
+         }
       }
 
+      delete[] xperts;
+      delete[] fperts;
+      delete[] gperts;
+      delete[] success_f;
+      delete[] success_g;
+      delete[] jac_col;
+      delete[] jac_row_var;
+
+      if( derivative_test_random_directions_ > 0 )
+      {
+         jnlst_->Printf(J_SUMMARY, J_NLP, "\nStarting derivative checker for first derivatives in %" IPOPT_INDEX_FORMAT " random directions.\n\n",
+                        derivative_test_random_directions_);
+
+         // Each direction is checked with one evaluation of f and g; a
+         // mismatch points to the function, but not to the variable.
+         Number* dir = new Number[nx];
+         Number* jac_dir = NULL;
+         if( ng > 0 )
+         {
+            jac_dir = new Number[ng];
+         }
+         for( Index idir = 0; idir < derivative_test_random_directions_; idir++ )
+         {
+            for( Index ivar = 0; ivar < nx; ivar++ )
+            {
+               dir[ivar] = (2. * IpRandom01() - 1.) * Max(Number(1.), std::abs(xref[ivar]));
+               xpert[ivar] = xref[ivar] + derivative_test_perturbation_ * dir[ivar];
+            }
+
+            Number fpert;
+            new_x = true;
+            retval = tnlp_->eval_f(nx, xpert, new_x, fpert);
+            ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                             "In TNLP derivative test: f could not be evaluated at perturbed point.");
+            new_x = false;
+
+            Number deriv_approx = (fpert - fref) / derivative_test_perturbation_;
+            Number deriv_exact = IpBlasDot(nx, grad_f, 1, dir, 1);
+            Number rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
+            char cflag = ' ';
+            if( rel_error >= derivative_test_tol_ )
+            {
+               cflag = '*';
+               nerrors++;
+            }
+            if( cflag != ' ' || derivative_test_print_all_ )
+            {
+               jnlst_->Printf(J_WARNING, J_NLP, "%c dir_f [      %5" IPOPT_INDEX_FORMAT "] = %23.16e    ~ %23.16e  [%10.3e]\n", cflag,
+                              idir, deriv_exact, deriv_approx, rel_error);
+            }
+            report.Record(DerivativeTestReport::DIR_F, -1, -1, -1, deriv_exact, deriv_approx, rel_error);
+
+            if( ng > 0 )
+            {
+               retval = tnlp_->eval_g(nx, xpert, new_x, ng, gpert);
+               ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
+                                "In TNLP derivative test: g could not be evaluated at perturbed point.");
+               const Number zero = 0.;
+               IpBlasCopy(ng, &zero, 0, jac_dir, 1);
+               for( Index i = 0; i < nz_jac_g; i++ )
+               {
+                  jac_dir[g_iRow[i]] += jac_g[i] * dir[g_jCol[i]];
+               }
+               for( Index icon = 0; icon < ng; icon++ )
+               {
+                  deriv_approx = (gpert[icon] - gref[icon]) / derivative_test_perturbation_;
+                  deriv_exact = jac_dir[icon];
+                  rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
+                  cflag = ' ';
+                  if( rel_error >= derivative_test_tol_ )
+                  {
+                     cflag = '*';
+                     nerrors++;
+                  }
+                  if( cflag != ' ' || derivative_test_print_all_ )
+                  {
+                     jnlst_->Printf(J_WARNING, J_NLP, "%c dir_g [%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e    ~ %23.16e  [%10.3e]\n", cflag,
+                                    icon + index_correction, idir, deriv_exact, deriv_approx, rel_error);
+                  }
+                  report.Record(DerivativeTestReport::DIR_G, icon, -1, -1, deriv_exact, deriv_approx, rel_error);
+               }
+            }
+         }
+         IpBlasCopy(nx, xref, 1, xpert, 1);
+         delete[] dir;
+         delete[] jac_dir;
+      }
    }
    const Number zero = 0.;
    if( deriv_test == SECOND_ORDER_TEST || deriv_test == ONLY_SECOND_ORDER_TEST )
@@ -3131,6 +4896,43 @@ bool TNLPAdapter::CheckDerivatives(
 #endif
       Number* h_values = new Number[nz_hess_lag];
 
+      // Setup access to the nonzeros in each column of the full symmetric Hessian
+      Index* hess_col_start = new Index[nx + 1];
+      Index* hess_col_nz = new Index[2 * nz_hess_lag];
+      for( Index i = 0; i <= nx; i++ )
+      {
+         hess_col_start[i] = 0;
+      }
+      for( Index i = 0; i < nz_hess_lag; i++ )
+      {
+         hess_col_start[h_jCol[i] + 1]++;
+         if( h_iRow[i] != h_jCol[i] )
+         {
+            hess_col_start[h_iRow[i] + 1]++;
+         }
+      }
+      for( Index i = 0; i < nx; i++ )
+      {
+         hess_col_start[i + 1] += hess_col_start[i];
+      }
+      std::vector<Index> hess_col_pos(hess_col_start, hess_col_start + nx);
+      for( Index i = 0; i < nz_hess_lag; i++ )
+      {
+         hess_col_nz[hess_col_pos[h_jCol[i]]++] = i;
+         if( h_iRow[i] != h_jCol[i] )
+         {
+            hess_col_nz[hess_col_pos[h_iRow[i]]++] = i;
+         }
+      }
+      // Column of the Hessian for the current variable
+      Number* hess_col = new Number[nx];
+      bool* hess_col_found = new bool[nx];
+      IpBlasCopy(nx, &zero, 0, hess_col, 1);
+      for( Index i = 0; i < nx; i++ )
+      {
+         hess_col_found[i] = false;
+      }
+
       Number* lambda = NULL;
       if( ng > 0 )
       {
@@ -3138,8 +4940,22 @@ bool TNLPAdapter::CheckDerivatives(
          IpBlasCopy(ng, &zero, 0, lambda, 1);
       }
       Number* gradref = new Number[nx]; // gradient of objective or constraint at reference point
-      Number* gradpert = new Number[nx]; // gradient of objective or constraint at perturbed point
-      Number* jacpert = new Number[nz_jac_g];
+
+      std::vector<Index> test_vars;
+      SampleDerivativeTestIndices(0, nx, derivative_test_sample_size_, test_vars);
+
+      // The gradients at the perturbed points of up to nthreads variables are evaluated at once
+      const Index nthreads = Max(Index(1), Min(NumThreads(evaluation_num_threads_), (Index) test_vars.size()));
+      Number* xperts = new Number[nthreads * nx];
+      for( Index k = 0; k < nthreads; k++ )
+      {
+         IpBlasCopy(nx, xref, 1, xperts + k * nx, 1);
+      }
+      Number* gradperts = new Number[nthreads * nx]; // gradients of objective or constraint at perturbed points
+      Number* jacperts = new Number[nthreads * nz_jac_g];
+      bool* success = new bool[nthreads];
+      DerivativeTestSecondOrderWork work(GetRawPtr(tnlp_), nx, xref, derivative_test_perturbation_, ng, nz_jac_g, g_jCol,
+                                         jac_row_start, jac_row_nz, xperts, gradperts, jacperts, success);
 
       // Check all Hessians
       const Index icon_first = Max(Index(-1), deriv_test_start_index);
@@ -3156,12 +4972,10 @@ bool TNLPAdapter::CheckDerivatives(
             DBG_ASSERT(lambda != NULL);
             lambda[icon] = 1.5;
             IpBlasCopy(nx, &zero, 0, gradref, 1);
-            for( Index i = 0; i < nz_jac_g; i++ )
+            for( Index i = jac_row_start[icon]; i < jac_row_start[icon + 1]; i++ )
             {
-               if( g_iRow[i] == icon )
-               {
-                  gradref[g_jCol[i]] += jac_g[i];
-               }
+               const Index& inz = jac_row_nz[i];
+               gradref[g_jCol[inz]] += jac_g[inz];
             }
          }
          // Hessian at reference point
@@ -3171,83 +4985,80 @@ bool TNLPAdapter::CheckDerivatives(
          ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
                           "In TNLP derivative test: Hessian could not be evaluated at reference point.");
 
-         for( Index ivar = 0; ivar < nx; ivar++ )
+         for( size_t kbegin = 0; kbegin < test_vars.size(); kbegin += nthreads )
          {
-            Number this_perturbation = derivative_test_perturbation_ * Max(Number(1.), std::abs(xref[ivar]));
-            xpert[ivar] = xref[ivar] + this_perturbation;
+            const Index nbatch = Min(nthreads, (Index) (test_vars.size() - kbegin));
+            work.SetFunctionAndVariables(icon, &test_vars[kbegin]);
+            DoParallelWork(nbatch, work);
 
-            new_x = true;
-            if( icon == -1 )
-            {
-               // we are looking at the objective function
-               retval = tnlp_->eval_grad_f(nx, xpert, new_x, gradpert);
-               ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                                "In TNLP derivative test: grad_f could not be evaluated at perturbed point.");
-            }
-            else
+            for( Index k = 0; k < nbatch; k++ )
             {
-               // this is the icon-th constraint
-               retval = tnlp_->eval_jac_g(nx, xpert, new_x, ng, nz_jac_g, NULL, NULL, jacpert);
-               ASSERT_EXCEPTION(retval, ERROR_IN_TNLP_DERIVATIVE_TEST,
-                                "In TNLP derivative test: Jacobian values could not be evaluated at reference point.");
-               // ok, now we need to filter the gradient of the icon-th constraint
-               IpBlasCopy(nx, &zero, 0, gradpert, 1);
-               IpBlasCopy(nx, &zero, 0, gradref, 1);
-               for( Index i = 0; i < nz_jac_g; i++ )
+               const Index ivar = test_vars[kbegin + k];
+               Number this_perturbation = derivative_test_perturbation_ * Max(Number(1.), std::abs(xref[ivar]));
+               if( icon == -1 )
                {
-                  if( g_iRow[i] == icon )
-                  {
-                     gradpert[g_jCol[i]] += jacpert[i];
-                     gradref[g_jCol[i]] += jac_g[i];
-                  }
+                  ASSERT_EXCEPTION(success[k], ERROR_IN_TNLP_DERIVATIVE_TEST,
+                                   "In TNLP derivative test: grad_f could not be evaluated at perturbed point.");
                }
-            }
-
-            for( Index ivar2 = 0; ivar2 < nx; ivar2++ )
-            {
-               Number deriv_approx = 1.5 * (gradpert[ivar2] - gradref[ivar2]) / this_perturbation;
-               Number deriv_exact = 0.;
-               bool found = false;
-               for( Index i = 0; i < nz_hess_lag; i++ )
-               {
-                  if( (h_iRow[i] == ivar && h_jCol[i] == ivar2) || (h_jCol[i] == ivar && h_iRow[i] == ivar2) )
-                  {
-                     deriv_exact += h_values[i];
-                     found = true;
-                  }
-               }
-               Number rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
-               char cflag = ' ';
-               if( rel_error >= derivative_test_tol_ )
+               else
                {
-                  cflag = '*';
-                  nerrors++;
+                  ASSERT_EXCEPTION(success[k], ERROR_IN_TNLP_DERIVATIVE_TEST,
+                                   "In TNLP derivative test: Jacobian values could not be evaluated at reference point.");
                }
-               char sflag = ' ';
-               if( found )
+               const Number* gradpert = gradperts + k * nx;
+
+               for( Index i = hess_col_start[ivar]; i < hess_col_start[ivar + 1]; i++ )
                {
-                  sflag = 'v';
+                  const Index& inz = hess_col_nz[i];
+                  const Index other = (h_iRow[inz] == ivar) ? h_jCol[inz] : h_iRow[inz];
+                  hess_col[other] += h_values[inz];
+                  hess_col_found[other] = true;
                }
-               if( cflag != ' ' || derivative_test_print_all_ )
+
+               for( Index ivar2 = 0; ivar2 < nx; ivar2++ )
                {
-                  if( icon == -1 )
+                  Number deriv_approx = 1.5 * (gradpert[ivar2] - gradref[ivar2]) / this_perturbation;
+                  Number deriv_exact = hess_col[ivar2];
+                  Number rel_error = std::abs(deriv_approx - deriv_exact) / Max(std::abs(deriv_approx), derivative_test_tol_);
+                  char cflag = ' ';
+                  if( rel_error >= derivative_test_tol_ )
                   {
-                     jnlst_->Printf(J_WARNING, J_NLP,
-                                    "%c             obj_hess[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e %c  ~ %23.16e  [%10.3e]\n", cflag,
-                                    ivar + index_correction, ivar2 + index_correction, deriv_exact, sflag, deriv_approx, rel_error);
+                     cflag = '*';
+                     nerrors++;
                   }
-                  else
+                  char sflag = ' ';
+                  if( hess_col_found[ivar2] )
                   {
-                     jnlst_->Printf(J_WARNING, J_NLP,
-                                    "%c %5" IPOPT_INDEX_FORMAT "-th constr_hess[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e %c  ~ %23.16e  [%10.3e]\n", cflag,
-                                    icon + index_correction, ivar + index_correction, ivar2 + index_correction, deriv_exact, sflag,
-                                    deriv_approx, rel_error);
+                     sflag = 'v';
                   }
+                  if( cflag != ' ' || derivative_test_print_all_ )
+                  {
+                     if( icon == -1 )
+                     {
+                        jnlst_->Printf(J_WARNING, J_NLP,
+                                       "%c             obj_hess[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e %c  ~ %23.16e  [%10.3e]\n", cflag,
+                                       ivar + index_correction, ivar2 + index_correction, deriv_exact, sflag, deriv_approx, rel_error);
+                     }
+                     else
+                     {
+                        jnlst_->Printf(J_WARNING, J_NLP,
+                                       "%c %5" IPOPT_INDEX_FORMAT "-th constr_hess[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e %c  ~ %23.16e  [%10.3e]\n", cflag,
+                                       icon + index_correction, ivar + index_correction, ivar2 + index_correction, deriv_exact, sflag,
+                                       deriv_approx, rel_error);
+                     }
+                  }
+                  report.Record(icon == -1 ? DerivativeTestReport::OBJ_HESS : DerivativeTestReport::CONSTR_HESS, icon, ivar,
+                                ivar2, deriv_exact, deriv_approx, rel_error);
                }
 
+               for( Index i = hess_col_start[ivar]; i < hess_col_start[ivar + 1]; i++ )
+               {
+                  const Index& inz = hess_col_nz[i];
+                  const Index other = (h_iRow[inz] == ivar) ? h_jCol[inz] : h_iRow[inz];
+                  hess_col[other] = 0.;
+                  hess_col_found[other] = false;
+               }
             }
-
-            xpert[ivar] = xref[ivar];
          }
 
          if( icon >= 0 )
@@ -3259,10 +5070,16 @@ bool TNLPAdapter::CheckDerivatives(
       delete[] h_iRow;
       delete[] h_jCol;
       delete[] h_values;
+      delete[] hess_col_start;
+      delete[] hess_col_nz;
+      delete[] hess_col;
+      delete[] hess_col_found;
       delete[] lambda;
       delete[] gradref;
-      delete[] gradpert;
-      delete[] jacpert;
+      delete[] xperts;
+      delete[] gradperts;
+      delete[] jacperts;
+      delete[] success;
    }
 
    delete[] xref;
@@ -3272,6 +5089,10 @@ bool TNLPAdapter::CheckDerivatives(
    delete[] g_iRow;
    delete[] g_jCol;
    delete[] jac_g;
+   delete[] jac_col_start;
+   delete[] jac_col_nz;
+   delete[] jac_row_start;
+   delete[] jac_row_nz;
    delete[] gpert;
 
    if( nerrors == 0 )
@@ -3283,6 +5104,20 @@ bool TNLPAdapter::CheckDerivatives(
       jnlst_->Printf(J_WARNING, J_NLP, "\nDerivative checker detected %" IPOPT_INDEX_FORMAT " error(s).\n\n", nerrors);
    }
 
+   if( !derivative_test_report_file_.empty() )
+   {
+      if( report.Write(derivative_test_report_file_, derivative_test_tol_, index_correction) )
+      {
+         jnlst_->Printf(J_SUMMARY, J_NLP, "Largest derivative deviations per function written to %s.\n\n",
+                        derivative_test_report_file_.c_str());
+      }
+      else
+      {
+         jnlst_->Printf(J_WARNING, J_NLP, "Could not open derivative test report file %s.\n\n",
+                        derivative_test_report_file_.c_str());
+      }
+   }
+
    return retval;
 }
 
@@ -3295,6 +5130,8 @@ bool TNLPAdapter::DetermineDependentConstraints(
    const Number*     /*g_u*/,
    Index             n_c,
    const Index*      c_map,
+   const Index*      g_iRow,
+   const Index*      g_jCol,
    std::list<Index>& c_deps
 )
 {
@@ -3303,40 +5140,8 @@ bool TNLPAdapter::DetermineDependentConstraints(
    SmartPtr<ExpansionMatrixSpace> P_c_g_space = new ExpansionMatrixSpace(n_full_g_, n_c, c_map);
    SmartPtr<ExpansionMatrix> P_c_g = P_c_g_space->MakeNewExpansionMatrix();
 
-   // Get the structure of the big Jacobian of g and get the map for
-   // the equality constraints entries
-   Index* g_iRow = new Index[nz_full_jac_g_];
-   Index* g_jCol = new Index[nz_full_jac_g_];
-   if( !tnlp_->eval_jac_g(n_full_x_, NULL, false, n_full_g_, nz_full_jac_g_, g_iRow, g_jCol, NULL) )
-   {
-      delete[] g_iRow;
-      delete[] g_jCol;
-      return false;
-   }
-   if( index_style_ == TNLP::FORTRAN_STYLE )
-   {
-      for( Index i = 0; i < nz_full_jac_g_; i++ )
-      {
-         DBG_ASSERT(g_iRow[i] > 0);
-         DBG_ASSERT(g_iRow[i] <= n_full_g_);
-         DBG_ASSERT(g_jCol[i] > 0);
-         DBG_ASSERT(g_jCol[i] <= n_full_x_);
-         g_iRow[i] -= 1;
-         g_jCol[i] -= 1;
-      }
-   }
-#if IPOPT_CHECKLEVEL > 0
-   else
-   {
-      for( Index i = 0; i < nz_full_jac_g_; i++ )
-      {
-         DBG_ASSERT(g_iRow[i] >= 0);
-         DBG_ASSERT(g_iRow[i] < n_full_g_);
-         DBG_ASSERT(g_jCol[i] >= 0);
-         DBG_ASSERT(g_jCol[i] < n_full_x_);
-      }
-   }
-#endif
+   // Get the map for the equality constraints entries of the big
+   // Jacobian of g, whose structure is given with 1-based indices
    // TODO: Here we don't handle
    // fixed_variable_treatment_==MAKE_PARAMETER correctly (yet?)
    // Include space for the RHS
@@ -3360,8 +5165,8 @@ bool TNLPAdapter::DetermineDependentConstraints(
       }
       for( Index i = 0; i < nz_full_jac_g_; i++ )
       {
-         const Index& c_row = c_row_pos[g_iRow[i]];
-         const Index& c_col = c_col_pos[g_jCol[i]];
+         const Index& c_row = c_row_pos[g_iRow[i] - 1];
+         const Index& c_col = c_col_pos[g_jCol[i] - 1];
          if( c_col != -1 && c_row != -1 )
          {
             jac_c_map[nz_jac_c] = i;
@@ -3376,8 +5181,8 @@ bool TNLPAdapter::DetermineDependentConstraints(
    {
       for( Index i = 0; i < nz_full_jac_g_; i++ )
       {
-         const Index& c_row = c_row_pos[g_iRow[i]];
-         const Index& c_col = g_jCol[i];
+         const Index& c_row = c_row_pos[g_iRow[i] - 1];
+         const Index& c_col = g_jCol[i] - 1;
          if( c_row != -1 )
          {
             jac_c_map[nz_jac_c] = i;
@@ -3387,8 +5192,6 @@ bool TNLPAdapter::DetermineDependentConstraints(
          }
       }
    }
-   delete[] g_iRow;
-   delete[] g_jCol;
 
    // First we evaluate the equality constraint Jacobian at the
    // starting point with some random perturbation (projected into bounds)
@@ -186,6 +186,49 @@ public:
       SymMatrix&    h
    );
 
+   /** Compute the product of the Hessian of the Lagrangian with a vector by TNLP::eval_h_times_vec */
+   virtual bool Eval_h_times_vec(
+      const Vector& x,
+      Number        obj_factor,
+      const Vector& yc,
+      const Vector& yd,
+      const Vector& v,
+      Vector&       hv
+   );
+
+   /** Evaluate objective and constraints at several points.
+    *
+    *  If Ipopt has been compiled with C++11 or later, the points are
+    *  evaluated concurrently by calling TNLP::eval_f and TNLP::eval_g
+    *  from separate threads. The TNLP must support this.
+    *  Otherwise, false is returned.
+    */
+   virtual bool Eval_f_c_d_AtPoints(
+      Index                npoints,
+      const Vector* const* x,
+      Number*              f,
+      Vector* const*       c,
+      Vector* const*       d,
+      bool*                success
+   );
+
+   /** Evaluate objective gradient and constraint Jacobians at several points.
+    *
+    *  If option evaluation_num_threads is larger than 1, the Jacobian is
+    *  not approximated by finite differences, and Ipopt has been compiled
+    *  with C++11 or later, the points are evaluated concurrently by calling
+    *  TNLP::eval_grad_f and TNLP::eval_jac_g from up to this many threads.
+    *  The TNLP must support this.  Otherwise, false is returned.
+    */
+   virtual bool Eval_grad_f_jac_c_d_AtPoints(
+      Index                npoints,
+      const Vector* const* x,
+      Vector* const*       g_f,
+      Matrix* const*       jac_c,
+      Matrix* const*       jac_d,
+      bool*                success
+   );
+
    virtual void GetScalingParameters(
       const SmartPtr<const VectorSpace> x_space,
       const SmartPtr<const VectorSpace> c_space,
@@ -261,6 +304,14 @@ public:
       JAC_FINDIFF_VALUES
    };
 
+   /** Enum for specifying technique for computing Hessian values */
+   enum HessianEvalEnum
+   {
+      HESS_EXACT = 0,
+      HESS_FINDIFF_VALUES,
+      HESS_PRODUCTS
+   };
+
    /** Method for performing the derivative test */
    bool CheckDerivatives(
       DerivativeTestEnum deriv_test,
@@ -435,6 +486,65 @@ private:
    );
    ///@}
 
+   /** Plan for gathering a part of the nonzeros of a derivative from the array of values given by the TNLP.
+    *
+    *  The positions of the nonzeros in the full array are increasing.
+    *  If they form long runs of consecutive positions, only the start of each
+    *  run in the full array and its end in the gathered array are stored, and
+    *  whole runs are copied.  Otherwise, each position is stored individually.
+    */
+   class GatherPlan
+   {
+   public:
+      /** Constructor for an empty plan */
+      GatherPlan();
+
+      /** Destructor */
+      ~GatherPlan();
+
+      /** Set up the plan for the given positions of the nonzeros in the full array */
+      void Initialize(
+         Index        nnz,
+         const Index* pos
+      );
+
+      /** Gather the nonzeros from the full array src into dst */
+      void Gather(
+         const Number* src,
+         Number*       dst
+      ) const;
+
+      /** Number of nonzeros that are gathered */
+      Index Nonzeros() const
+      {
+         return nnz_;
+      }
+
+   private:
+      /** Copy Constructor */
+      GatherPlan(
+         const GatherPlan&
+      );
+
+      /** Default Assignment Operator */
+      void operator=(
+         const GatherPlan&
+      );
+
+      /** Free the memory of the plan */
+      void Clear();
+
+      Index nnz_;
+      /** Number of runs, -1 if pos_ is used */
+      Index nruns_;
+      /** Start of each run in the full array */
+      Index* run_start_;
+      /** End of each run in the gathered array */
+      Index* run_end_;
+      /** Position of each nonzero in the full array, if the runs are too short */
+      Index* pos_;
+   };
+
    /** @name Method implementing the detection of linearly dependent equality constraints */
    bool DetermineDependentConstraints(
       Index             n_x_var,
@@ -445,6 +555,8 @@ private:
       const Number*     g_u,
       Index             n_c,
       const Index*      c_map,
+      const Index*      g_iRow,
+      const Index*      g_jCol,
       std::list<Index>& c_deps);
 
    /** Pointer to the TNLP class (class specific to Number* vectors and triplet matrices) */
@@ -481,6 +593,14 @@ private:
    bool derivative_test_print_all_;
    /** Index of first quantity to be checked. */
    Index derivative_test_first_index_;
+   /** Number of randomly sampled variables to check, or 0 for all. */
+   Index derivative_test_sample_size_;
+   /** Whether variables that do not share a constraint are perturbed together in the first derivative test. */
+   bool derivative_test_colored_;
+   /** Number of random directions for directional derivative test. */
+   Index derivative_test_random_directions_;
+   /** Name of file to write derivative test report to, empty for none. */
+   std::string derivative_test_report_file_;
    /** Flag indicating whether the TNLP with identical structure has already been solved before. */
    bool warm_start_same_structure_;
    /** Flag indicating what Hessian information is to be used. */
@@ -489,12 +609,18 @@ private:
    Index num_linear_variables_;
    /** Flag indicating how Jacobian is computed. */
    JacobianApproxEnum jacobian_approximation_;
+   /** Flag indicating how values of the Hessian are computed. */
+   HessianEvalEnum hessian_evaluation_;
    /** Size of the perturbation for the derivative approximation */
    Number findiff_perturbation_;
    /** Maximal perturbation of the initial point */
    Number point_perturbation_radius_;
    /** Flag indicating if rhs should be considered during dependency detection */
    bool dependency_detection_with_rhs_;
+   /** Maximal number of threads for the structure analysis in GetSpaces */
+   Index num_threads_;
+   /** Maximal number of threads that evaluate the TNLP at perturbed points at once */
+   Index evaluation_num_threads_;
 
    /** Overall convergence tolerance */
    Number tol_;
@@ -576,10 +702,71 @@ private:
    bool internal_eval_jac_g(bool new_x);
    ///@}
 
+   /**@name Internal routines for extracting c and d from the values of g. */
+   ///@{
+   void FullGToC(
+      const Number* full_x,
+      const Number* full_g,
+      Vector&       c
+   ) const;
+   void FullGToD(
+      const Number* full_g,
+      Vector&       d
+   ) const;
+   ///@}
+
+   /** Internal routine for evaluating the values of the full Hessian of the Lagrangian.
+    *
+    * Calls the TNLP or computes a finite difference approximation, depending on hessian_evaluation_.
+    */
+   bool internal_eval_h(
+      bool    new_x,
+      Number  obj_factor,
+      bool    new_y,
+      Number* full_h
+   );
+
    /** @name Internal methods for dealing with finite difference approximation */
    ///@{
    /** Initialize sparsity structure for finite difference Jacobian */
    void initialize_findiff_jac(const Index* iRow, const Index* jCol);
+
+   /** Initialize coloring for finite difference Hessian
+    *
+    * iRow and jCol are the Hessian structure in Fortran-style counting.
+    */
+   void initialize_findiff_hess(const Index* iRow, const Index* jCol);
+
+   /** Compute the gradient of the Lagrangian for the full problem at a given point
+    *
+    * jac_values needs to have space for the values of the full Jacobian.
+    */
+   bool internal_findiff_grad_lag(
+      const Number* x,
+      bool          new_x,
+      Number        obj_factor,
+      Number*       jac_values,
+      Number*       grad_lag
+   );
+
+   /** Compute the full Hessian of the Lagrangian by colored finite differences of the gradient of the Lagrangian */
+   bool internal_findiff_h(bool new_x, Number obj_factor, Number* full_h);
+
+   /** Compute the nonzeros of the full Hessian in the columns of one color
+    *
+    * The gradient of the Lagrangian at the current point needs to be in
+    * findiff_hess_grad_lag_ref_.  part selects the work arrays, so that
+    * colors can be done concurrently with different parts.
+    */
+   bool internal_findiff_h_color(
+      Index   c,
+      Number  obj_factor,
+      Index   part,
+      Number* full_h
+   );
+
+   /** computes the colors of the finite difference Hessian in parallel */
+   friend class FindiffHessColorsWork;
    ///@}
 
    /**@name Internal Permutation Spaces and matrices
@@ -605,8 +792,13 @@ private:
    SmartPtr<ExpansionMatrixSpace> P_d_g_space_;
    SmartPtr<ExpansionMatrix> P_d_g_;
 
-   Index* jac_idx_map_;
-   Index* h_idx_map_;
+   /** Plan for gathering the Jacobian of c (without the entries for
+    *  fixed variables that are added as constraints) from jac_g_ */
+   GatherPlan jac_c_plan_;
+   /** Plan for gathering the Jacobian of d from jac_g_ */
+   GatherPlan jac_d_plan_;
+   /** Plan for gathering the Hessian from the full Hessian, only used if some nonzeros are dropped */
+   GatherPlan h_plan_;
 
    /** Position of fixed variables. This is required for a warm start */
    Index* x_fixed_map_;
@@ -632,6 +824,36 @@ private:
    Number* findiff_x_l_;
    /** Copy of the upper bounds */
    Number* findiff_x_u_;
+   /** Row indices (C-style) of Jacobian nonzeros, needed to form the gradient of the Lagrangian */
+   Index* findiff_hess_jac_iRow_;
+   /** Column indices (C-style) of Jacobian nonzeros, needed to form the gradient of the Lagrangian */
+   Index* findiff_hess_jac_jCol_;
+   /** Row indices (C-style) of Hessian nonzeros */
+   Index* findiff_hess_iRow_;
+   /** Column indices (C-style) of Hessian nonzeros */
+   Index* findiff_hess_jCol_;
+   /** Number of colors in the coloring of the Hessian columns */
+   Index findiff_hess_ncolors_;
+   /** Start position in findiff_hess_color_vars_ for each color */
+   Index* findiff_hess_color_vars_start_;
+   /** Variables, ordered by color */
+   Index* findiff_hess_color_vars_;
+   /** Start position in findiff_hess_color_nz_ for each color */
+   Index* findiff_hess_color_nz_start_;
+   /** Positions of Hessian nonzeros, ordered by color of their column */
+   Index* findiff_hess_color_nz_;
+   /** Perturbation applied to each variable in the current finite difference Hessian evaluation */
+   Number* findiff_hess_pert_;
+   /** Number of threads for the gradient evaluations of the finite difference Hessian */
+   Index findiff_hess_nthreads_;
+   /** Gradient of the Lagrangian at the current point */
+   Number* findiff_hess_grad_lag_ref_;
+   /** Gradient of the Lagrangian at a perturbed point, for each thread */
+   Number* findiff_hess_grad_lag_pert_;
+   /** Values of the full Jacobian, for each thread */
+   Number* findiff_hess_jac_values_;
+   /** Perturbed point, for each thread */
+   Number* findiff_hess_x_pert_;
    ///@}
 };
 
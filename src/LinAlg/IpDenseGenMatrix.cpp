@@ -125,6 +125,13 @@ void DenseGenMatrix::HighRankUpdateTranspose(
    DBG_ASSERT(NCols() == V2.NCols());
    DBG_ASSERT(beta == 0. || initialized_);
 
+   if( V1.TransMultMultiVector(alpha, V2, beta, values_, NRows()) )
+   {
+      initialized_ = true;
+      ObjectChanged();
+      return;
+   }
+
    if( beta == 0. )
    {
       for( Index j = 0; j < NCols(); j++ )
@@ -133,6 +133,14 @@ void DenseSymMatrix::HighRankUpdateTranspose(
    DBG_ASSERT(beta == 0. || initialized_);
 
    const Index dim = Dim();
+   // this computes the full matrix, though only the lower triangle is used
+   if( V1.TransMultMultiVector(alpha, V2, beta, values_, dim) )
+   {
+      initialized_ = true;
+      ObjectChanged();
+      return;
+   }
+
    if( beta == 0. )
    {
       for( Index j = 0; j < dim; j++ )
@@ -10,6 +10,7 @@
 #include "IpDebug.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <limits>
 
 namespace Ipopt
@@ -1635,4 +1636,54 @@ void DenseVector::PrintImplOffset(
    }
 }
 
+/** Number of entries of an array that correspond to the alignment of 64 bytes */
+static const Index storage_align_len = 64 / (Index) sizeof(Number);
+
+DenseVectorSpace::~DenseVectorSpace()
+{
+   for( std::vector<Number*>::iterator it = free_storage_.begin(); it != free_storage_.end(); ++it )
+   {
+      // the entry before the array holds its offset from the allocated memory
+      Number* values = *it;
+      delete[] (values - (Index) values[-1]);
+   }
+}
+
+Number* DenseVectorSpace::AllocateInternalStorage() const
+{
+   if( Dim() == 0 )
+   {
+      return NULL;
+   }
+
+   if( !free_storage_.empty() )
+   {
+      Number* values = free_storage_.back();
+      free_storage_.pop_back();
+      num_storage_reuses_++;
+      return values;
+   }
+
+   // allocate storage_align_len additional entries, so that the array can start at a 64 byte
+   // boundary, and remember the offset in the entry before the array
+   Number* raw = new Number[Dim() + storage_align_len];
+   std::size_t misalign = reinterpret_cast<std::size_t>(raw + 1) % 64;
+   Index offset = 1 + (Index) (((64 - misalign) % 64) / sizeof(Number));
+   DBG_ASSERT(offset <= storage_align_len);
+   Number* values = raw + offset;
+   values[-1] = (Number) offset;
+   num_storage_allocations_++;
+   return values;
+}
+
+void DenseVectorSpace::FreeInternalStorage(
+   Number* values
+) const
+{
+   if( values != NULL )
+   {
+      free_storage_.push_back(values);
+   }
+}
+
 } // namespace Ipopt
@@ -339,12 +339,13 @@ public:
    DenseVectorSpace(
       Index dim
    )
-      : VectorSpace(dim)
+      : VectorSpace(dim),
+        num_storage_allocations_(0),
+        num_storage_reuses_(0)
    { }
 
    /** Destructor */
-   ~DenseVectorSpace()
-   { }
+   ~DenseVectorSpace();
    ///@}
 
    /** Method for creating a new vector of this specific type. */
@@ -360,17 +361,39 @@ public:
 
    /**@name Methods called by DenseVector for memory management.
     *
-    * This could allow to have sophisticated memory management in the
-    * VectorSpace.
+    * Arrays that are freed are kept by the VectorSpace and handed out
+    * again by the next allocation, so that the many temporary vectors
+    * of an iteration do not allocate new memory.  The number of kept
+    * arrays is never larger than the maximal number of vectors of this
+    * space that existed at the same time.  The arrays are aligned at
+    * 64 bytes.
     */
    ///@{
    /** Allocate internal storage for the DenseVector */
-   inline Number* AllocateInternalStorage() const;
+   Number* AllocateInternalStorage() const;
 
    /** Deallocate internal storage for the DenseVector */
-   inline void FreeInternalStorage(
+   void FreeInternalStorage(
       Number* values
    ) const;
+
+   /** Number of arrays that have been allocated for vectors of this space
+    *
+    *  @since 3.15.0
+    */
+   Index NumStorageAllocations() const
+   {
+      return num_storage_allocations_;
+   }
+
+   /** Number of allocations that were avoided by reusing a freed array
+    *
+    *  @since 3.15.0
+    */
+   Index NumStorageReuses() const
+   {
+      return num_storage_reuses_;
+   }
    ///@}
 
    /**@name Methods for dealing with meta data on the vector
@@ -442,6 +465,15 @@ private:
    StringMetaDataMapType string_meta_data_;
    IntegerMetaDataMapType integer_meta_data_;
    NumericMetaDataMapType numeric_meta_data_;
+
+   /** Arrays of freed vectors that are reused by AllocateInternalStorage */
+   mutable std::vector<Number*> free_storage_;
+
+   /** Counter for the arrays that have been allocated */
+   mutable Index num_storage_allocations_;
+
+   /** Counter for the allocations that have been served from free_storage_ */
+   mutable Index num_storage_reuses_;
 };
 
 // inline functions
@@ -480,26 +512,6 @@ inline Number* DenseVector::values_allocated()
    return values_;
 }
 
-inline Number* DenseVectorSpace::AllocateInternalStorage() const
-{
-   if( Dim() > 0 )
-   {
-      return new Number[Dim()];
-   }
-   else
-   {
-      return NULL;
-   }
-}
-
-inline
-void DenseVectorSpace::FreeInternalStorage(
-   Number* values
-) const
-{
-   delete[] values;
-}
-
 inline SmartPtr<DenseVector> DenseVector::MakeNewDenseVector() const
 {
    return owner_space_->MakeNewDenseVector();
@@ -24,6 +24,211 @@ ExpansionMatrix::ExpansionMatrix(
 ExpansionMatrix::~ExpansionMatrix()
 { }
 
+// local to this file, so that the names cannot collide with classes of other translation units
+namespace
+{
+
+/** Positions of the entries of the small vector in the large vector, given by an index array */
+class IndexedPositions
+{
+public:
+   explicit IndexedPositions(
+      const Index* pos
+   )
+      : pos_(pos)
+   { }
+
+   Index operator[](
+      Index i
+   ) const
+   {
+      return pos_[i];
+   }
+
+private:
+   const Index* pos_;
+};
+
+/** Positions of the entries of the small vector in the large vector, given by a contiguous range */
+class RangePositions
+{
+public:
+   explicit RangePositions(
+      Index start
+   )
+      : start_(start)
+   { }
+
+   Index operator[](
+      Index i
+   ) const
+   {
+      return start_ + i;
+   }
+
+private:
+   Index start_;
+};
+
+} // namespace
+
+/* The following kernels are instantiated for both kinds of positions,
+ * so that no indirect addressing is done if the positions form a range.
+ */
+
+/** y[pos[i]] += alpha*x[i] */
+template<class Positions>
+static void ExpandAxpy(
+   Index            n,
+   Number           alpha,
+   const Number*    x,
+   Number*          y,
+   const Positions& pos
+)
+{
+   for( Index i = 0; i < n; i++ )
+   {
+      y[pos[i]] += alpha * x[i];
+   }
+}
+
+/** y[pos[i]] += val */
+template<class Positions>
+static void ExpandAddScalar(
+   Index            n,
+   Number           val,
+   Number*          y,
+   const Positions& pos
+)
+{
+   for( Index i = 0; i < n; i++ )
+   {
+      y[pos[i]] += val;
+   }
+}
+
+/** y[i] = alpha*x[pos[i]] + (add ? y[i] : 0) */
+template<class Positions>
+static void CompressAxpy(
+   Index            n,
+   Number           alpha,
+   const Number*    x,
+   bool             add,
+   Number*          y,
+   const Positions& pos
+)
+{
+   if( add )
+   {
+      for( Index i = 0; i < n; i++ )
+      {
+         y[i] += alpha * x[pos[i]];
+      }
+   }
+   else
+   {
+      for( Index i = 0; i < n; i++ )
+      {
+         y[i] = alpha * x[pos[i]];
+      }
+   }
+}
+
+/** X[pos[i]] += alpha*Z[i]/S[i], where Z is given by its scalar if homogeneous */
+template<class Positions>
+static void ExpandAddQuotient(
+   Index            n,
+   Number           alpha,
+   const Number*    vals_Z,
+   Number           scalar_Z,
+   const Number*    vals_S,
+   Number*          vals_X,
+   const Positions& pos
+)
+{
+   if( vals_Z == NULL )
+   {
+      Number val = alpha * scalar_Z;
+      if( val != 0. )
+      {
+         for( Index i = 0; i < n; i++ )
+         {
+            vals_X[pos[i]] += val / vals_S[i];
+         }
+      }
+   }
+   else
+   {
+      for( Index i = 0; i < n; i++ )
+      {
+         vals_X[pos[i]] += alpha * vals_Z[i] / vals_S[i];
+      }
+   }
+}
+
+/** X[i] = (R[i] + alpha*Z[i]*D[pos[i]])/S[i], where R and Z are given by their scalars if homogeneous */
+template<class Positions>
+static void SinvBlrmZPTdBr(
+   Index            n,
+   Number           alpha,
+   const Number*    vals_S,
+   const Number*    vals_R,
+   Number           scalar_R,
+   const Number*    vals_Z,
+   Number           scalar_Z,
+   const Number*    vals_D,
+   Number*          vals_X,
+   const Positions& pos
+)
+{
+   if( vals_R == NULL )
+   {
+      if( vals_Z == NULL )
+      {
+         Number val = alpha * scalar_Z;
+         if( val == 0. )
+         {
+            for( Index i = 0; i < n; i++ )
+            {
+               vals_X[i] = scalar_R / vals_S[i];
+            }
+         }
+         else
+         {
+            for( Index i = 0; i < n; i++ )
+            {
+               vals_X[i] = (scalar_R + val * vals_D[pos[i]]) / vals_S[i];
+            }
+         }
+      }
+      else
+      {
+         for( Index i = 0; i < n; i++ )
+         {
+            vals_X[i] = (scalar_R + alpha * vals_Z[i] * vals_D[pos[i]]) / vals_S[i];
+         }
+      }
+   }
+   else
+   {
+      if( vals_Z == NULL )
+      {
+         Number val = alpha * scalar_Z;
+         for( Index i = 0; i < n; i++ )
+         {
+            vals_X[i] = (vals_R[i] + val * vals_D[pos[i]]) / vals_S[i];
+         }
+      }
+      else
+      {
+         for( Index i = 0; i < n; i++ )
+         {
+            vals_X[i] = (vals_R[i] + alpha * vals_Z[i] * vals_D[pos[i]]) / vals_S[i];
+         }
+      }
+   }
+}
+
 void ExpansionMatrix::MultVectorImpl(
    Number        alpha,
    const Vector& x,
@@ -35,6 +240,12 @@ void ExpansionMatrix::MultVectorImpl(
    DBG_ASSERT(NCols() == x.Dim());
    DBG_ASSERT(NRows() == y.Dim());
 
+   if( IsIdentity() )
+   {
+      y.AddOneVector(alpha, x, beta);
+      return;
+   }
+
    // Take care of the y part of the addition
    if( beta != 0.0 )
    {
@@ -51,45 +262,35 @@ void ExpansionMatrix::MultVectorImpl(
    DenseVector* dense_y = static_cast<DenseVector*>(&y);
    DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
-   const Index* exp_pos = ExpandedPosIndices();
-
    if( dense_x && dense_y )
    {
-      Number* yvals = dense_y->Values();
       if( dense_x->IsHomogeneous() )
       {
          Number val = alpha * dense_x->Scalar();
          if( val != 0. )
          {
-            for( Index i = 0; i < NCols(); i++ )
+            Number* yvals = dense_y->Values();
+            if( IsContiguous() )
             {
-               yvals[exp_pos[i]] += val;
+               ExpandAddScalar(NCols(), val, yvals, RangePositions(owner_space_->RangeStart()));
+            }
+            else
+            {
+               ExpandAddScalar(NCols(), val, yvals, IndexedPositions(ExpandedPosIndices()));
             }
          }
       }
       else
       {
          const Number* xvals = dense_x->Values();
-         if( alpha == 1. )
+         Number* yvals = dense_y->Values();
+         if( IsContiguous() )
          {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[exp_pos[i]] += xvals[i];
-            }
-         }
-         else if( alpha == -1. )
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[exp_pos[i]] -= xvals[i];
-            }
+            ExpandAxpy(NCols(), alpha, xvals, yvals, RangePositions(owner_space_->RangeStart()));
          }
          else
          {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[exp_pos[i]] += alpha * xvals[i];
-            }
+            ExpandAxpy(NCols(), alpha, xvals, yvals, IndexedPositions(ExpandedPosIndices()));
          }
       }
    }
@@ -106,14 +307,10 @@ void ExpansionMatrix::TransMultVectorImpl(
    DBG_ASSERT(NCols() == y.Dim());
    DBG_ASSERT(NRows() == x.Dim());
 
-   // Take care of the y part of the addition
-   if( beta != 0.0 )
+   if( IsIdentity() )
    {
-      y.Scal(beta);
-   }
-   else
-   {
-      y.Set(0.0);  // In case y hasn't been initialized yet
+      y.AddOneVector(alpha, x, beta);
+      return;
    }
 
    // See if we can understand the data
@@ -122,45 +319,39 @@ void ExpansionMatrix::TransMultVectorImpl(
    DenseVector* dense_y = static_cast<DenseVector*>(&y);
    DBG_ASSERT(dynamic_cast<DenseVector*>(&y));
 
-   const Index* exp_pos = ExpandedPosIndices();
-
    if( dense_x && dense_y )
    {
-      Number* yvals = dense_y->Values();
       if( dense_x->IsHomogeneous() )
       {
+         // the result is homogeneous if y is
          Number val = alpha * dense_x->Scalar();
-         if( val != 0. )
+         if( beta != 0.0 )
          {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[i] += val;
-            }
+            y.Scal(beta);
+            y.AddScalar(val);
+         }
+         else
+         {
+            y.Set(val);
          }
       }
       else
       {
-         const Number* xvals = dense_x->Values();
-         if( alpha == 1. )
+         // for beta = 0, y is overwritten without setting it to zero first
+         const bool add = (beta != 0.0);
+         if( add )
          {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[i] += xvals[exp_pos[i]];
-            }
+            y.Scal(beta);
          }
-         else if( alpha == -1. )
+         const Number* xvals = dense_x->Values();
+         Number* yvals = dense_y->Values();
+         if( IsContiguous() )
          {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[i] -= xvals[exp_pos[i]];
-            }
+            CompressAxpy(NCols(), alpha, xvals, add, yvals, RangePositions(owner_space_->RangeStart()));
          }
          else
          {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               yvals[i] += alpha * xvals[exp_pos[i]];
-            }
+            CompressAxpy(NCols(), alpha, xvals, add, yvals, IndexedPositions(ExpandedPosIndices()));
          }
       }
    }
@@ -178,6 +369,12 @@ void ExpansionMatrix::AddMSinvZImpl(
    DBG_ASSERT(NCols() == Z.Dim());
    DBG_ASSERT(NRows() == X.Dim());
 
+   if( IsIdentity() )
+   {
+      X.AddVectorQuotient(alpha, Z, S, 1.);
+      return;
+   }
+
    const DenseVector* dense_S = static_cast<const DenseVector*>(&S);
    DBG_ASSERT(dynamic_cast<const DenseVector*>(&S));
    const DenseVector* dense_Z = static_cast<const DenseVector*>(&Z);
@@ -196,45 +393,23 @@ void ExpansionMatrix::AddMSinvZImpl(
       return;
    }
 
-   const Index* exp_pos = ExpandedPosIndices();
+   if( dense_Z->IsHomogeneous() && alpha * dense_Z->Scalar() == 0. )
+   {
+      return;
+   }
+
    const Number* vals_S = dense_S->Values();
+   const Number* vals_Z = dense_Z->IsHomogeneous() ? NULL : dense_Z->Values();
+   const Number scalar_Z = dense_Z->IsHomogeneous() ? dense_Z->Scalar() : 0.;
    Number* vals_X = dense_X->Values();
 
-   if( dense_Z->IsHomogeneous() )
+   if( IsContiguous() )
    {
-      Number val = alpha * dense_Z->Scalar();
-      if( val != 0. )
-      {
-         for( Index i = 0; i < NCols(); i++ )
-         {
-            vals_X[exp_pos[i]] += val / vals_S[i];
-         }
-      }
+      ExpandAddQuotient(NCols(), alpha, vals_Z, scalar_Z, vals_S, vals_X, RangePositions(owner_space_->RangeStart()));
    }
    else
    {
-      const Number* vals_Z = dense_Z->Values();
-      if( alpha == 1. )
-      {
-         for( Index i = 0; i < NCols(); i++ )
-         {
-            vals_X[exp_pos[i]] += vals_Z[i] / vals_S[i];
-         }
-      }
-      else if( alpha == -1. )
-      {
-         for( Index i = 0; i < NCols(); i++ )
-         {
-            vals_X[exp_pos[i]] -= vals_Z[i] / vals_S[i];
-         }
-      }
-      else
-      {
-         for( Index i = 0; i < NCols(); i++ )
-         {
-            vals_X[exp_pos[i]] += alpha * vals_Z[i] / vals_S[i];
-         }
-      }
+      ExpandAddQuotient(NCols(), alpha, vals_Z, scalar_Z, vals_S, vals_X, IndexedPositions(ExpandedPosIndices()));
    }
 }
 
@@ -280,94 +455,23 @@ void ExpansionMatrix::SinvBlrmZMTdBrImpl(
       return;
    }
 
-   const Index* exp_pos = ExpandedPosIndices();
    const Number* vals_S = dense_S->Values();
+   const Number* vals_R = dense_R->IsHomogeneous() ? NULL : dense_R->Values();
+   const Number scalar_R = dense_R->IsHomogeneous() ? dense_R->Scalar() : 0.;
+   const Number* vals_Z = dense_Z->IsHomogeneous() ? NULL : dense_Z->Values();
+   const Number scalar_Z = dense_Z->IsHomogeneous() ? dense_Z->Scalar() : 0.;
    const Number* vals_D = dense_D->Values();
    Number* vals_X = dense_X->Values();
 
-   if( dense_R->IsHomogeneous() )
+   if( IsContiguous() )
    {
-      Number scalar_R = dense_R->Scalar();
-      if( dense_Z->IsHomogeneous() )
-      {
-         Number val = alpha * dense_Z->Scalar();
-         if( val == 0. )
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = scalar_R / vals_S[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (scalar_R + val * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-      }
-      else
-      {
-         const Number* vals_Z = dense_Z->Values();
-         if( alpha == 1. )
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (scalar_R + vals_Z[i] * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-         else if( alpha == -1. )
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (scalar_R - vals_Z[i] * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (scalar_R + alpha * vals_Z[i] * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-      }
+      SinvBlrmZPTdBr(NCols(), alpha, vals_S, vals_R, scalar_R, vals_Z, scalar_Z, vals_D, vals_X,
+                     RangePositions(owner_space_->RangeStart()));
    }
    else
    {
-      const Number* vals_R = dense_R->Values();
-      if( dense_Z->IsHomogeneous() )
-      {
-         Number val = alpha * dense_Z->Scalar();
-         for( Index i = 0; i < NCols(); i++ )
-         {
-            vals_X[i] = (vals_R[i] + val * vals_D[exp_pos[i]]) / vals_S[i];
-         }
-      }
-      else
-      {
-         const Number* vals_Z = dense_Z->Values();
-         if( alpha == 1. )
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (vals_R[i] + vals_Z[i] * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-         else if( alpha == -1. )
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (vals_R[i] - vals_Z[i] * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-         else
-         {
-            for( Index i = 0; i < NCols(); i++ )
-            {
-               vals_X[i] = (vals_R[i] + alpha * vals_Z[i] * vals_D[exp_pos[i]]) / vals_S[i];
-            }
-         }
-      }
+      SinvBlrmZPTdBr(NCols(), alpha, vals_S, vals_R, scalar_R, vals_Z, scalar_Z, vals_D, vals_X,
+                     IndexedPositions(ExpandedPosIndices()));
    }
 }
 
@@ -438,7 +542,8 @@ ExpansionMatrixSpace::ExpansionMatrixSpace(
 )
    : MatrixSpace(NLargeVec, NSmallVec),
      expanded_pos_(NULL),
-     compressed_pos_(NULL)
+     compressed_pos_(NULL),
+     range_start_(-1)
 {
    if( NCols() > 0 )
    {
@@ -462,6 +567,18 @@ ExpansionMatrixSpace::ExpansionMatrixSpace(
          compressed_pos_[ExpPos[i] - offset] = i;
       }
    }
+
+   // check whether the expanded positions form a contiguous range,
+   // in which case no indirect addressing is required
+   range_start_ = NCols() > 0 ? expanded_pos_[0] : 0;
+   for( Index i = 1; i < NCols(); i++ )
+   {
+      if( expanded_pos_[i] != range_start_ + i )
+      {
+         range_start_ = -1;
+         break;
+      }
+   }
 }
 
 } // namespace Ipopt
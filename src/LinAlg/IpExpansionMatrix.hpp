@@ -60,6 +60,18 @@ public:
     */
    const Index* CompressedPosIndices() const;
 
+   /** Whether the expanded positions form a contiguous range of the large vector.
+    *
+    *  @since 3.15.0
+    */
+   bool IsContiguous() const;
+
+   /** Whether the matrix is the identity, i.e., the large and small vectors coincide.
+    *
+    *  @since 3.15.0
+    */
+   bool IsIdentity() const;
+
 protected:
    /**@name Overloaded methods from Matrix base class*/
    ///@{
@@ -225,9 +237,22 @@ public:
       return compressed_pos_;
    }
 
+   /** Index of the large vector of the first element of the small
+    *  vector if the expanded positions form a contiguous range, and
+    *  -1 otherwise.
+    *
+    *  @since 3.15.0
+    */
+   Index RangeStart() const
+   {
+      return range_start_;
+   }
+
 private:
    Index* expanded_pos_;
    Index* compressed_pos_;
+   /** Start of the contiguous range of expanded positions, -1 if not contiguous */
+   Index range_start_;
 };
 
 /* inline methods */
@@ -241,5 +266,15 @@ inline const Index* ExpansionMatrix::CompressedPosIndices() const
    return owner_space_->CompressedPosIndices();
 }
 
+inline bool ExpansionMatrix::IsContiguous() const
+{
+   return owner_space_->RangeStart() >= 0;
+}
+
+inline bool ExpansionMatrix::IsIdentity() const
+{
+   return owner_space_->RangeStart() == 0 && NRows() == NCols();
+}
+
 } // namespace Ipopt
 #endif
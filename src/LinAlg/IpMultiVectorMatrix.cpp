@@ -7,6 +7,7 @@
 #include "IpMultiVectorMatrix.hpp"
 #include "IpDenseVector.hpp"
 #include "IpDenseGenMatrix.hpp"
+#include "IpBlas.hpp"
 
 #include <cstdio>
 
@@ -17,6 +18,9 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** number of rows that are copied into contiguous memory at once for Level 3 BLAS operations */
+static const Index row_block_size = 1024;
+
 MultiVectorMatrix::MultiVectorMatrix(
    const MultiVectorMatrixSpace* owner_space
 )
@@ -252,14 +256,52 @@ void MultiVectorMatrix::AddRightMultMatrix(
       FillWithNewVectors();
    }
 
-   // ToDo: For now, we simply use MatrixVector multiplications, but
-   // we might be more efficient (at least in the non-parallel case)
-   // if we used Level 3 Blas
+   const DenseGenMatrix* dgm_C = static_cast<const DenseGenMatrix*>(&C);
+   DBG_ASSERT(dynamic_cast<const DenseGenMatrix*>(&C));
+
+   if( NRows() > 0 && NCols() > 0 && U.NCols() > 0 && U.HasDenseColumns() && HasDenseColumns() )
+   {
+      // Level 3 Blas on blocks of rows that are copied into contiguous memory
+      const Index nrows = NRows();
+      const Index ncols = NCols();
+      const Index nUcols = U.NCols();
+      const Index blocksize = Min(nrows, row_block_size);
+      Number* Ublock = new Number[blocksize * nUcols];
+      Number* Vblock = new Number[blocksize * ncols];
+      Number** Vvalues = new Number*[ncols];
+      for( Index i = 0; i < ncols; i++ )
+      {
+         Vvalues[i] = static_cast<DenseVector*>(Vec(i))->Values();
+      }
+      for( Index first_row = 0; first_row < nrows; first_row += blocksize )
+      {
+         const Index nblock = Min(blocksize, nrows - first_row);
+         U.GetRowBlock(first_row, nblock, Ublock);
+         if( b != 0. )
+         {
+            for( Index i = 0; i < ncols; i++ )
+            {
+               IpBlasCopy(nblock, Vvalues[i] + first_row, 1, Vblock + i * nblock, 1);
+            }
+         }
+         IpBlasGemm(false, false, nblock, ncols, nUcols, a, Ublock, nblock, dgm_C->Values(), C.NRows(), b, Vblock,
+                    nblock);
+         for( Index i = 0; i < ncols; i++ )
+         {
+            IpBlasCopy(nblock, Vblock + i * nblock, 1, Vvalues[i] + first_row, 1);
+         }
+      }
+      delete[] Vvalues;
+      delete[] Vblock;
+      delete[] Ublock;
+      ObjectChanged();
+      return;
+   }
+
+   // Otherwise, we simply use MatrixVector multiplications
    SmartPtr<const DenseVectorSpace> mydspace = new DenseVectorSpace(C.NRows());
    SmartPtr<DenseVector> mydvec = mydspace->MakeNewDenseVector();
 
-   const DenseGenMatrix* dgm_C = static_cast<const DenseGenMatrix*>(&C);
-   DBG_ASSERT(dynamic_cast<const DenseGenMatrix*>(&C));
    for( Index i = 0; i < NCols(); i++ )
    {
       const Number* CValues = dgm_C->Values();
@@ -273,6 +315,102 @@ void MultiVectorMatrix::AddRightMultMatrix(
    ObjectChanged();
 }
 
+bool MultiVectorMatrix::TransMultMultiVector(
+   Number                   alpha,
+   const MultiVectorMatrix& V2,
+   Number                   beta,
+   Number*                  M,
+   Index                    ldM
+) const
+{
+   DBG_ASSERT(NRows() == V2.NRows());
+   DBG_ASSERT(ldM >= NCols());
+
+   if( NRows() == 0 || NCols() == 0 || V2.NCols() == 0 || !HasDenseColumns() || !V2.HasDenseColumns() )
+   {
+      return false;
+   }
+
+   const Index nrows = NRows();
+   const Index ncols = NCols();
+   const Index blocksize = Min(nrows, row_block_size);
+   Number* V1block = new Number[blocksize * ncols];
+   if( &V2 == this )
+   {
+      // the product is symmetric, so compute only the lower triangle and copy it
+      for( Index first_row = 0; first_row < nrows; first_row += blocksize )
+      {
+         const Index nblock = Min(blocksize, nrows - first_row);
+         GetRowBlock(first_row, nblock, V1block);
+         // the contributions of all but the first block are added to M
+         IpBlasSyrk(true, ncols, nblock, alpha, V1block, nblock, first_row == 0 ? beta : 1., M, ldM);
+      }
+      for( Index j = 1; j < ncols; j++ )
+      {
+         for( Index i = 0; i < j; i++ )
+         {
+            M[i + j * ldM] = M[j + i * ldM];
+         }
+      }
+   }
+   else
+   {
+      Number* V2block = new Number[blocksize * V2.NCols()];
+      for( Index first_row = 0; first_row < nrows; first_row += blocksize )
+      {
+         const Index nblock = Min(blocksize, nrows - first_row);
+         GetRowBlock(first_row, nblock, V1block);
+         V2.GetRowBlock(first_row, nblock, V2block);
+         // the contributions of all but the first block are added to M
+         IpBlasGemm(true, false, ncols, V2.NCols(), nblock, alpha, V1block, nblock, V2block, nblock,
+                    first_row == 0 ? beta : 1., M, ldM);
+      }
+      delete[] V2block;
+   }
+   delete[] V1block;
+
+   return true;
+}
+
+bool MultiVectorMatrix::HasDenseColumns() const
+{
+   for( Index i = 0; i < NCols(); i++ )
+   {
+      if( IsNull(const_vecs_[i]) && IsNull(non_const_vecs_[i]) )
+      {
+         return false;
+      }
+      if( dynamic_cast<const DenseVector*>(ConstVec(i)) == NULL )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+void MultiVectorMatrix::GetRowBlock(
+   Index   first_row,
+   Index   nrows,
+   Number* values
+) const
+{
+   DBG_ASSERT(first_row >= 0 && first_row + nrows <= NRows());
+   for( Index i = 0; i < NCols(); i++ )
+   {
+      const DenseVector* vec = static_cast<const DenseVector*>(ConstVec(i));
+      DBG_ASSERT(dynamic_cast<const DenseVector*>(ConstVec(i)));
+      if( vec->IsHomogeneous() )
+      {
+         Number scalar = vec->Scalar();
+         IpBlasCopy(nrows, &scalar, 0, values + i * nrows, 1);
+      }
+      else
+      {
+         IpBlasCopy(nrows, vec->Values() + first_row, 1, values + i * nrows, 1);
+      }
+   }
+}
+
 bool MultiVectorMatrix::HasValidNumbersImpl() const
 {
    for( Index i = 0; i < NCols(); i++ )
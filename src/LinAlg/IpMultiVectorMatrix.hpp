@@ -130,6 +130,25 @@ public:
       Vector&       y
    ) const;
 
+   /** Computing a matrix product with the transpose of this matrix.
+    *
+    *  If V1 is this MultiVectorMatrix, the operation is
+    *  M = alpha*V1^T*V2 + beta*M, where M is given as column-major array
+    *  with leading dimension ldM.  This is done by Level 3 BLAS on blocks
+    *  of rows, which requires that all columns of V1 and V2 are
+    *  DenseVectors.  If this is not the case, false is returned and M is
+    *  not changed.
+    *
+    *  @since 3.15.0
+    */
+   bool TransMultMultiVector(
+      Number                   alpha,
+      const MultiVectorMatrix& V2,
+      Number                   beta,
+      Number*                  M,
+      Index                    ldM
+   ) const;
+
    /** Vector space for the columns */
    SmartPtr<const VectorSpace> ColVectorSpace() const;
 
@@ -207,6 +226,20 @@ private:
    /** space for storing the non-const Vector's */
    std::vector<SmartPtr<Vector> > non_const_vecs_;
 
+   /** Whether all columns are set and are DenseVectors */
+   bool HasDenseColumns() const;
+
+   /** Copies a block of consecutive rows of all columns into a
+    *  column-major array with leading dimension nrows.
+    *
+    *  Requires that HasDenseColumns() is true.
+    */
+   void GetRowBlock(
+      Index   first_row,
+      Index   nrows,
+      Number* values
+   ) const;
+
    /** Method for accessing the internal Vectors internally */
    ///@{
    inline const Vector* ConstVec(
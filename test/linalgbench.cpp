@@ -0,0 +1,486 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+/* Micro-benchmark for the vector and matrix kernels in src/LinAlg.
+ *
+ * Usage: linalgbench [FILTER [N1,N2,...]]
+ *
+ * Runs every kernel whose name contains FILTER (all if FILTER is omitted or "all")
+ * for the given vector lengths (default 1000,10000,100000,1000000) and prints
+ * the time per call, the memory bandwidth, and the floating-point rate.
+ * Bandwidth and flops are computed from the minimal number of bytes that need
+ * to be read and written and the number of floating-point operations of the
+ * kernel, respectively.
+ */
+
+#include "IpDenseVector.hpp"
+#include "IpCompoundVector.hpp"
+#include "IpGenTMatrix.hpp"
+#include "IpSymTMatrix.hpp"
+#include "IpExpansionMatrix.hpp"
+#include "IpMultiVectorMatrix.hpp"
+#include "IpDenseGenMatrix.hpp"
+#include "IpDenseSymMatrix.hpp"
+#include "IpLowRankUpdateSymMatrix.hpp"
+#include "IpTripletToCSRConverter.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace Ipopt;
+
+/** minimal wallclock time in seconds over which a kernel is repeated */
+static const Number min_time = 0.2;
+
+/** kernel name filter from the command line, NULL for all */
+static const char* filter = NULL;
+
+/** state of the pseudo-random number generator, fixed for reproducible patterns */
+static unsigned long rand_state = 12345;
+
+/** returns a pseudo-random number in [0,1) */
+static Number Rand()
+{
+   rand_state = (1103515245UL * rand_state + 12345UL) % 2147483648UL;
+   return (Number) rand_state / 2147483648.;
+}
+
+/** returns a pseudo-random index in [0,n) */
+static Index RandIndex(
+   Index n
+)
+{
+   Index i = (Index) (Rand() * n);
+   return i < n ? i : n - 1;
+}
+
+static bool Selected(
+   const char* kernel
+)
+{
+   return filter == NULL || strstr(kernel, filter) != NULL;
+}
+
+static void Report(
+   const char* kernel,
+   const char* pattern,
+   Index       n,
+   Index       nnz,
+   Number      time,
+   Number      bytes,
+   Number      flops
+)
+{
+   printf("%-40s %-8s %10d %10d %12.3f %9.2f %9.3f\n", kernel, pattern, (int) n, (int) nnz, 1e6 * time,
+          bytes / time * 1e-9, flops / time * 1e-9);
+}
+
+/** times a statement by repeating it for at least min_time seconds and prints the result
+ *
+ *  bytes and flops are per execution of the statement.
+ */
+#define BENCH(kernel, pattern, n, nnz, bytes, flops, stmt) \
+   do \
+   { \
+      if( Selected(kernel) ) \
+      { \
+         stmt; /* warm-up */ \
+         Index reps_ = 0; \
+         Number start_ = WallclockTime(); \
+         Number elapsed_; \
+         do \
+         { \
+            stmt; \
+            ++reps_; \
+            elapsed_ = WallclockTime() - start_; \
+         } while( elapsed_ < min_time || reps_ < 3 ); \
+         Report(kernel, pattern, n, nnz, elapsed_ / reps_, (Number) (bytes), (Number) (flops)); \
+      } \
+   } while( false )
+
+/** fills a dense vector with pseudo-random values in [lo,hi) */
+static void FillRandom(
+   DenseVector& v,
+   Number       lo,
+   Number       hi
+)
+{
+   Number* vals = v.Values();
+   for( Index i = 0; i < v.Dim(); ++i )
+   {
+      vals[i] = lo + (hi - lo) * Rand();
+   }
+}
+
+static void BenchDenseVector(
+   Index n
+)
+{
+   SmartPtr<DenseVectorSpace> space = new DenseVectorSpace(n);
+   SmartPtr<DenseVector> x = space->MakeNewDenseVector();
+   SmartPtr<DenseVector> y = space->MakeNewDenseVector();
+   SmartPtr<DenseVector> z = space->MakeNewDenseVector();
+   FillRandom(*x, 1., 2.);
+   FillRandom(*y, 1., 2.);
+   FillRandom(*z, 1., 2.);
+   Number result = 0.;
+
+   // Values() marks a vector as changed, so that norms and dot products are not taken from the cache
+   BENCH("DenseVector::Copy", "dense", n, n, 16. * n, 0., y->Copy(*x));
+   BENCH("DenseVector::Scal", "dense", n, n, 16. * n, n, y->Scal(-1.));
+   BENCH("DenseVector::Axpy", "dense", n, n, 24. * n, 2. * n, y->Axpy(1e-10, *x));
+   BENCH("DenseVector::AddTwoVectors", "dense", n, n, 32. * n, 5. * n, z->AddTwoVectors(1e-10, *x, 1e-10, *y, 1.));
+   BENCH("DenseVector::Dot", "dense", n, n, 16. * n, 2. * n, x->Values(); result += x->Dot(*y));
+   BENCH("DenseVector::Nrm2", "dense", n, n, 8. * n, 2. * n, x->Values(); result += x->Nrm2());
+   BENCH("DenseVector::Asum", "dense", n, n, 8. * n, n, x->Values(); result += x->Asum());
+   BENCH("DenseVector::Amax", "dense", n, n, 8. * n, n, x->Values(); result += x->Amax());
+   // multiply and divide alternately, so that values stay in range
+   BENCH("DenseVector::ElementWiseMultiply+Divide", "dense", n, n, 48. * n, 2. * n, y->ElementWiseMultiply(*x); y->ElementWiseDivide(*x));
+   BENCH("DenseVector::AddVectorQuotient", "dense", n, n, 32. * n, 3. * n, z->AddVectorQuotient(1e-10, *x, *y, 1.));
+   BENCH("DenseVector::FracToBound", "dense", n, n, 16. * n, 3. * n, x->Values(); result += x->FracToBound(*y, 0.99));
+
+   if( result == 42. )
+   {
+      // use result, so that the compiler cannot optimize the evaluations away
+      printf("%g\n", result);
+   }
+}
+
+/** marks all components of a compound vector of dense vectors as changed */
+static void Touch(
+   CompoundVector& v
+)
+{
+   for( Index i = 0; i < v.NComps(); ++i )
+   {
+      static_cast<DenseVector*>(GetRawPtr(v.GetCompNonConst(i)))->Values();
+   }
+}
+
+static void BenchCompoundVector(
+   Index n
+)
+{
+   const Index ncomp = 4;
+   SmartPtr<CompoundVectorSpace> space = new CompoundVectorSpace(ncomp, n);
+   std::vector<SmartPtr<DenseVectorSpace> > comp_spaces;
+   for( Index i = 0; i < ncomp; ++i )
+   {
+      Index dim = n / ncomp + (i < n % ncomp ? 1 : 0);
+      comp_spaces.push_back(new DenseVectorSpace(dim));
+      space->SetCompSpace(i, *comp_spaces[i]);
+   }
+   SmartPtr<CompoundVector> x = space->MakeNewCompoundVector();
+   SmartPtr<CompoundVector> y = space->MakeNewCompoundVector();
+   for( Index i = 0; i < ncomp; ++i )
+   {
+      FillRandom(*static_cast<DenseVector*>(GetRawPtr(x->GetCompNonConst(i))), 1., 2.);
+      FillRandom(*static_cast<DenseVector*>(GetRawPtr(y->GetCompNonConst(i))), 1., 2.);
+   }
+   Number result = 0.;
+
+   // components have to be marked as changed, so that norms and dot products are not taken from the cache
+   BENCH("CompoundVector::Axpy", "4 comps", n, n, 24. * n, 2. * n, y->Axpy(1e-10, *x));
+   BENCH("CompoundVector::Dot", "4 comps", n, n, 16. * n, 2. * n, Touch(*x); result += x->Dot(*y));
+   BENCH("CompoundVector::Amax", "4 comps", n, n, 8. * n, n, Touch(*x); result += x->Amax());
+
+   if( result == 42. )
+   {
+      printf("%g\n", result);
+   }
+}
+
+/** creates a pseudo-random square sparsity pattern with about nnz_per_row entries per row
+ *
+ *  Indices are 1-based. If lower is true, only entries in the lower triangle
+ *  (including the diagonal) are generated. If banded is true, entries are
+ *  placed within a band around the diagonal, otherwise anywhere in the row.
+ */
+static void MakePattern(
+   Index               n,
+   Index               nnz_per_row,
+   bool                lower,
+   bool                banded,
+   std::vector<Index>& irows,
+   std::vector<Index>& jcols
+)
+{
+   irows.clear();
+   jcols.clear();
+   for( Index i = 0; i < n; ++i )
+   {
+      irows.push_back(i + 1);
+      jcols.push_back(i + 1);
+      for( Index k = 1; k < nnz_per_row; ++k )
+      {
+         Index j;
+         if( banded )
+         {
+            j = i - k;
+            if( !lower && k % 2 == 0 )
+            {
+               j = i + k;
+            }
+         }
+         else
+         {
+            j = lower ? RandIndex(i + 1) : RandIndex(n);
+         }
+         if( j < 0 || j >= n )
+         {
+            continue;
+         }
+         irows.push_back(i + 1);
+         jcols.push_back(j + 1);
+      }
+   }
+}
+
+static void BenchTMatrices(
+   Index n
+)
+{
+   const Index nnz_per_row = 5;
+   SmartPtr<DenseVectorSpace> space = new DenseVectorSpace(n);
+   SmartPtr<DenseVector> x = space->MakeNewDenseVector();
+   SmartPtr<DenseVector> y = space->MakeNewDenseVector();
+   FillRandom(*x, 1., 2.);
+   FillRandom(*y, 1., 2.);
+
+   std::vector<Index> irows;
+   std::vector<Index> jcols;
+   std::vector<Number> vals;
+   for( int banded = 0; banded <= 1; ++banded )
+   {
+      const char* pattern = banded ? "banded" : "random";
+
+      MakePattern(n, nnz_per_row, false, banded != 0, irows, jcols);
+      Index nnz = (Index) irows.size();
+      vals.resize(nnz);
+      for( Index k = 0; k < nnz; ++k )
+      {
+         vals[k] = Rand();
+      }
+      SmartPtr<GenTMatrixSpace> gen_space = new GenTMatrixSpace(n, n, nnz, &irows[0], &jcols[0]);
+      SmartPtr<GenTMatrix> A = gen_space->MakeNewGenTMatrix();
+      A->SetValues(&vals[0]);
+
+      // per nonzero: value, row and column index, gathered x and updated y
+      BENCH("GenTMatrix::MultVector", pattern, n, nnz, (16. + 2. * sizeof(Index)) * nnz + 16. * n, 2. * nnz,
+            A->MultVector(1., *x, 1e-10, *y));
+      BENCH("GenTMatrix::TransMultVector", pattern, n, nnz, (16. + 2. * sizeof(Index)) * nnz + 16. * n, 2. * nnz,
+            A->TransMultVector(1., *x, 1e-10, *y));
+
+      MakePattern(n, nnz_per_row, true, banded != 0, irows, jcols);
+      nnz = (Index) irows.size();
+      vals.resize(nnz);
+      for( Index k = 0; k < nnz; ++k )
+      {
+         vals[k] = Rand();
+      }
+      SmartPtr<SymTMatrixSpace> sym_space = new SymTMatrixSpace(n, nnz, &irows[0], &jcols[0]);
+      SmartPtr<SymTMatrix> S = sym_space->MakeNewSymTMatrix();
+      S->SetValues(&vals[0]);
+
+      // each off-diagonal nonzero contributes to two entries of y
+      BENCH("SymTMatrix::MultVector", pattern, n, nnz, (32. + 2. * sizeof(Index)) * nnz + 16. * n, 4. * nnz,
+            S->MultVector(1., *x, 1e-10, *y));
+
+      std::vector<Number> csr_vals;
+      BENCH("TripletToCSRConverter::Init", pattern, n, nnz, 2. * sizeof(Index) * nnz, 0.,
+            TripletToCSRConverter conv(0); conv.InitializeConverter(n, nnz, &irows[0], &jcols[0]));
+      TripletToCSRConverter converter(0);
+      Index nnz_csr = converter.InitializeConverter(n, nnz, &irows[0], &jcols[0]);
+      csr_vals.resize(nnz_csr);
+      BENCH("TripletToCSRConverter::Convert", pattern, n, nnz, 8. * nnz + (8. + sizeof(Index)) * nnz_csr, nnz - nnz_csr,
+            converter.ConvertValues(nnz, &vals[0], nnz_csr, &csr_vals[0]));
+   }
+}
+
+static void BenchExpansionMatrix(
+   Index n
+)
+{
+   // every second element of the large vector is in the small vector
+   Index nsmall = n / 2;
+   std::vector<Index> exppos(nsmall);
+   for( Index i = 0; i < nsmall; ++i )
+   {
+      exppos[i] = 2 * i;
+   }
+   SmartPtr<ExpansionMatrixSpace> P_space = new ExpansionMatrixSpace(n, nsmall, &exppos[0]);
+   SmartPtr<ExpansionMatrix> P = P_space->MakeNewExpansionMatrix();
+
+   SmartPtr<DenseVectorSpace> large_space = new DenseVectorSpace(n);
+   SmartPtr<DenseVectorSpace> small_space = new DenseVectorSpace(nsmall);
+   SmartPtr<DenseVector> x_large = large_space->MakeNewDenseVector();
+   SmartPtr<DenseVector> y_large = large_space->MakeNewDenseVector();
+   SmartPtr<DenseVector> x_small = small_space->MakeNewDenseVector();
+   SmartPtr<DenseVector> y_small = small_space->MakeNewDenseVector();
+   FillRandom(*x_large, 1., 2.);
+   FillRandom(*y_large, 1., 2.);
+   FillRandom(*x_small, 1., 2.);
+   FillRandom(*y_small, 1., 2.);
+
+   BENCH("ExpansionMatrix::MultVector", "stride 2", n, nsmall, (16. + sizeof(Index)) * nsmall + 16. * n, 2. * nsmall + n,
+         P->MultVector(1., *x_small, 1e-10, *y_large));
+   BENCH("ExpansionMatrix::TransMultVector", "stride 2", n, nsmall, (24. + sizeof(Index)) * nsmall, 3. * nsmall,
+         P->TransMultVector(1., *x_large, 1e-10, *y_small));
+   BENCH("ExpansionMatrix::AddMSinvZ", "stride 2", n, nsmall, (32. + sizeof(Index)) * nsmall, 3. * nsmall,
+         P->AddMSinvZ(1e-10, *x_small, *x_small, *y_large));
+}
+
+static void BenchLowRankUpdate(
+   Index n
+)
+{
+   // dimensions as in a limited-memory quasi-Newton approximation
+   const Index k = 6;
+   SmartPtr<DenseVectorSpace> space = new DenseVectorSpace(n);
+   SmartPtr<DenseVector> D = space->MakeNewDenseVector();
+   SmartPtr<DenseVector> x = space->MakeNewDenseVector();
+   SmartPtr<DenseVector> y = space->MakeNewDenseVector();
+   FillRandom(*D, 1., 2.);
+   FillRandom(*x, 1., 2.);
+   FillRandom(*y, 1., 2.);
+
+   SmartPtr<MultiVectorMatrixSpace> mv_space = new MultiVectorMatrixSpace(k, *space);
+   SmartPtr<MultiVectorMatrix> V = mv_space->MakeNewMultiVectorMatrix();
+   SmartPtr<MultiVectorMatrix> U = mv_space->MakeNewMultiVectorMatrix();
+   for( Index i = 0; i < k; ++i )
+   {
+      SmartPtr<DenseVector> v = space->MakeNewDenseVector();
+      FillRandom(*v, 0., 1e-3);
+      V->SetVector(i, *v);
+      SmartPtr<DenseVector> u = space->MakeNewDenseVector();
+      FillRandom(*u, 0., 1e-3);
+      U->SetVector(i, *u);
+   }
+
+   SmartPtr<LowRankUpdateSymMatrixSpace> lr_space = new LowRankUpdateSymMatrixSpace(n, NULL, GetRawPtr(space), false);
+   SmartPtr<LowRankUpdateSymMatrix> B = lr_space->MakeNewLowRankUpdateSymMatrix();
+   B->SetDiag(*D);
+   B->SetV(*V);
+   B->SetU(*U);
+
+   // diagonal part plus two passes (dot products and updates) over each of the 2k vectors
+   BENCH("LowRankUpdateSymMatrix::MultVector", "k=6", n, 2 * k * n, (24. + 32. * k) * n, (3. + 8. * k) * n,
+         B->MultVector(1., *x, 1e-10, *y));
+}
+
+/** marks all columns of a multi-vector matrix of dense vectors as changed, so that no cached dot products are used */
+static void Touch(
+   MultiVectorMatrix& V
+)
+{
+   for( Index i = 0; i < V.NCols(); ++i )
+   {
+      static_cast<DenseVector*>(GetRawPtr(V.GetVectorNonConst(i)))->Values();
+   }
+}
+
+static void BenchMultiVector(
+   Index n
+)
+{
+   // a limited-memory history of m pairs of vectors
+   const Index m = 20;
+   SmartPtr<DenseVectorSpace> space = new DenseVectorSpace(n);
+   SmartPtr<MultiVectorMatrixSpace> mv_space = new MultiVectorMatrixSpace(m, *space);
+   SmartPtr<MultiVectorMatrix> S = mv_space->MakeNewMultiVectorMatrix();
+   SmartPtr<MultiVectorMatrix> Y = mv_space->MakeNewMultiVectorMatrix();
+   SmartPtr<MultiVectorMatrix> V = mv_space->MakeNewMultiVectorMatrix();
+   for( Index i = 0; i < m; ++i )
+   {
+      SmartPtr<DenseVector> s = space->MakeNewDenseVector();
+      FillRandom(*s, -1., 1.);
+      S->SetVectorNonConst(i, *s);
+      SmartPtr<DenseVector> y = space->MakeNewDenseVector();
+      FillRandom(*y, -1., 1.);
+      Y->SetVector(i, *y);
+   }
+   V->FillWithNewVectors();
+   V->AddOneMultiVectorMatrix(1., *S, 0.);
+
+   SmartPtr<DenseGenMatrixSpace> C_space = new DenseGenMatrixSpace(m, m);
+   SmartPtr<DenseGenMatrix> C = C_space->MakeNewDenseGenMatrix();
+   Number* Cvalues = C->Values();
+   for( Index i = 0; i < m * m; ++i )
+   {
+      Cvalues[i] = 1e-3 * Rand();
+   }
+   SmartPtr<DenseSymMatrixSpace> M_space = new DenseSymMatrixSpace(m);
+   SmartPtr<DenseSymMatrix> M = M_space->MakeNewDenseSymMatrix();
+
+   BENCH("DenseGenMatrix::HighRankUpdateTranspose", "m=20", n, m * n, 16. * m * n, 2. * m * m * n,
+         Touch(*S); C->HighRankUpdateTranspose(1e-10, *S, *Y, 1.));
+   BENCH("DenseSymMatrix::HighRankUpdateTranspose", "m=20", n, m * n, 8. * m * n, (m + 1.) * m * n,
+         Touch(*S); M->HighRankUpdateTranspose(1., *S, *S, 0.));
+   BENCH("MultiVectorMatrix::AddRightMultMatrix", "m=20", n, m * n, 24. * m * n, 2. * m * m * n,
+         V->AddRightMultMatrix(1e-10, *S, *C, 1.));
+}
+
+static bool ParseSizes(
+   const char*         arg,
+   std::vector<Index>& sizes
+)
+{
+   sizes.clear();
+   while( *arg != '\0' )
+   {
+      char* end;
+      long n = strtol(arg, &end, 10);
+      if( end == arg || n <= 1 )
+      {
+         return false;
+      }
+      sizes.push_back((Index) n);
+      arg = (*end == ',') ? end + 1 : end;
+   }
+   return !sizes.empty();
+}
+
+int main(
+   int   argc,
+   char* argv[]
+)
+{
+   std::vector<Index> sizes;
+   sizes.push_back(1000);
+   sizes.push_back(10000);
+   sizes.push_back(100000);
+   sizes.push_back(1000000);
+
+   if( argc > 3 || (argc > 1 && (!strcmp(argv[1], "-h") || !strcmp(argv[1], "--help"))) )
+   {
+      printf("Usage: %s [FILTER [N1,N2,...]]\n", argv[0]);
+      printf("  runs all kernels whose name contains FILTER (use \"all\" for all kernels)\n");
+      printf("  for vectors of length N1, N2, ... (default 1000,10000,100000,1000000)\n");
+      return 1;
+   }
+   if( argc > 1 && strcmp(argv[1], "all") )
+   {
+      filter = argv[1];
+   }
+   if( argc > 2 && !ParseSizes(argv[2], sizes) )
+   {
+      printf("Invalid list of sizes \"%s\".\n", argv[2]);
+      return 1;
+   }
+
+   printf("%-40s %-8s %10s %10s %12s %9s %9s\n", "kernel", "pattern", "n", "nnz", "time [us]", "GB/s", "GFLOP/s");
+   for( size_t i = 0; i < sizes.size(); ++i )
+   {
+      BenchDenseVector(sizes[i]);
+      BenchCompoundVector(sizes[i]);
+      BenchTMatrices(sizes[i]);
+      BenchExpansionMatrix(sizes[i]);
+      BenchLowRankUpdate(sizes[i]);
+      BenchMultiVector(sizes[i]);
+   }
+
+   return 0;
+}
@@ -0,0 +1,218 @@
+// Copyright (C) 2026 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+// get active asserts also if NDEBUG is defined
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "IpIpoptApplication.hpp"
+#include "IpSolveStatistics.hpp"
+#include "IpSolverState.hpp"
+#include "hs071_nlp.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <cmath>
+
+using namespace Ipopt;
+
+#ifdef IPOPT_SINGLE
+#define TESTTOL 1e-4
+#else
+#define TESTTOL 1e-7
+#endif
+
+/** creates an IpoptApplication for solving HS071 quietly */
+static SmartPtr<IpoptApplication> createApp(
+   const char* hessian_approximation
+)
+{
+   SmartPtr<IpoptApplication> app = new IpoptApplication();
+   app->Options()->SetIntegerValue("print_level", 0);
+   app->Options()->SetStringValue("hessian_approximation", hessian_approximation);
+
+   ApplicationReturnStatus status = app->Initialize();
+   assert(status == Solve_Succeeded);
+
+   return app;
+}
+
+/** HS071 with the first variable fixed, so that the problem has one variable less for Ipopt */
+class HS071Fixed: public HS071_NLP
+{
+public:
+   virtual bool get_bounds_info(
+      Index   n,
+      Number* x_l,
+      Number* x_u,
+      Index   m,
+      Number* g_l,
+      Number* g_u
+   )
+   {
+      bool retval = HS071_NLP::get_bounds_info(n, x_l, x_u, m, g_l, g_u);
+      x_u[0] = x_l[0];
+      return retval;
+   }
+};
+
+/** checks that a snapshot in text format is rejected */
+static void checkInvalid(
+   const char* text
+)
+{
+   std::istringstream is(text);
+   SmartPtr<SolverState> state = new SolverState();
+   assert(!state->Read(is));
+   assert(!state->HasIterate());
+   assert(!state->HasScaling());
+   assert(state->NumQuasiNewtonPairs() == 0);
+}
+
+/** checks that a snapshot survives writing and reading */
+static SmartPtr<SolverState> roundTrip(
+   const SolverState& state
+)
+{
+   std::stringstream ss;
+   assert(state.Write(ss));
+   const std::string text = ss.str();
+
+   SmartPtr<SolverState> state2 = new SolverState();
+   assert(state2->Read(ss));
+   assert(state2->HasIterate() == state.HasIterate());
+   assert(state2->Mu() == state.Mu());
+   assert(state2->Tau() == state.Tau());
+   assert(state2->NumQuasiNewtonPairs() == state.NumQuasiNewtonPairs());
+   assert(state2->QuasiNewtonDim() == state.QuasiNewtonDim());
+
+   std::stringstream ss2;
+   assert(state2->Write(ss2));
+   assert(ss2.str() == text);
+
+   return state2;
+}
+
+/** solves HS071, then again from the snapshot of the solution (after writing and reading it)
+ *
+ *  @return the snapshot of the solution
+ */
+static SmartPtr<SolverState> run(
+   const char* hessian_approximation
+)
+{
+   SmartPtr<TNLP> nlp = new HS071_NLP();
+
+   SmartPtr<IpoptApplication> app = createApp(hessian_approximation);
+   ApplicationReturnStatus status = app->OptimizeTNLP(nlp);
+   assert(status == Solve_Succeeded);
+   Index cold_iters = app->Statistics()->IterationCount();
+   Number cold_obj = app->Statistics()->FinalObjective();
+
+   SmartPtr<SolverState> state = app->GetSolverState();
+   assert(IsValid(state));
+   assert(state->HasIterate());
+   assert(state->HasBarrierParameter());
+   if( std::string(hessian_approximation) == "limited-memory" )
+   {
+      assert(state->NumQuasiNewtonPairs() > 0);
+   }
+
+   SmartPtr<SolverState> state2 = roundTrip(*state);
+
+   SmartPtr<IpoptApplication> app2 = createApp(hessian_approximation);
+   app2->SetWarmStartState(ConstPtr(state2));
+   status = app2->OptimizeTNLP(nlp);
+   assert(status == Solve_Succeeded);
+   Index warm_iters = app2->Statistics()->IterationCount();
+   Number warm_obj = app2->Statistics()->FinalObjective();
+
+   std::cout << "hessian_approximation " << hessian_approximation << ": " << cold_iters << " iterations from the starting point, "
+             << warm_iters << " iterations from the snapshot" << std::endl;
+
+   assert(warm_iters < cold_iters);
+   assert(std::abs(warm_obj - cold_obj) <= TESTTOL * std::max(1.0, std::abs(cold_obj)));
+
+   return state2;
+}
+
+/** returns a copy of a snapshot with some text of its text format replaced */
+static SmartPtr<SolverState> modifiedCopy(
+   const SolverState& state,
+   const std::string& from,
+   const std::string& to
+)
+{
+   std::stringstream ss;
+   assert(state.Write(ss));
+   std::string text = ss.str();
+   std::string::size_type pos = text.find(from);
+   assert(pos != std::string::npos);
+   text.replace(pos, from.length(), to);
+
+   std::istringstream is(text);
+   SmartPtr<SolverState> state2 = new SolverState();
+   assert(state2->Read(is));
+   return state2;
+}
+
+/** checks that a snapshot whose iterate does not fit to the problem or its scaling is ignored completely */
+static void runMismatch(
+   const char*                        problem,
+   SmartPtr<TNLP>                     nlp,
+   const SmartPtr<const SolverState>& state
+)
+{
+   SmartPtr<IpoptApplication> app = createApp("exact");
+   ApplicationReturnStatus status = app->OptimizeTNLP(nlp);
+   assert(status == Solve_Succeeded);
+   Index cold_iters = app->Statistics()->IterationCount();
+   Number cold_obj = app->Statistics()->FinalObjective();
+
+   SmartPtr<IpoptApplication> app2 = createApp("exact");
+   app2->SetWarmStartState(state);
+   status = app2->OptimizeTNLP(nlp);
+   assert(status == Solve_Succeeded);
+   Index warm_iters = app2->Statistics()->IterationCount();
+   Number warm_obj = app2->Statistics()->FinalObjective();
+
+   std::cout << problem << ": " << cold_iters << " iterations from the starting point, "
+             << warm_iters << " iterations with a snapshot that does not fit" << std::endl;
+
+   assert(warm_iters == cold_iters);
+   assert(warm_obj == cold_obj);
+}
+
+int main(
+   int,
+   char**
+)
+{
+   // snapshots that are truncated or have sizes that do not fit
+   checkInvalid("");
+   checkInvalid("IpoptSolverState 2\n");
+   checkInvalid("IpoptSolverState 1\niterate 1\nx 3 1 2\n");
+   checkInvalid("IpoptSolverState 1\niterate 1\nx -3\n");
+   checkInvalid("IpoptSolverState 1\niterate 1\nx 2000000000 1 2 3\n");
+   checkInvalid("IpoptSolverState 1\niterate 0\nmu 0.1\ntau 0.99\nperturbations 0 0 0 0 0\n"
+                "scaling 1 1\nx_scaling 2000000000 1\n");
+   checkInvalid("IpoptSolverState 1\niterate 0\nmu 0.1\ntau 0.99\nperturbations 0 0 0 0 0\n"
+                "scaling 0 1\nquasi_newton 1 2 1\ns 1 1\ny 1 1\nend\n");
+   checkInvalid("IpoptSolverState 1\niterate 0\nmu 0.1\ntau 0.99\nperturbations 0 0 0 0 0\n"
+                "scaling 0 1\nquasi_newton 2000000000 2000000000 1\ns 0\ny 0\nend\n");
+
+   SmartPtr<SolverState> state = run("exact");
+   run("limited-memory");
+
+   // snapshots that do not fit in dimension or scaling must not change the cold start
+   runMismatch("HS071 with fixed variable", new HS071Fixed(), ConstPtr(state));
+   runMismatch("HS071 with scaling for 3 variables", new HS071_NLP(),
+               ConstPtr(modifiedCopy(*state, "x_scaling -1\n", "x_scaling 3 2 2 2\n")));
+
+   std::cout << std::endl << "*** All tests passed" << std::endl;
+
+   return EXIT_SUCCESS;
+}